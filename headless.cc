@@ -0,0 +1,170 @@
+#include "ecs/component/level_component.h"
+#include "rng.h"
+#include "simulation/input_recording.h"
+#include "simulation/input_source.h"
+#include "simulation/simulation.h"
+#include "spdlog/sinks/stdout_color_sinks.h"
+#include "spdlog/spdlog.h"
+#include <chrono>
+#include <cstdlib>
+#include <optional>
+#include <string>
+
+namespace {
+constexpr float FIXED_DT = 1.0f / 60.0f;
+constexpr unsigned long DEFAULT_TICKS = 36000;
+constexpr unsigned int DEFAULT_SEED = 1;
+constexpr int WANDER_MIN_TICKS = 30;
+constexpr int WANDER_MAX_TICKS = 180;
+
+// Walks in a random direction for a while, then picks another, tapping skills and pickup on
+// the way. Seeded, so a given seed always produces the same run.
+class WanderInputSource : public InputSource {
+public:
+  explicit WanderInputSource(unsigned int seed) : rng(seed) {}
+
+  InputFrame nextFrame() override {
+    if (this->ticksLeft <= 0) {
+      this->moveX = this->rng.range(-1, 1);
+      this->moveY = this->rng.range(-1, 1);
+      this->ticksLeft = this->rng.range(WANDER_MIN_TICKS, WANDER_MAX_TICKS);
+    }
+    --this->ticksLeft;
+
+    InputFrame frame;
+    frame.moveX = this->moveX;
+    frame.moveY = this->moveY;
+    frame.setDown(InputButton::Skill1, this->rng.index(30) == 0);
+    frame.setDown(InputButton::Skill2, this->rng.index(30) == 0);
+    frame.setDown(InputButton::Pickup, this->rng.index(30) == 0);
+    frame.setDown(InputButton::Resurrect, this->rng.index(30) == 0);
+    return frame;
+  }
+
+private:
+  Rng rng;
+  int moveX = 0;
+  int moveY = 0;
+  int ticksLeft = 0;
+};
+
+unsigned long parseNumber(const char* text, unsigned long fallback) {
+  char* end = nullptr;
+  const unsigned long parsed = std::strtoul(text, &end, 10);
+  return (end && *end == '\0' && end != text) ? parsed : fallback;
+}
+
+struct Options {
+  unsigned long ticks = DEFAULT_TICKS;
+  unsigned int seed = DEFAULT_SEED;
+  unsigned int aiThreads = 0;
+  std::string recordPath;
+  std::string replayPath;
+};
+
+Options parseOptions(int argc, char** argv) {
+  Options options;
+  int positional = 0;
+  for (int i = 1; i < argc; ++i) {
+    const std::string argument = argv[i];
+    if ((argument == "--record" || argument == "--replay") && i + 1 < argc) {
+      (argument == "--record" ? options.recordPath : options.replayPath) = argv[++i];
+    } else if (argument == "--ai-threads" && i + 1 < argc) {
+      options.aiThreads = static_cast<unsigned int>(parseNumber(argv[++i], 0));
+    } else if (positional == 0) {
+      options.ticks = parseNumber(argv[i], DEFAULT_TICKS);
+      ++positional;
+    } else if (positional == 1) {
+      options.seed = static_cast<unsigned int>(parseNumber(argv[i], DEFAULT_SEED));
+      ++positional;
+    }
+  }
+  return options;
+}
+
+// Nothing displays these without the interface, so drop them each tick.
+std::size_t drainEvents(EventBus& eventBus) {
+  const std::size_t damageEvents = eventBus.consumeDamageEvents().size();
+  eventBus.consumeFloatingTextEvents();
+  eventBus.consumeRegionEvents();
+  return damageEvents;
+}
+
+void logRate(spdlog::logger& console, unsigned long ticks, double elapsed) {
+  console.info("Ran {} ticks in {:.3f}s ({:.0f} ticks/s, {:.1f}x real time)", ticks, elapsed,
+               elapsed > 0.0 ? static_cast<double>(ticks) / elapsed : 0.0,
+               elapsed > 0.0 ? static_cast<double>(ticks) * FIXED_DT / elapsed : 0.0);
+}
+
+// Replays a recording at full speed and checks the state after every tick against the hash
+// captured when it was recorded.
+int replay(spdlog::logger& console, const std::string& path, unsigned int aiThreads) {
+  using Clock = std::chrono::steady_clock;
+  const std::optional<InputRecording> recording = loadInputRecording(path);
+  if (!recording) {
+    console.error("Could not read recording {}", path);
+    return EXIT_FAILURE;
+  }
+  const unsigned long ticks = recording->frames.size();
+  console.info("Replaying {}: {} ticks, seed {}", path, ticks, recording->worldSeed);
+
+  Simulation simulation(recording->worldSeed, aiThreads);
+  ReplayInputSource input(*recording);
+  const Clock::time_point start = Clock::now();
+  for (unsigned long i = 0; i < ticks; ++i) {
+    simulation.update(FIXED_DT, input);
+    drainEvents(simulation.getEventBus());
+    if (i < recording->stateHashes.size() &&
+        simulation.computeStateHash() != recording->stateHashes[i]) {
+      console.error("Replay diverged at tick {}", simulation.getTick());
+      return EXIT_FAILURE;
+    }
+  }
+  logRate(console, ticks, std::chrono::duration<double>(Clock::now() - start).count());
+  console.info("Replay matched {} state hashes", recording->stateHashes.size());
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+// Usage: kingdom_of_nin_headless [ticks] [seed] [--record <file>] [--ai-threads <n>]
+//        kingdom_of_nin_headless --replay <file> [--ai-threads <n>]
+// Runs the simulation without a display as fast as it will go and reports the tick rate.
+int main(int argc, char** argv) {
+  using Clock = std::chrono::steady_clock;
+  auto console = spdlog::stdout_color_mt("console");
+  const Options options = parseOptions(argc, argv);
+  if (!options.replayPath.empty()) {
+    return replay(*console, options.replayPath, options.aiThreads);
+  }
+  console->info("Headless run: {} ticks, seed {}, {} AI threads", options.ticks, options.seed,
+                options.aiThreads);
+
+  Simulation simulation(options.seed, options.aiThreads);
+  WanderInputSource wander(options.seed);
+  RecordingInputSource recorder(wander, options.seed);
+  const bool recording = !options.recordPath.empty();
+  InputSource& input = recording ? static_cast<InputSource&>(recorder) : wander;
+  std::size_t damageEvents = 0;
+
+  const Clock::time_point start = Clock::now();
+  for (unsigned long i = 0; i < options.ticks; ++i) {
+    simulation.update(FIXED_DT, input);
+    damageEvents += drainEvents(simulation.getEventBus());
+    if (recording) {
+      recorder.recordStateHash(simulation.computeStateHash());
+    }
+  }
+  logRate(*console, options.ticks, std::chrono::duration<double>(Clock::now() - start).count());
+
+  const LevelComponent& level =
+      simulation.getRegistry().getComponent<LevelComponent>(simulation.getPlayerEntityId());
+  console->info("Player level {}, {} damage events", level.level, damageEvents);
+  const Simulation::MobLodCounts& lod = simulation.getMobLodCounts();
+  console->info("Mob AI detail: {} active, {} reduced, {} sleeping", lod.active, lod.reduced,
+                lod.sleeping);
+  if (recording && !saveInputRecording(options.recordPath, recorder.getRecording())) {
+    console->error("Could not write recording {}", options.recordPath);
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "rng.h"
+
+// Walker/Vose alias table over integer weights. Built once, then every sample is two bounded
+// draws and a compare with no allocation, however many outcomes there are. The arithmetic stays
+// in integers, so each outcome comes up with exactly weight / total probability.
+class AliasTable {
+public:
+  AliasTable() = default;
+  explicit AliasTable(const std::vector<int>& weights) { build(weights); }
+
+  // Negative weights count as zero. With no positive weight the table is left empty.
+  void build(const std::vector<int>& weights) {
+    this->columns.clear();
+    std::uint64_t total = 0;
+    for (int weight : weights) {
+      total += weight > 0 ? static_cast<std::uint64_t>(weight) : 0;
+    }
+    this->bucketSize = static_cast<std::uint32_t>(total);
+    if (total == 0 || total > UINT32_MAX || weights.size() > UINT32_MAX) {
+      this->bucketSize = 0;
+      return;
+    }
+
+    // Scaling by the outcome count makes the average column hold exactly bucketSize.
+    const std::size_t count = weights.size();
+    std::vector<std::uint64_t> scaled(count);
+    std::vector<std::uint32_t> small;
+    std::vector<std::uint32_t> large;
+    for (std::size_t i = 0; i < count; ++i) {
+      scaled[i] = (weights[i] > 0 ? static_cast<std::uint64_t>(weights[i]) : 0) * count;
+      (scaled[i] < total ? small : large).push_back(static_cast<std::uint32_t>(i));
+    }
+    this->columns.assign(count, Column{});
+    while (!small.empty() && !large.empty()) {
+      const std::uint32_t under = small.back();
+      small.pop_back();
+      const std::uint32_t over = large.back();
+      this->columns[under] = Column{static_cast<std::uint32_t>(scaled[under]), over};
+      scaled[over] -= total - scaled[under];
+      if (scaled[over] < total) {
+        large.pop_back();
+        small.push_back(over);
+      }
+    }
+    // Whatever is left is full up to rounding; keep it whole.
+    for (std::uint32_t index : large) {
+      this->columns[index] = Column{this->bucketSize, index};
+    }
+    for (std::uint32_t index : small) {
+      this->columns[index] = Column{this->bucketSize, index};
+    }
+  }
+
+  bool empty() const { return this->columns.empty(); }
+  std::size_t size() const { return this->columns.size(); }
+
+  // Index of the sampled outcome; the table must not be empty.
+  template <typename Generator> std::size_t sample(Generator& rng) const {
+    const std::size_t column = rng.index(this->columns.size());
+    const Column& entry = this->columns[column];
+    if (entry.threshold == this->bucketSize) {
+      return column;
+    }
+    return rng.index(this->bucketSize) < entry.threshold ? column : entry.alias;
+  }
+
+private:
+  struct Column {
+    std::uint32_t threshold = 0;
+    std::uint32_t alias = 0;
+  };
+
+  std::vector<Column> columns;
+  std::uint32_t bucketSize = 0;
+};
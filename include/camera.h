@@ -10,6 +10,8 @@ public:
 
   void update(Position position);
   const Position& getPosition() const { return position; }
+  int getViewWidth() const { return windowWidth; }
+  int getViewHeight() const { return windowHeight; }
 
 private:
   Position position;
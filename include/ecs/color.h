@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstdint>
+
+// RGBA color carried by simulation state; the renderer converts it when drawing.
+struct Color {
+  std::uint8_t r = 0;
+  std::uint8_t g = 0;
+  std::uint8_t b = 0;
+  std::uint8_t a = 255;
+};
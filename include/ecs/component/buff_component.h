@@ -1,18 +1,27 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
 #include "component.h"
+#include "ecs/timer_wheel.h"
 
 struct BuffInstance {
   int id = 0;
   std::string name;
-  float remaining = 0.0f;
   float duration = 0.0f;
+  std::uint64_t expiresAtTick = 0;
+  TimerId expiryTimer = NO_TIMER;
+
+  float remainingSeconds(std::uint64_t tick, float tickSeconds) const {
+    return tick >= expiresAtTick ? 0.0f : static_cast<float>(expiresAtTick - tick) * tickSeconds;
+  }
 };
 
 class BuffComponent : public Component {
 public:
   std::vector<BuffInstance> buffs;
+  // Bumped when a buff is gained or expires, not when one is refreshed.
+  std::uint32_t version = 0;
 };
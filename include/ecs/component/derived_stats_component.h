@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+
+#include "ecs/color.h"
+#include "ecs/component/component.h"
+#include "items/item.h"
+
+constexpr float ATTACK_RANGE = 56.0f;
+constexpr float ATTACK_COOLDOWN_SECONDS = 0.3f;
+
+struct EffectivePrimaryStats {
+  int strength = 0;
+  int dexterity = 0;
+  int intellect = 0;
+  int luck = 0;
+};
+
+struct AttackProfile {
+  float range = ATTACK_RANGE;
+  float halfAngle = 0.75f;
+  float cooldown = ATTACK_COOLDOWN_SECONDS;
+  bool isRanged = false;
+  float projectileSpeed = 0.0f;
+  float projectileRadius = 0.0f;
+  float projectileTrailLength = 0.0f;
+  Color projectileColor = {255, 255, 255, 255};
+};
+
+// The player's combat numbers with equipment folded in. refreshDerivedStats() rebuilds them only
+// when one of the recorded inputs below no longer matches.
+class DerivedStatsComponent : public Component {
+public:
+  EffectivePrimaryStats primary;
+  int armor = 0;
+  int attackPower = 0;
+  float critChance = 0.05f;
+  float critMultiplier = 1.5f;
+  AttackProfile attackProfile;
+
+  bool computed = false;
+  std::uint32_t equipmentVersion = 0;
+  std::uint32_t statsVersion = 0;
+  std::uint32_t buffsVersion = 0;
+  int level = 0;
+  CharacterClass characterClass = CharacterClass::Any;
+};
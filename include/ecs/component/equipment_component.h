@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <unordered_map>
 
 #include "component.h"
@@ -8,4 +9,6 @@
 class EquipmentComponent : public Component {
 public:
   std::unordered_map<ItemSlot, ItemInstance> equipped;
+  // Bumped on every equip or unequip.
+  std::uint32_t version = 0;
 };
@@ -1,14 +1,14 @@
 #pragma once
 
 #include "component.h"
+#include "ecs/color.h"
 #include "ecs/position.h"
-#include <SDL3/SDL.h>
 
 class GraphicComponent : public Component {
 public:
-  GraphicComponent(Position position, SDL_Color color) : position(position), color(color) {}
+  GraphicComponent(Position position, Color color) : position(position), color(color) {}
 
 public:
   Position position;
-  SDL_Color color;
+  Color color;
 };
\ No newline at end of file
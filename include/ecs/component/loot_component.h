@@ -1,6 +1,7 @@
 #pragma once
 
 #include "component.h"
+#include "ecs/timer_wheel.h"
 
 class LootComponent : public Component {
 public:
@@ -8,6 +9,6 @@ public:
       : itemId(itemId), despawnSeconds(despawnSeconds) {}
 
   int itemId;
-  float ageSeconds = 0.0f;
   float despawnSeconds = 90.0f;
+  TimerId despawnTimer = NO_TIMER;
 };
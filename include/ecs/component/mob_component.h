@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 #include "component.h"
 
 enum class MobType {
@@ -60,41 +62,30 @@ inline const char* mobTypeName(MobType type) {
   return "Mob";
 }
 
+// Resolved stats live in MobDatabase's per-level table; declared here so this header does not
+// pull in the database.
+struct MobResolvedStats;
+
 class MobComponent : public Component {
 public:
-  MobComponent(MobType type, int level, int homeX, int homeY, int regionX, int regionY,
-               int regionWidth, int regionHeight, float aggroRange, float leashRange, float speed,
-               int experience, int attackDamage, float attackCooldown, float attackRange,
-               MobBehaviorType behavior = MobBehaviorType::Melee,
-               MobAbilityType abilityType = MobAbilityType::None, float preferredRange = 0.0f,
-               float abilityValue = 0.0f, float abilityCooldown = 8.0f)
-      : level(level), homeX(homeX), homeY(homeY), regionX(regionX), regionY(regionY),
-        regionWidth(regionWidth), regionHeight(regionHeight), aggroRange(aggroRange),
-        leashRange(leashRange), speed(speed), experience(experience), type(type),
-        attackDamage(attackDamage), attackCooldown(attackCooldown), attackRange(attackRange),
-        behavior(behavior), abilityType(abilityType), preferredRange(preferredRange),
-        abilityValue(abilityValue), abilityCooldown(abilityCooldown) {}
+  MobComponent(MobType type, const MobResolvedStats* stats, int homeX, int homeY, int regionX,
+               int regionY, int regionWidth, int regionHeight)
+      : type(type), stats(stats), homeX(homeX), homeY(homeY), regionX(regionX), regionY(regionY),
+        regionWidth(regionWidth), regionHeight(regionHeight) {}
 
-  int level;
+  MobType type;
+  // Row of the database's stat table for this type and level; shared by every mob like it.
+  const MobResolvedStats* stats;
   int homeX;
   int homeY;
   int regionX;
   int regionY;
   int regionWidth;
   int regionHeight;
-  float aggroRange;
-  float leashRange;
-  float speed;
-  int experience;
-  MobType type;
-  int attackDamage;
-  float attackCooldown;
-  float attackRange;
-  float attackTimer = 0.0f;
-  MobBehaviorType behavior;
-  MobAbilityType abilityType;
-  float preferredRange;
-  float abilityValue;
-  float abilityCooldown;
-  float abilityTimer = 0.0f;
+  // First tick the mob may attack again.
+  std::uint64_t attackReadyTick = 0;
+  // First tick the ability is ready again.
+  std::uint64_t abilityReadyTick = 0;
+  // Time not yet simulated while the mob runs at reduced detail away from the player.
+  float deferredSeconds = 0.0f;
 };
@@ -1,13 +1,13 @@
 #pragma once
 
-#include "SDL3/SDL_pixels.h"
+#include "ecs/color.h"
 #include "ecs/component/component.h"
 
 class ProjectileComponent : public Component {
 public:
   ProjectileComponent(int sourceEntityId, int targetEntityId, float velocityX, float velocityY,
                       float remainingRange, int damage, bool isCrit, float radius,
-                      float trailLength, SDL_Color color)
+                      float trailLength, Color color)
       : sourceEntityId(sourceEntityId),
         targetEntityId(targetEntityId),
         velocityX(velocityX),
@@ -30,5 +30,7 @@ public:
   bool isCrit = false;
   float radius = 4.0f;
   float trailLength = 0.0f;
-  SDL_Color color = {255, 255, 255, 255};
+  Color color = {255, 255, 255, 255};
+  // Skill whose effects land on hit instead of damage; 0 for a basic attack.
+  int skillId = 0;
 };
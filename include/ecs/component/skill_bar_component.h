@@ -1,12 +1,18 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
 
 #include "component.h"
 
 struct SkillSlot {
   int skillId = -1;
-  float cooldownRemaining = 0.0f;
+  // First tick the skill can be used again.
+  std::uint64_t readyTick = 0;
+
+  float cooldownRemaining(std::uint64_t tick, float tickSeconds) const {
+    return tick >= readyTick ? 0.0f : static_cast<float>(readyTick - tick) * tickSeconds;
+  }
 };
 
 class SkillBarComponent : public Component {
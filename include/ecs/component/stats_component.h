@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 #include "component.h"
 
 class StatsComponent : public Component {
@@ -17,4 +19,6 @@ public:
   float parry = 0.0f;
   int unspentPoints = 0;
   int gold = 50;
+  // Bumped when base or primary stats change; gold and unspent points do not count.
+  std::uint32_t version = 0;
 };
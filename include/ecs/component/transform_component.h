@@ -5,8 +5,10 @@
 
 class TransformComponent : public Component {
 public:
-  TransformComponent(Position position) : position(position) {}
+  TransformComponent(Position position) : position(position), previousPosition(position) {}
 
 public:
   Position position;
+  // Position at the start of the current fixed step, used to interpolate rendering.
+  Position previousPosition;
 };
\ No newline at end of file
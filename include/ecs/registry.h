@@ -24,13 +24,14 @@ public:
     }
     components[componentId].push_back(std::move(component));
     indexes[entityId][componentId] = components[componentId].size() - 1;
-    if (signatures.count(entityId) == 0) {
-      signatures[entityId] = std::bitset<MAX_COMPONENTS>();
-    }
-    signatures[entityId].set(componentId, true);
+    std::bitset<MAX_COMPONENTS>& signature = signatures[entityId];
+    const std::bitset<MAX_COMPONENTS> previousSignature = signature;
+    signature.set(componentId, true);
+    // Only the component that completes a system's signature registers the entity with it.
     for (auto it = systems.begin(); it != systems.end(); ++it) {
       System* system = it->get();
-      if ((signatures[entityId] & system->getSignature()) == system->getSignature()) {
+      const std::bitset<MAX_COMPONENTS>& required = system->getSignature();
+      if ((signature & required) == required && (previousSignature & required) != required) {
         system->registerEntity(entityId);
       }
     }
@@ -42,6 +43,16 @@ public:
     return static_cast<T&>(*this->components[componentId][index]);
   }
 
+  template <typename T, typename Fn> void forEachComponent(Fn&& fn) {
+    auto it = this->components.find(getComponentId<T>());
+    if (it == this->components.end()) {
+      return;
+    }
+    for (std::unique_ptr<Component>& component : it->second) {
+      fn(static_cast<T&>(*component));
+    }
+  }
+
   std::vector<std::unique_ptr<System>>::const_iterator systemsBegin() const;
   std::vector<std::unique_ptr<System>>::const_iterator systemsEnd() const;
 
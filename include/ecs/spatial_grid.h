@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+struct CullStats {
+  int visible = 0;
+  int culled = 0;
+};
+
+// Uniform hash grid over entity anchor points, kept up to date as entities move. Moving within a
+// cell only rewrites the stored point, so settled or parked entities cost nothing per update.
+class SpatialGrid {
+public:
+  explicit SpatialGrid(float cellSize = 128.0f);
+
+  void clear();
+  // Inserts the entity, or moves it if it is already indexed.
+  void update(int entityId, float x, float y);
+  void remove(int entityId);
+  // Appends entities whose anchor lies inside the rect, in entity id order.
+  void query(float x, float y, float width, float height, std::vector<int>& out) const;
+  int size() const { return static_cast<int>(locations.size()); }
+
+private:
+  struct Entry {
+    int entityId;
+    float x;
+    float y;
+  };
+
+  struct Location {
+    std::int64_t cell;
+    int slot;
+  };
+
+  std::int64_t cellFor(float x, float y) const;
+  void removeFromCell(const Location& location);
+
+  float cellSize;
+  std::unordered_map<std::int64_t, std::vector<Entry>> cells;
+  std::unordered_map<int, Location> locations;
+};
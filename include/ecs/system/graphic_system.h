@@ -1,11 +1,26 @@
 #pragma once
 
-#include "SDL3/SDL.h"
+#include <vector>
+
+#include "ecs/color.h"
 #include "ecs/position.h"
+#include "ecs/spatial_grid.h"
 #include "system.h"
 
+struct SpriteSnapshot {
+  Position previous;
+  Position current;
+  Color color;
+};
+
 class GraphicSystem : public System {
 public:
   GraphicSystem(Registry& registry, std::bitset<MAX_COMPONENTS> signature);
-  void render(SDL_Renderer* renderer, const Position& cameraPosition);
+  // Appends the entities whose sprite overlaps the view rect (world coordinates).
+  void collectVisible(float viewX, float viewY, float viewWidth, float viewHeight,
+                      std::vector<SpriteSnapshot>& out);
+  const CullStats& getLastCullStats() const { return lastCullStats; }
+
+private:
+  CullStats lastCullStats;
 };
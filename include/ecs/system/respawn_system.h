@@ -1,14 +1,15 @@
 #pragma once
 
-#include <SDL3/SDL.h>
+#include <cstdint>
 #include <memory>
-#include <random>
 #include <unordered_map>
 #include <vector>
 
 #include "ecs/component/graphic_component.h"
 #include "ecs/registry.h"
+#include "ecs/timer_wheel.h"
 #include "mobs/mob_database.h"
+#include "rng.h"
 #include "world/map.h"
 #include "world/region.h"
 
@@ -16,15 +17,28 @@ class RespawnSystem {
 public:
   RespawnSystem(const MobDatabase& mobDatabase, unsigned int seed);
   void initialize(const Map& map, Registry& registry, std::vector<int>& mobEntityIds);
+  // Call once per simulation tick; respawns whatever came due this tick.
   void update(float dt, const Map& map, Registry& registry, std::vector<int>& mobEntityIds);
+  // Starts the respawn countdown for a mob whose health just reached zero.
+  void onMobKilled(int entityId);
   bool isSpawning(int entityId) const;
+  // Mobs placed by the last update(), for callers that index mob positions.
+  const std::vector<int>& getRespawnedEntityIds() const { return respawnedEntityIds; }
 
 private:
+  struct SlotRef {
+    int region = -1;
+    int slot = -1;
+  };
+
   void beginSpawnAnimation(int entityId, GraphicComponent& graphic, float duration);
+  void scheduleRespawn(const SlotRef& slotRef);
+  void respawn(const SlotRef& slotRef, const Map& map, Registry& registry,
+               std::vector<int>& mobEntityIds);
 
   struct SpawnSlot {
     int entityId = -1;
-    float respawnTimer = 0.0f;
+    TimerId respawnTimer = NO_TIMER;
   };
 
   struct SpawnRegionState {
@@ -38,11 +52,17 @@ private:
   struct SpawnAnimation {
     float remaining = 0.0f;
     float duration = 0.0f;
-    SDL_Color baseColor = {0, 0, 0, 255};
+    Color baseColor = {0, 0, 0, 255};
   };
 
   std::vector<SpawnRegionState> spawnRegions;
   std::unordered_map<int, SpawnAnimation> spawnAnimations;
+  std::unordered_map<int, SlotRef> slotsByEntity;
+  TimerWheel<SlotRef> respawnTimers;
+  std::vector<SlotRef> dueRespawns;
+  std::vector<int> respawnedEntityIds;
+  std::uint64_t tick = 0;
+  float tickSeconds = 1.0f / 60.0f;
   const MobDatabase& mobDatabase;
-  std::mt19937 rng;
+  Rng rng;
 };
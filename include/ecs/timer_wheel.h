@@ -0,0 +1,187 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using TimerId = std::uint64_t;
+constexpr TimerId NO_TIMER = 0;
+
+// Whole ticks needed to cover seconds at the given tick length, never less than one.
+inline std::uint64_t ticksForSeconds(float seconds, float tickSeconds) {
+  if (seconds <= 0.0f || tickSeconds <= 0.0f) {
+    return 1;
+  }
+  // The small bias keeps 1.2s at 1/60s from rounding up to 73 ticks.
+  const double ticks = std::ceil((static_cast<double>(seconds) / tickSeconds) - 1e-4);
+  return ticks < 1.0 ? 1 : static_cast<std::uint64_t>(ticks);
+}
+
+// Hierarchical timing wheel keyed on absolute ticks. Four levels of 64 slots cover 2^24 ticks
+// ahead (about three days at 60 ticks/s), with anything further parked until the top level wraps.
+// advance() only visits the slot for each tick plus the occasional cascade, so its cost follows
+// the timers that come due rather than the number pending. Timers due on the same tick fire in
+// the order they were scheduled.
+template <typename Payload> class TimerWheel {
+public:
+  explicit TimerWheel(std::uint64_t startTick = 0) : currentTick(startTick) {}
+
+  // Timers due at or before the current tick fire on the next advance().
+  TimerId schedule(std::uint64_t dueTick, const Payload& payload) {
+    std::uint32_t index = 0;
+    if (!this->freeNodes.empty()) {
+      index = this->freeNodes.back();
+      this->freeNodes.pop_back();
+    } else {
+      index = static_cast<std::uint32_t>(this->nodes.size());
+      this->nodes.emplace_back();
+    }
+    Node& node = this->nodes[index];
+    node.dueTick = std::max(dueTick, this->currentTick + 1);
+    node.sequence = this->nextSequence++;
+    node.payload = payload;
+    node.live = true;
+    place(index);
+    this->pendingCount += 1;
+    return makeId(index, node.generation);
+  }
+
+  // Returns false if the timer already fired or was cancelled.
+  bool cancel(TimerId id) {
+    Node* node = find(id);
+    if (!node) {
+      return false;
+    }
+    node->live = false;
+    this->pendingCount -= 1;
+    return true;
+  }
+
+  bool isPending(TimerId id) const { return find(id) != nullptr; }
+  std::size_t pending() const { return this->pendingCount; }
+  std::uint64_t getCurrentTick() const { return this->currentTick; }
+
+  // Steps to tick and appends the payloads that came due, in due order.
+  void advance(std::uint64_t tick, std::vector<Payload>& fired) {
+    while (this->currentTick < tick) {
+      this->currentTick += 1;
+      cascade();
+      std::vector<std::uint32_t>& slot = this->levels[0][this->currentTick & SLOT_MASK];
+      if (slot.empty()) {
+        continue;
+      }
+      this->due.swap(slot);
+      slot.clear();
+      if (this->due.size() > 1) {
+        std::sort(this->due.begin(), this->due.end(), [this](std::uint32_t a, std::uint32_t b) {
+          return this->nodes[a].sequence < this->nodes[b].sequence;
+        });
+      }
+      for (std::uint32_t index : this->due) {
+        Node& node = this->nodes[index];
+        if (node.live) {
+          fired.push_back(node.payload);
+          node.live = false;
+          this->pendingCount -= 1;
+        }
+        release(index);
+      }
+      this->due.clear();
+    }
+  }
+
+private:
+  static constexpr int LEVEL_BITS = 6;
+  static constexpr std::size_t SLOTS_PER_LEVEL = std::size_t{1} << LEVEL_BITS;
+  static constexpr std::uint64_t SLOT_MASK = SLOTS_PER_LEVEL - 1;
+  static constexpr int LEVEL_COUNT = 4;
+  static constexpr std::uint64_t WHEEL_SPAN = std::uint64_t{1} << (LEVEL_BITS * LEVEL_COUNT);
+
+  struct Node {
+    std::uint64_t dueTick = 0;
+    std::uint64_t sequence = 0;
+    Payload payload{};
+    std::uint32_t generation = 1;
+    bool live = false;
+  };
+
+  static TimerId makeId(std::uint32_t index, std::uint32_t generation) {
+    return (static_cast<TimerId>(generation) << 32) | index;
+  }
+
+  Node* find(TimerId id) {
+    return const_cast<Node*>(static_cast<const TimerWheel*>(this)->find(id));
+  }
+
+  const Node* find(TimerId id) const {
+    const std::uint32_t index = static_cast<std::uint32_t>(id & 0xFFFFFFFFu);
+    const std::uint32_t generation = static_cast<std::uint32_t>(id >> 32);
+    if (id == NO_TIMER || index >= this->nodes.size()) {
+      return nullptr;
+    }
+    const Node& node = this->nodes[index];
+    return (node.live && node.generation == generation) ? &node : nullptr;
+  }
+
+  // Cancelled nodes stay in their slot until it is reached; only then is the index reused.
+  void release(std::uint32_t index) {
+    this->nodes[index].generation += 1;
+    this->freeNodes.push_back(index);
+  }
+
+  void place(std::uint32_t index) {
+    const std::uint64_t dueTick = this->nodes[index].dueTick;
+    const std::uint64_t delta = dueTick - this->currentTick;
+    if (delta >= WHEEL_SPAN) {
+      this->overflow.push_back(index);
+      return;
+    }
+    int level = 0;
+    while (delta >= (std::uint64_t{1} << (LEVEL_BITS * (level + 1)))) {
+      ++level;
+    }
+    this->levels[level][(dueTick >> (LEVEL_BITS * level)) & SLOT_MASK].push_back(index);
+  }
+
+  // When a level's index wraps to zero, the next level's current slot is spread back down.
+  void cascade() {
+    if (this->currentTick % WHEEL_SPAN == 0 && !this->overflow.empty()) {
+      std::vector<std::uint32_t> parked;
+      parked.swap(this->overflow);
+      for (std::uint32_t index : parked) {
+        redistribute(index);
+      }
+    }
+    for (int level = 1; level < LEVEL_COUNT; ++level) {
+      const int shift = LEVEL_BITS * level;
+      if ((this->currentTick & ((std::uint64_t{1} << shift) - 1)) != 0) {
+        break;
+      }
+      std::vector<std::uint32_t> moving;
+      moving.swap(this->levels[level][(this->currentTick >> shift) & SLOT_MASK]);
+      for (std::uint32_t index : moving) {
+        redistribute(index);
+      }
+    }
+  }
+
+  void redistribute(std::uint32_t index) {
+    if (this->nodes[index].live) {
+      place(index);
+    } else {
+      release(index);
+    }
+  }
+
+  std::uint64_t currentTick;
+  std::uint64_t nextSequence = 0;
+  std::size_t pendingCount = 0;
+  std::array<std::array<std::vector<std::uint32_t>, SLOTS_PER_LEVEL>, LEVEL_COUNT> levels;
+  std::vector<std::uint32_t> overflow;
+  std::vector<Node> nodes;
+  std::vector<std::uint32_t> freeNodes;
+  std::vector<std::uint32_t> due;
+};
@@ -14,10 +14,15 @@ struct DamageEvent {
 
 enum class FloatingTextKind { Damage = 0, CritDamage, Heal, Info };
 
+// Numeric labels leave text empty and carry an amount instead; the floating text system formats
+// them and merges rapid hits on the same target. prefix must point at a string literal.
 struct FloatingTextEvent {
   std::string text;
   Position position;
   FloatingTextKind kind = FloatingTextKind::Info;
+  int amount = 0;
+  int targetId = -1;
+  const char* prefix = "";
 };
 
 enum class RegionTransition { Enter, Leave };
@@ -4,35 +4,37 @@
 #include "SDL3/SDL_video.h"
 #include <SDL3_ttf/SDL_ttf.h>
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <memory>
-#include <random>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "camera.h"
 #include "ecs/position.h"
-#include "ecs/registry.h"
-#include "ecs/system/respawn_system.h"
-#include "events/event_bus.h"
-#include "items/item_database.h"
-#include "mobs/mob_database.h"
-#include "quests/quest_database.h"
-#include "quests/quest_system.h"
-#include "skills/skill_database.h"
-#include "skills/skill_tree.h"
+#include "render_snapshot.h"
+#include "simulation/input_recording.h"
+#include "simulation/input_source.h"
+#include "simulation/simulation.h"
 #include "ui/buff_bar.h"
 #include "ui/character_stats.h"
 #include "ui/floating_text_system.h"
 #include "ui/inventory.h"
 #include "ui/minimap.h"
 #include "ui/quest_log.h"
+#include "ui/render_batch.h"
 #include "ui/shop_panel.h"
 #include "ui/skill_bar.h"
 #include "ui/skill_tree.h"
-#include "world/map.h"
+#include "ui/text_renderer.h"
+#include "triple_buffer.h"
+#include "ui/tile_chunk_cache.h"
 
 const int WINDOW_WIDTH = 640;
 const int WINDOW_HEIGHT = 480;
+constexpr float FIXED_TIMESTEP = 1.0f / 60.0f;
 
 class Game {
 public:
@@ -43,127 +45,98 @@ public:
   void update(float dt);
   void interpolate(float alpha);
   void render();
+  bool isVsyncEnabled() const { return vsyncEnabled; }
+  bool isSimulationThreaded() const { return simulationThread.joinable(); }
 
 private:
-  struct InputState {
-    const bool* keyboardState = nullptr;
-    int moveX = 0;
-    int moveY = 0;
-    std::array<bool, 5> skillPressed = {false, false, false, false, false};
-    std::array<bool, 5> skillJustPressed = {false, false, false, false, false};
-    bool pickupPressed = false;
-    bool pickupJustPressed = false;
-    bool interactPressed = false;
-    bool interactJustPressed = false;
-    bool debugPressed = false;
-    bool debugJustPressed = false;
-    bool resurrectPressed = false;
-    bool resurrectJustPressed = false;
-    bool questLogPressed = false;
-    bool questLogJustPressed = false;
-    bool acceptQuestPressed = false;
-    bool acceptQuestJustPressed = false;
-    bool turnInQuestPressed = false;
-    bool turnInQuestJustPressed = false;
-    bool questPrevPressed = false;
-    bool questPrevJustPressed = false;
-    bool questNextPressed = false;
-    bool questNextJustPressed = false;
-    bool classMenuPressed = false;
-    bool classMenuJustPressed = false;
-    std::array<bool, 4> classChoicePressed = {false, false, false, false};
-    std::array<bool, 4> classChoiceJustPressed = {false, false, false, false};
+  // Device state sampled on the main thread and handed to the simulation. Only the latest sample
+  // survives, so everything that must not be lost between ticks is a running total.
+  struct RawInput {
+    std::array<bool, SDL_SCANCODE_COUNT> keys{};
     float mouseX = 0.0f;
     float mouseY = 0.0f;
     bool mousePressed = false;
-    bool click = false;
-    float mouseWheelDelta = 0.0f;
+    float mouseWheelTotal = 0.0f;
+    // Key-down and click events seen so far, so a tap released before the next tick still lands.
+    std::array<std::uint32_t, INPUT_BUTTON_COUNT> buttonPresses{};
+    std::uint32_t mouseClicks = 0;
+    // Panel commands the simulation has not acknowledged yet, numbered from firstCommand.
+    std::vector<PanelCommand> commands;
+    std::uint32_t firstCommand = 0;
   };
 
-  InputState captureInput();
-  void updateNpcInteraction(const InputState& input);
-  void updateAutoTargetAndFacing(const InputState& input, float dt);
-  void updatePlayerAttack(float dt);
-  void updateMobBehavior(float dt);
-  void updatePlayerDeathState(const InputState& input);
-  void updateRegionAndQuestState();
-  void updateClassUnlockAndSelection(const InputState& input);
-  void updateUiInput(const InputState& input);
-  void updateSystems(const std::pair<int, int>& movementInput, float dt);
-  void updateLootPickup(const InputState& input);
-  void updateSkillBarAndBuffs(const InputState& input, float dt);
-  void updateToggles(const InputState& input);
-  void cullExpiredLoot(float dt);
-  void applyClassSelection(CharacterClass selectedClass);
-  Position playerCenter() const;
+  // Turns the latest sampled device state into simulation input for each tick.
+  class DeviceInputSource : public InputSource {
+  public:
+    explicit DeviceInputSource(TripleBuffer<RawInput>& rawInputs) : rawInputs(rawInputs) {}
+    InputFrame nextFrame() override;
+    std::uint32_t getConsumedCommands() const { return consumedCommands; }
+
+  private:
+    TripleBuffer<RawInput>& rawInputs;
+    float consumedMouseWheelTotal = 0.0f;
+    std::array<std::uint32_t, INPUT_BUTTON_COUNT> consumedButtonPresses{};
+    std::uint32_t consumedMouseClicks = 0;
+    std::uint32_t consumedCommands = 0;
+  };
+
+  void sampleRawInput();
+  void updateUiInput();
+  void publishRenderSnapshot();
+  void runSimulation();
+  void renderWorld(const RenderSnapshot& snapshot, float alpha, const Position& cameraPosition,
+                   float mouseX, float mouseY);
+  void renderInterface(const RenderSnapshot& snapshot, const Position& cameraPosition,
+                       float mouseX, float mouseY);
 
   SDL_Window* window = nullptr;
   SDL_Renderer* renderer = nullptr;
   TTF_Font* font = nullptr;
+  std::unique_ptr<TextRenderer> textRenderer;
+  std::unique_ptr<RenderBatch> renderBatch;
   std::unique_ptr<Camera> camera;
+  std::unique_ptr<Camera> renderCamera;
   std::unique_ptr<Inventory> inventoryUi;
   std::unique_ptr<CharacterStats> characterStats;
   std::unique_ptr<Minimap> minimap;
+  std::unique_ptr<TileChunkCache> tileChunkCache;
+  std::vector<int> visibleMobIds;
+  std::shared_ptr<const std::vector<NpcSnapshot>> npcSnapshots;
+  std::shared_ptr<const ItemDatabase> itemDatabaseSnapshot;
+  TripleBuffer<RenderSnapshot> renderSnapshots;
+  TripleBuffer<RawInput> rawInputs;
+  DeviceInputSource deviceInput{this->rawInputs};
+  std::unique_ptr<RecordingInputSource> inputRecorder;
+  std::string recordingPath;
+  float renderAlpha = 1.0f;
+  std::thread simulationThread;
+  std::atomic<bool> simulationRunning = false;
   std::unique_ptr<QuestLog> questLogUi;
   std::unique_ptr<ShopPanel> shopPanel;
-  std::unique_ptr<ItemDatabase> itemDatabase;
-  std::unique_ptr<MobDatabase> mobDatabase;
-  std::unique_ptr<SkillDatabase> skillDatabase;
-  std::unique_ptr<SkillTreeDefinition> skillTreeDefinition;
-  std::unique_ptr<QuestDatabase> questDatabase;
-  std::unique_ptr<QuestSystem> questSystem;
-  std::unique_ptr<EventBus> eventBus;
+  std::unique_ptr<Simulation> simulation;
   std::unique_ptr<FloatingTextSystem> floatingTextSystem;
-  std::unique_ptr<RespawnSystem> respawnSystem;
   std::unique_ptr<SkillBar> skillBar;
   std::unique_ptr<BuffBar> buffBar;
   std::unique_ptr<SkillTree> skillTree;
   bool running = true;
-  std::unique_ptr<Registry> registry;
-  std::unique_ptr<Map> map;
-  int playerEntityId = -1;
-  std::vector<int> mobEntityIds;
-  std::vector<int> lootEntityIds;
-  std::vector<int> projectileEntityIds;
-  std::vector<int> npcEntityIds;
-  std::vector<int> shopNpcIds;
-  float attackCooldownRemaining = 0.0f;
-  std::array<bool, 5> wasSkillPressed = {false, false, false, false, false};
-  bool wasPickupPressed = false;
-  bool wasInteractPressed = false;
-  bool wasResurrectPressed = false;
-  bool wasDebugPressed = false;
-  bool wasQuestLogPressed = false;
-  bool wasAcceptQuestPressed = false;
-  bool wasTurnInQuestPressed = false;
-  bool wasQuestPrevPressed = false;
-  bool wasQuestNextPressed = false;
-  bool wasClassMenuPressed = false;
-  std::array<bool, 4> wasClassChoicePressed = {false, false, false, false};
+  bool vsyncEnabled = false;
   bool showDebugMobRanges = false;
-  int lastRegionIndex = -1;
-  float playerHitFlashTimer = 0.0f;
-  float playerKnockbackImmunityRemaining = 0.0f;
-  float facingX = 0.0f;
-  float facingY = 1.0f;
-  float facingAngle = 1.5707964f;
-  bool isPlayerGhost = false;
-  bool hasCorpse = false;
-  Position corpsePosition = Position(0.0f, 0.0f);
-  int currentAutoTargetId = -1;
-  int currentNpcId = -1;
-  int activeNpcId = -1;
-  int activeNpcQuestSelection = 0;
-  bool shopOpen = false;
   bool questLogVisible = false;
-  bool classSelectionVisible = false;
-  bool classUnlockAnnounced = false;
   float questLogScroll = 0.0f;
   ShopPanelState shopPanelState;
+  // Snapshot NPC whose dialog npcDialogScroll belongs to; the scroll resets when another opens.
+  int dialogNpc = -1;
   float npcDialogScroll = 0.0f;
-  float mouseWheelDelta = 0.0f;
-  bool wasMousePressed = false;
-  unsigned int worldSeed = 0;
-  std::mt19937 rng;
-  std::mt19937 lootRng;
+  float mouseWheelTotal = 0.0f;
+  std::array<std::uint32_t, INPUT_BUTTON_COUNT> buttonPresses{};
+  std::uint32_t mouseClicks = 0;
+  // Commands queued by the panels that the last snapshot did not yet report as consumed.
+  std::vector<PanelCommand> pendingCommands;
+  std::uint32_t firstPendingCommand = 0;
+  // What the panels consumed last frame; they run once per rendered frame, not per tick.
+  std::uint32_t interfaceMouseClicks = 0;
+  std::uint32_t interfaceQuestLogPresses = 0;
+  float interfaceMouseWheelTotal = 0.0f;
+  bool wasInterfaceMousePressed = false;
+  std::chrono::steady_clock::time_point lastInterfaceUpdate = std::chrono::steady_clock::now();
 };
@@ -1,13 +1,25 @@
 #pragma once
 
-#include <string>
-#include <unordered_set>
+#include <cstdint>
 
-enum class ItemSlot { Weapon = 0, Shield, Shoulders, Chest, Pants, Boots, Cape };
+enum class ItemSlot : std::uint8_t { Weapon = 0, Shield, Shoulders, Chest, Pants, Boots, Cape };
 
-enum class CharacterClass { Any = 0, Warrior, Mage, Archer, Rogue };
+enum class CharacterClass : std::uint8_t { Any = 0, Warrior, Mage, Archer, Rogue };
 
-enum class WeaponType {
+// One bit per CharacterClass; an item usable by anyone carries all of them.
+using ClassMask = std::uint8_t;
+constexpr ClassMask ALL_CLASSES_MASK = 0x1F;
+
+constexpr ClassMask classBit(CharacterClass characterClass) {
+  return static_cast<ClassMask>(1u << static_cast<unsigned int>(characterClass));
+}
+
+// Items for one class; CharacterClass::Any gives an item everyone can use.
+constexpr ClassMask classMaskFor(CharacterClass characterClass) {
+  return characterClass == CharacterClass::Any ? ALL_CLASSES_MASK : classBit(characterClass);
+}
+
+enum class WeaponType : std::uint8_t {
   None = 0,
   OneHandedSword,
   TwoHandedSword,
@@ -18,7 +30,7 @@ enum class WeaponType {
   Dagger
 };
 
-enum class ItemRarity { Common = 0, Rare, Epic };
+enum class ItemRarity : std::uint8_t { Common = 0, Rare, Epic };
 
 struct PrimaryStatBonuses {
   int strength = 0;
@@ -27,11 +39,8 @@ struct PrimaryStatBonuses {
   int luck = 0;
 };
 
-struct WeaponEquipmentStats {
-  PrimaryStatBonuses primary;
-};
-
-struct ArmorEquipmentStats {
+// Weapons and armor share one block; armor only counts on non-weapon slots.
+struct ItemStats {
   int armor = 0;
   PrimaryStatBonuses primary;
 };
@@ -42,18 +51,19 @@ struct ProjectileStats {
   float trailLength = 0.0f;
 };
 
+// Plain data with no heap members. The name lives in ItemDatabase's string pool; look it up with
+// ItemDatabase::itemName.
 struct ItemDef {
   int id = 0;
-  std::string name;
+  int requiredLevel = 1;
+  int price = 0;
+  std::uint16_t nameId = 0;
   ItemSlot slot = ItemSlot::Weapon;
   ItemRarity rarity = ItemRarity::Common;
-  int requiredLevel = 1;
-  std::unordered_set<CharacterClass> allowedClasses;
   WeaponType weaponType = WeaponType::None;
-  WeaponEquipmentStats weaponStats;
-  ArmorEquipmentStats armorStats;
+  ClassMask allowedClasses = ALL_CLASSES_MASK;
+  ItemStats stats;
   ProjectileStats projectile;
-  int price = 0;
 };
 
 struct ItemInstance {
@@ -81,25 +91,19 @@ inline bool isWeaponItem(const ItemDef& def) {
 }
 
 inline const PrimaryStatBonuses& primaryStatsForItem(const ItemDef& def) {
-  return isWeaponItem(def) ? def.weaponStats.primary : def.armorStats.primary;
+  return def.stats.primary;
 }
 
 inline PrimaryStatBonuses& primaryStatsForItem(ItemDef& def) {
-  return isWeaponItem(def) ? def.weaponStats.primary : def.armorStats.primary;
+  return def.stats.primary;
 }
 
 inline int armorForItem(const ItemDef& def) {
-  return isWeaponItem(def) ? 0 : def.armorStats.armor;
+  return isWeaponItem(def) ? 0 : def.stats.armor;
 }
 
 inline bool canEquipForClass(const ItemDef& def, CharacterClass characterClass) {
-  if (def.allowedClasses.empty()) {
-    return true;
-  }
-  if (def.allowedClasses.count(CharacterClass::Any) > 0) {
-    return true;
-  }
-  return def.allowedClasses.count(characterClass) > 0;
+  return (def.allowedClasses & classBit(characterClass)) != 0;
 }
 
 inline bool meetsEquipRequirements(const ItemDef& def, int level, CharacterClass characterClass) {
@@ -108,3 +112,11 @@ inline bool meetsEquipRequirements(const ItemDef& def, int level, CharacterClass
   }
   return canEquipForClass(def, characterClass);
 }
+
+// Shops buy back at half price, and never for nothing once an item has a price.
+inline int sellPriceForItem(const ItemDef& def) {
+  if (def.price <= 0) {
+    return 0;
+  }
+  return def.price >= 2 ? def.price / 2 : 1;
+}
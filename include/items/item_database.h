@@ -1,9 +1,14 @@
 #pragma once
 
-#include <random>
-#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
 
+#include "alias_table.h"
 #include "items/item.h"
+#include "rng.h"
 
 struct EquipmentDropGenerationOptions {
   int weaponWeight = 35;
@@ -13,17 +18,67 @@ struct EquipmentDropGenerationOptions {
   int epicWeight = 5;
 };
 
+// EquipmentDropGenerationOptions compiled into alias tables, so a drop rolls its rarity and slot
+// in constant time. Build one per loot table at load rather than per kill.
+struct EquipmentDropTable {
+  EquipmentDropTable() : EquipmentDropTable(EquipmentDropGenerationOptions{}) {}
+  explicit EquipmentDropTable(const EquipmentDropGenerationOptions& options);
+
+  AliasTable rarity;
+  AliasTable slot;
+};
+
+// Everything a generated drop is derived from. The stats and the name are pure functions of
+// these fields, so the drop can be rebuilt from them at any time.
+struct RolledItem {
+  std::uint64_t seed = 0;
+  std::uint16_t level = 1;
+  ItemRarity rarity = ItemRarity::Common;
+  ItemSlot slot = ItemSlot::Weapon;
+  CharacterClass preferredClass = CharacterClass::Any;
+};
+
 class ItemDatabase {
 public:
   ItemDatabase();
 
+  // Ids from here up are generated drops.
+  static constexpr int FIRST_GENERATED_ITEM_ID = 1000;
+
+  // Generated items return nullptr once they have been released.
   const ItemDef* getItem(int id) const;
-  int generateEquipmentDrop(int targetLevel, CharacterClass preferredClass, std::mt19937& rng,
+  const RolledItem* getRolledItem(int id) const;
+  // Generated names are built on request rather than stored with every drop.
+  std::string itemName(const ItemDef& def) const;
+  int generateEquipmentDrop(int targetLevel, CharacterClass preferredClass, Rng& rng,
+                            const EquipmentDropTable& table);
+  int generateEquipmentDrop(int targetLevel, CharacterClass preferredClass, Rng& rng,
                             const EquipmentDropGenerationOptions& options = {});
 
+  // Drops every generated item whose id is not in referencedIds (loot on the ground, inventory
+  // and equipment), sorting referencedIds in place. Ids are never reused, so a stale id simply
+  // stops resolving.
+  void releaseUnreferenced(std::vector<int>& referencedIds);
+  std::size_t generatedItemCount() const { return this->rolledItems.size(); }
+  // Bumped whenever generated items are added or released, so a copy knows when it is stale.
+  std::uint32_t getVersion() const { return this->version; }
+
 private:
-  void addItem(ItemDef def);
+  struct GeneratedItem {
+    RolledItem roll;
+    ItemDef def;
+  };
+
+  const GeneratedItem* findGenerated(int id) const;
+  void addItem(ItemDef def, std::string_view name);
+  std::uint16_t internName(std::string_view name);
 
-  int nextGeneratedItemId = 1000;
-  std::unordered_map<int, ItemDef> items;
+  int nextGeneratedItemId = FIRST_GENERATED_ITEM_ID;
+  std::uint32_t version = 0;
+  // Base items indexed by id; unused ids hold a default entry with id 0.
+  std::vector<ItemDef> items;
+  std::vector<std::string> namePool;
+  // Live generated items in id order. Ids only grow, so new ones append and a sweep compacts the
+  // vector without reordering it.
+  std::vector<GeneratedItem> rolledItems;
 };
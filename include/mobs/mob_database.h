@@ -1,11 +1,15 @@
 #pragma once
 
-#include <random>
+#include <cstddef>
+#include <array>
+#include <cstdint>
 #include <vector>
 
-#include "SDL3/SDL.h"
+#include "alias_table.h"
+#include "ecs/color.h"
 #include "ecs/component/mob_component.h"
 #include "items/item_database.h"
+#include "rng.h"
 
 struct MobLootTable {
   int noDropWeight = 0;
@@ -15,7 +19,7 @@ struct MobLootTable {
 struct MobArchetype {
   MobType type = MobType::Goblin;
   const char* name = "";
-  SDL_Color color = {255, 255, 255, 255};
+  Color color = {255, 255, 255, 255};
   int baseHealth = 1;
   int healthPerLevel = 1;
   int baseExperience = 1;
@@ -42,7 +46,7 @@ struct MobArchetype {
 
 struct MobResolvedStats {
   int level = 1;
-  SDL_Color color = {255, 255, 255, 255};
+  Color color = {255, 255, 255, 255};
   int maxHealth = 1;
   int experience = 1;
   int attackDamage = 1;
@@ -64,12 +68,40 @@ public:
 
   const MobArchetype* get(MobType type) const;
   const std::vector<MobArchetype>& allArchetypes() const { return archetypes; }
-  const MobArchetype& randomArchetype(std::mt19937& rng) const;
-  const MobArchetype& randomArchetypeForBand(int spawnTier, int level, std::mt19937& rng) const;
-  MobResolvedStats resolveStats(MobType type, int level) const;
-  bool rollEquipmentDrop(MobType type, std::mt19937& rng,
-                         EquipmentDropGenerationOptions& outOptions) const;
+  const MobArchetype& randomArchetype(Rng& rng) const;
+  const MobArchetype& randomArchetypeForBand(int spawnTier, int level, Rng& rng) const;
+  // Row of the stat table built at load; levels clamp to the cap. Unknown types get defaults.
+  const MobResolvedStats& resolveStats(MobType type, int level) const;
+  // The drop table to generate from, or nullptr when the kill drops no equipment.
+  const EquipmentDropTable* rollEquipmentDrop(MobType type, Rng& rng) const;
 
 private:
+  // Archetypes that can spawn for one tier and level, with their spawn weights.
+  struct SpawnBand {
+    std::vector<std::uint32_t> archetypeIndices;
+    AliasTable weights;
+  };
+
+  // Outcome 1 of dropRoll means the kill drops equipment.
+  struct CompiledLootTable {
+    AliasTable dropRoll;
+    EquipmentDropTable equipment;
+  };
+
+  static constexpr std::size_t MOB_TYPE_COUNT = static_cast<std::size_t>(MobType::Ogre) + 1;
+
+  void buildStatTable();
+  void buildSamplingTables();
+  int archetypeIndex(MobType type) const;
+
   std::vector<MobArchetype> archetypes;
+  // archetypes index for each MobType, or -1 when the type has no archetype.
+  std::array<int, MOB_TYPE_COUNT> indexByType{};
+  // Resolved stats for every archetype and level, row-major by archetype index.
+  std::vector<MobResolvedStats> statTable;
+  std::vector<CompiledLootTable> lootTables;
+  std::vector<SpawnBand> spawnBands;
+  // spawnBands index for each tier and level, row-major by tier; -1 when nothing can spawn.
+  std::vector<int> bandByTierLevel;
+  int spawnTierCount = 0;
 };
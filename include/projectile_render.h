@@ -0,0 +1,14 @@
+#pragma once
+
+#include <vector>
+
+#include "ecs/position.h"
+#include "ecs/registry.h"
+#include "render_snapshot.h"
+#include "ui/render_batch.h"
+
+void snapshotProjectiles(Registry& registry, const std::vector<int>& projectileEntityIds,
+                         std::vector<ProjectileSnapshot>& out);
+
+void renderProjectiles(RenderBatch& batch, const Position& cameraPosition,
+                       const std::vector<ProjectileSnapshot>& projectiles, float alpha);
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "ecs/color.h"
+#include "ecs/component/buff_component.h"
+#include "ecs/component/class_component.h"
+#include "ecs/component/derived_stats_component.h"
+#include "ecs/component/equipment_component.h"
+#include "ecs/component/health_component.h"
+#include "ecs/component/inventory_component.h"
+#include "ecs/component/level_component.h"
+#include "ecs/component/mana_component.h"
+#include "ecs/component/quest_log_component.h"
+#include "ecs/component/shop_component.h"
+#include "ecs/component/skill_bar_component.h"
+#include "ecs/component/skill_tree_component.h"
+#include "ecs/component/stats_component.h"
+#include "ecs/position.h"
+#include "ecs/spatial_grid.h"
+#include "ecs/system/graphic_system.h"
+#include "items/item_database.h"
+#include "ui/floating_text_system.h"
+
+struct ProjectileSnapshot {
+  Position previous;
+  Position current;
+  float radius = 0.0f;
+  float trailLength = 0.0f;
+  float velocityX = 0.0f;
+  float velocityY = 0.0f;
+  Color color = {255, 255, 255, 255};
+};
+
+struct MobOverlaySnapshot {
+  Position previous;
+  Position current;
+  float healthRatio = 0.0f;
+  bool alive = false;
+  const char* label = "";
+};
+
+struct MobRangeSnapshot {
+  Position center;
+  float aggroRange = 0.0f;
+  float leashRange = 0.0f;
+};
+
+struct NpcSnapshot {
+  std::string name;
+  std::string dialogLine;
+  Position position;
+  Position center;
+  std::optional<ShopComponent> shop;
+};
+
+struct LootLabelSnapshot {
+  int itemId = 0;
+  Position position;
+  // The drop F would pick up.
+  bool closest = false;
+};
+
+// Player and panel state from one tick. The HUD and panels draw from this copy and queue panel
+// commands against it, so the render thread never reads the registry. Slots are recycled, so
+// components with a version counter are only copied again when it moves.
+struct HudSnapshot {
+  HealthComponent health;
+  ManaComponent mana;
+  LevelComponent level;
+  ClassComponent playerClass{CharacterClass::Any};
+  StatsComponent stats;
+  DerivedStatsComponent derived;
+  InventoryComponent inventory;
+  EquipmentComponent equipment;
+  QuestLogComponent questLog;
+  SkillBarComponent skillBar;
+  SkillTreeComponent skillTree;
+  BuffComponent buffs;
+  // False until this slot first holds the versioned components above.
+  bool hasVersionedCopies = false;
+  float tickSeconds = 0.0f;
+
+  Position playerCenter;
+  bool hasCorpse = false;
+  Position corpsePosition;
+  bool classSelectionVisible = false;
+
+  // NPCs and their stock never change once the world is built, so every snapshot shares them.
+  std::shared_ptr<const std::vector<NpcSnapshot>> npcs;
+  // Indices into npcs, or -1.
+  int nearbyNpc = -1;
+  int activeNpc = -1;
+  int activeNpcQuestSelection = 0;
+  // Set only while the active NPC's shop is open.
+  const ShopComponent* shop = nullptr;
+  std::vector<LootLabelSnapshot> lootLabels;
+
+  // Generated drops come and go between ticks, so the panels resolve ids against a frozen copy.
+  // A new one is taken only when the simulation's database version moves, and snapshots share it.
+  std::shared_ptr<const ItemDatabase> itemDatabase;
+
+  // Panel commands the simulation has taken so far; the main thread drops its copies of them.
+  std::uint32_t consumedCommands = 0;
+};
+
+// Moves longer than this within one tick are teleports (respawns, parking) and are not blended.
+constexpr float SNAPSHOT_SNAP_DISTANCE = 64.0f;
+
+inline Position interpolatePosition(const Position& previous, const Position& current,
+                                    float alpha) {
+  const float dx = current.x - previous.x;
+  const float dy = current.y - previous.y;
+  if ((dx * dx) + (dy * dy) > SNAPSHOT_SNAP_DISTANCE * SNAPSHOT_SNAP_DISTANCE) {
+    return current;
+  }
+  return Position(previous.x + (dx * alpha), previous.y + (dy * alpha));
+}
+
+// World state from one simulation tick: positions are kept for the previous and current tick so
+// the render side can interpolate without reading the registry.
+struct RenderSnapshot {
+  std::uint64_t tick = 0;
+  std::chrono::steady_clock::time_point publishedAt;
+
+  Position playerPrevious;
+  Position playerCurrent;
+  float playerWidth = 0.0f;
+  float playerHeight = 0.0f;
+  bool playerGhost = false;
+  float facingX = 0.0f;
+  float facingY = 1.0f;
+  float attackRange = 0.0f;
+  float attackHalfAngle = 0.0f;
+  float attackCooldownRatio = 1.0f;
+  bool attackCoolingDown = false;
+  float hitFlashAlpha = 0.0f;
+
+  bool hasAutoTarget = false;
+  Position autoTargetPrevious;
+  Position autoTargetCurrent;
+  float autoTargetWidth = 0.0f;
+  float autoTargetHeight = 0.0f;
+
+  std::vector<SpriteSnapshot> sprites;
+  std::vector<ProjectileSnapshot> projectiles;
+  std::vector<MobOverlaySnapshot> mobOverlays;
+  std::vector<FloatingTextSystem::FloatingText> floatingTexts;
+
+  bool showDebugOverlay = false;
+  std::vector<MobRangeSnapshot> mobRanges;
+  CullStats entityCullStats;
+  CullStats mobOverlayCullStats;
+
+  HudSnapshot hud;
+};
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Random numbers for the simulation and its tools. Rng is a sequential stream with 32 bytes of
+// state; CounterRng is stateless and derives each number from (seed, purpose, entity, tick), so
+// any thread can draw the same value in any order. Both produce identical sequences on every
+// platform, unlike the standard distributions.
+
+// SplitMix64 step, used to expand a small seed into a full generator state.
+inline std::uint64_t splitMix64(std::uint64_t& state) {
+  std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+// Maps the top 24 bits onto [0, 1) exactly.
+inline float unitFloat(std::uint32_t bits) {
+  return static_cast<float>(bits >> 8) * (1.0f / 16777216.0f);
+}
+
+// Uniform in [0, bound) by Lemire's multiply-and-shift; nextU32 is asked again only in the rare
+// case that would otherwise bias the result.
+template <typename NextU32> std::uint32_t boundedU32(std::uint32_t bound, NextU32&& nextU32) {
+  std::uint64_t product = static_cast<std::uint64_t>(nextU32()) * bound;
+  std::uint32_t low = static_cast<std::uint32_t>(product);
+  if (low < bound) {
+    const std::uint32_t threshold = (0u - bound) % bound;
+    while (low < threshold) {
+      product = static_cast<std::uint64_t>(nextU32()) * bound;
+      low = static_cast<std::uint32_t>(product);
+    }
+  }
+  return static_cast<std::uint32_t>(product >> 32);
+}
+
+// Helpers shared by both generators; Derived supplies nextU32().
+template <typename Derived> class RngHelpers {
+public:
+  // Uniform in [0, 1).
+  float nextFloat() { return unitFloat(self().nextU32()); }
+  // Uniform over [low, high], both inclusive.
+  int range(int low, int high) {
+    const std::uint32_t span = static_cast<std::uint32_t>(high) - static_cast<std::uint32_t>(low);
+    if (span == UINT32_MAX) {
+      return static_cast<int>(self().nextU32());
+    }
+    return static_cast<int>(static_cast<std::uint32_t>(low) +
+                            boundedU32(span + 1, [this]() { return self().nextU32(); }));
+  }
+  // Uniform over [low, high).
+  float range(float low, float high) { return low + ((high - low) * nextFloat()); }
+  // Uniform index into a container of count elements; count must be positive.
+  std::size_t index(std::size_t count) {
+    return boundedU32(static_cast<std::uint32_t>(count), [this]() { return self().nextU32(); });
+  }
+  bool chance(float probability) { return nextFloat() < probability; }
+
+private:
+  Derived& self() { return static_cast<Derived&>(*this); }
+};
+
+// xoshiro256**: fast, 2^256 - 1 period, and a valid UniformRandomBitGenerator for std algorithms.
+class Rng : public RngHelpers<Rng> {
+public:
+  using result_type = std::uint64_t;
+
+  explicit Rng(std::uint64_t seed = 0) { reseed(seed); }
+
+  void reseed(std::uint64_t seed) {
+    std::uint64_t mixer = seed;
+    for (std::uint64_t& word : this->state) {
+      word = splitMix64(mixer);
+    }
+  }
+
+  // Takes the state as is; at least one word must be non-zero.
+  static Rng fromState(const std::array<std::uint64_t, 4>& state) {
+    Rng rng;
+    rng.state = state;
+    return rng;
+  }
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return UINT64_MAX; }
+
+  result_type operator()() {
+    const std::uint64_t result = rotl(this->state[1] * 5, 7) * 9;
+    const std::uint64_t shifted = this->state[1] << 17;
+    this->state[2] ^= this->state[0];
+    this->state[3] ^= this->state[1];
+    this->state[1] ^= this->state[2];
+    this->state[0] ^= this->state[3];
+    this->state[2] ^= shifted;
+    this->state[3] = rotl(this->state[3], 45);
+    return result;
+  }
+
+  std::uint32_t nextU32() { return static_cast<std::uint32_t>((*this)() >> 32); }
+
+private:
+  static std::uint64_t rotl(std::uint64_t value, int shift) {
+    return (value << shift) | (value >> (64 - shift));
+  }
+
+  std::array<std::uint64_t, 4> state{};
+};
+
+// Philox4x32-10 block: four 32-bit outputs from a 128-bit counter and a 64-bit key.
+inline std::array<std::uint32_t, 4> philox4x32(std::array<std::uint32_t, 4> counter,
+                                               std::array<std::uint32_t, 2> key) {
+  constexpr std::uint32_t MULTIPLIER_0 = 0xD2511F53u;
+  constexpr std::uint32_t MULTIPLIER_1 = 0xCD9E8D57u;
+  constexpr std::uint32_t WEYL_0 = 0x9E3779B9u;
+  constexpr std::uint32_t WEYL_1 = 0xBB67AE85u;
+  for (int round = 0; round < 10; ++round) {
+    const std::uint64_t product0 = static_cast<std::uint64_t>(MULTIPLIER_0) * counter[0];
+    const std::uint64_t product1 = static_cast<std::uint64_t>(MULTIPLIER_1) * counter[2];
+    counter = {static_cast<std::uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+               static_cast<std::uint32_t>(product1),
+               static_cast<std::uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+               static_cast<std::uint32_t>(product0)};
+    key[0] += WEYL_0;
+    key[1] += WEYL_1;
+  }
+  return counter;
+}
+
+// What a counter-based draw is for; part of the counter, so purposes never share numbers.
+enum class RngPurpose : std::uint8_t { Combat, Loot, Spawn, MobAbility, Tool };
+
+// Stateless stream for one (seed, purpose, entity, tick). Draws with the same key and the same
+// position in the stream always agree, whichever thread makes them and in whatever order.
+class CounterRng : public RngHelpers<CounterRng> {
+public:
+  CounterRng(std::uint64_t seed, RngPurpose purpose, std::uint32_t entity, std::uint64_t tick)
+      : key{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)},
+        counter{0, entity, static_cast<std::uint32_t>(tick),
+                static_cast<std::uint32_t>(purpose) |
+                    (static_cast<std::uint32_t>(tick >> 32) << 8)} {}
+
+  std::uint32_t nextU32() {
+    if (this->used == this->block.size()) {
+      this->block = philox4x32(this->counter, this->key);
+      this->counter[0] += 1;
+      this->used = 0;
+    }
+    return this->block[this->used++];
+  }
+
+private:
+  std::array<std::uint32_t, 2> key;
+  std::array<std::uint32_t, 4> counter;
+  std::array<std::uint32_t, 4> block{};
+  std::size_t used = 4;
+};
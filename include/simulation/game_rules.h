@@ -0,0 +1,46 @@
+#pragma once
+
+#include <array>
+
+#include "ecs/color.h"
+#include "ecs/component/buff_component.h"
+#include "ecs/component/class_component.h"
+#include "ecs/component/collision_component.h"
+#include "ecs/component/derived_stats_component.h"
+#include "ecs/component/equipment_component.h"
+#include "ecs/component/stats_component.h"
+#include "ecs/component/transform_component.h"
+#include "ecs/position.h"
+#include "items/item_database.h"
+
+// Formulas shared by the simulation and the interface that displays their results.
+
+constexpr float LOOT_PICKUP_RANGE = 40.0f;
+constexpr int PLAYER_LEVEL_CAP = 60;
+constexpr float RESURRECT_RANGE = 28.0f;
+
+constexpr std::array<CharacterClass, 4> CLASS_UNLOCK_CHOICES = {
+    CharacterClass::Warrior, CharacterClass::Mage, CharacterClass::Archer, CharacterClass::Rogue};
+
+const char* className(CharacterClass characterClass);
+Color lootColorForItem(const ItemDef* def);
+
+int computeAttackPower(const StatsComponent& stats, const EquipmentComponent& equipment,
+                       const ItemDatabase& database, CharacterClass characterClass);
+int computeArmor(const StatsComponent& stats, const EquipmentComponent& equipment,
+                 const ItemDatabase& database);
+EffectivePrimaryStats computeEffectivePrimaryStats(const StatsComponent& stats,
+                                                   const EquipmentComponent& equipment,
+                                                   const ItemDatabase& database);
+AttackProfile attackProfileForWeapon(const EquipmentComponent& equipment,
+                                     const ItemDatabase& database);
+// Recomputes derived, and the secondary stats on stats, when stats, equipment, buffs, level or
+// class changed since the last call. Returns whether anything was recomputed.
+bool refreshDerivedStats(DerivedStatsComponent& derived, StatsComponent& stats,
+                         const EquipmentComponent& equipment, const BuffComponent& buffs,
+                         int level, CharacterClass characterClass, const ItemDatabase& database);
+
+float squaredDistance(const Position& a, const Position& b);
+Position centerForEntity(const TransformComponent& transform, const CollisionComponent& collision);
+bool isInFacingArc(const Position& origin, const Position& target, float facingX, float facingY,
+                   float halfAngle);
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "simulation/input_source.h"
+
+// A play session reduced to what the simulation needs to repeat it: the world seed, one input
+// frame per tick and the state hash observed after each of those ticks.
+struct InputRecording {
+  unsigned int worldSeed = 0;
+  std::vector<InputFrame> frames;
+  std::vector<std::uint64_t> stateHashes;
+};
+
+// Frames are delta-encoded against the previous one, so idle or steady ticks cost one byte.
+bool saveInputRecording(const std::string& path, const InputRecording& recording);
+std::optional<InputRecording> loadInputRecording(const std::string& path);
+
+// Passes frames through from another source while appending them to a recording.
+class RecordingInputSource : public InputSource {
+public:
+  RecordingInputSource(InputSource& source, unsigned int worldSeed);
+
+  InputFrame nextFrame() override;
+  void recordStateHash(std::uint64_t hash);
+  const InputRecording& getRecording() const { return recording; }
+
+private:
+  InputSource& source;
+  InputRecording recording;
+};
+
+// Feeds a recording back one frame per tick; once it runs out every frame is idle.
+class ReplayInputSource : public InputSource {
+public:
+  explicit ReplayInputSource(const InputRecording& recording) : recording(recording) {}
+
+  InputFrame nextFrame() override;
+  bool isFinished() const { return nextIndex >= recording.frames.size(); }
+
+private:
+  const InputRecording& recording;
+  std::size_t nextIndex = 0;
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+enum class InputButton : std::uint8_t {
+  Skill1,
+  Skill2,
+  Skill3,
+  Skill4,
+  Skill5,
+  Pickup,
+  Interact,
+  Debug,
+  Resurrect,
+  QuestLog,
+  AcceptQuest,
+  TurnInQuest,
+  QuestPrev,
+  QuestNext,
+  ClassMenu,
+  ClassChoice1,
+  ClassChoice2,
+  ClassChoice3,
+  ClassChoice4,
+};
+
+constexpr std::size_t INPUT_BUTTON_COUNT = static_cast<std::size_t>(InputButton::ClassChoice4) + 1;
+
+enum class PanelCommandType : std::uint8_t {
+  EquipItem,      // value: inventory index
+  UnequipItem,    // value: ItemSlot
+  BuyItem,        // value: index into the open shop's stock
+  SellItem,       // value: inventory index, while a shop is open
+  SpendStatPoint, // value: 0 strength, 1 dexterity, 2 intellect, 3 luck
+  UnlockSkill,    // value: skill tree node id
+};
+
+// A change made through a panel rather than in the world. It rides on the next frame, and the
+// simulation checks and applies it on that tick, so a replay repeats it.
+struct PanelCommand {
+  PanelCommandType type = PanelCommandType::EquipItem;
+  int value = 0;
+
+  bool operator==(const PanelCommand& other) const = default;
+};
+
+// What the player is doing during one tick, independent of the device it came from. Buttons
+// are held state; the simulation derives presses by comparing consecutive frames.
+struct InputFrame {
+  int moveX = 0;
+  int moveY = 0;
+  std::uint32_t buttons = 0;
+  float mouseX = 0.0f;
+  float mouseY = 0.0f;
+  bool mousePressed = false;
+  float mouseWheelDelta = 0.0f;
+  // Panel actions taken since the previous frame, applied in order.
+  std::vector<PanelCommand> commands;
+
+  bool isDown(InputButton button) const {
+    return (this->buttons & (1u << static_cast<unsigned int>(button))) != 0;
+  }
+  void setDown(InputButton button, bool down) {
+    const std::uint32_t bit = 1u << static_cast<unsigned int>(button);
+    this->buttons = down ? (this->buttons | bit) : (this->buttons & ~bit);
+  }
+};
+
+// Supplies one frame per simulation tick: the keyboard and mouse in the game, a script or a
+// recording when running headless.
+class InputSource {
+public:
+  virtual ~InputSource() = default;
+  virtual InputFrame nextFrame() = 0;
+};
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "ecs/registry.h"
+#include "items/item_database.h"
+
+// Generated items live only while loot, the inventory or the equipment refers to them. Sweeping
+// when the count doubles keeps the cost amortised to a constant per drop.
+class ItemSweeper {
+public:
+  // Generated item count that triggers the first sweep, and the floor for every later one.
+  static constexpr std::size_t MIN_THRESHOLD = 256;
+
+  // Releases every generated item not held by the loot entities or the player's inventory and
+  // equipment, once the database has reached the threshold. Returns whether a sweep ran.
+  bool sweep(ItemDatabase& database, Registry& registry, const std::vector<int>& lootEntityIds,
+             int playerEntityId);
+  std::size_t getThreshold() const { return threshold; }
+
+private:
+  std::size_t threshold = MIN_THRESHOLD;
+  std::vector<int> referencedIds;
+};
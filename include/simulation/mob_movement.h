@@ -0,0 +1,25 @@
+#pragma once
+
+#include "ecs/component/collision_component.h"
+#include "ecs/component/mob_component.h"
+#include "ecs/component/transform_component.h"
+#include "ecs/position.h"
+#include "world/map.h"
+
+// A mob whose centre is within this squared distance of its home tile's centre is home.
+constexpr float MOB_HOME_RADIUS_SQUARED = 4.0f;
+
+// Steps toward target for dt, each axis on its own so a wall on one still allows the other.
+void moveEntityToward(const Map& map, TransformComponent& transform,
+                      const CollisionComponent& collision, float speed, const Position& target,
+                      float dt);
+
+// Where the mob's home tile puts its top-left corner and its centre.
+Position mobHomePosition(const MobComponent& mob);
+Position mobHomeCenter(const MobComponent& mob, const CollisionComponent& collision);
+
+// Walks a mob that is not engaged home for the seconds owed by the AI level of detail, one
+// tickSeconds step at a time, exactly as the full-rate AI would have: walls stop it the same
+// way and it ends on the same spot.
+void settleIdleMob(const Map& map, const MobComponent& mob, TransformComponent& transform,
+                   const CollisionComponent& collision, float seconds, float tickSeconds);
@@ -0,0 +1,275 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ecs/position.h"
+#include "ecs/registry.h"
+#include "ecs/spatial_grid.h"
+#include "ecs/system/respawn_system.h"
+#include "ecs/timer_wheel.h"
+#include "events/event_bus.h"
+#include "items/item_database.h"
+#include "mobs/mob_database.h"
+#include "quests/quest_database.h"
+#include "quests/quest_system.h"
+#include "rng.h"
+#include "simulation/input_source.h"
+#include "simulation/item_sweeper.h"
+#include "simulation/status_effects.h"
+#include "simulation/worker_pool.h"
+#include "skills/skill_database.h"
+#include "skills/skill_tree.h"
+#include "skills/status_effect_database.h"
+#include "world/map.h"
+
+class BuffComponent;
+class CollisionComponent;
+class HealthComponent;
+class MobComponent;
+class TransformComponent;
+
+// The game world and every rule that advances it, with no window, renderer or font. Each
+// update() pulls one frame from an InputSource, so the same world runs behind the SDL front end
+// or headless.
+class Simulation {
+public:
+  // How many living mobs ran at each AI level of detail on the last tick.
+  struct MobLodCounts {
+    int active = 0;
+    int reduced = 0;
+    int sleeping = 0;
+  };
+
+  // One tick of input with presses resolved against the previous tick.
+  struct InputState {
+    int moveX = 0;
+    int moveY = 0;
+    std::array<bool, 5> skillPressed = {false, false, false, false, false};
+    std::array<bool, 5> skillJustPressed = {false, false, false, false, false};
+    bool pickupPressed = false;
+    bool pickupJustPressed = false;
+    bool interactPressed = false;
+    bool interactJustPressed = false;
+    bool debugPressed = false;
+    bool debugJustPressed = false;
+    bool resurrectPressed = false;
+    bool resurrectJustPressed = false;
+    bool questLogPressed = false;
+    bool questLogJustPressed = false;
+    bool acceptQuestPressed = false;
+    bool acceptQuestJustPressed = false;
+    bool turnInQuestPressed = false;
+    bool turnInQuestJustPressed = false;
+    bool questPrevPressed = false;
+    bool questPrevJustPressed = false;
+    bool questNextPressed = false;
+    bool questNextJustPressed = false;
+    bool classMenuPressed = false;
+    bool classMenuJustPressed = false;
+    std::array<bool, 4> classChoicePressed = {false, false, false, false};
+    std::array<bool, 4> classChoiceJustPressed = {false, false, false, false};
+    float mouseX = 0.0f;
+    float mouseY = 0.0f;
+    bool mousePressed = false;
+    bool click = false;
+    float mouseWheelDelta = 0.0f;
+  };
+
+  // aiWorkerThreads adds that many threads to mob AI; 0 keeps it on the calling thread. The
+  // outcome is the same either way.
+  explicit Simulation(unsigned int worldSeed, unsigned int aiWorkerThreads = 0);
+  ~Simulation();
+
+  void update(float dt, InputSource& inputSource);
+  // Call after changing the player's equipment or stats outside update() so readers see it now.
+  void refreshPlayerDerivedStats();
+  Position playerCenter() const;
+  // Digest of the player, mobs, loot and projectiles; equal seeds fed equal input must agree.
+  std::uint64_t computeStateHash();
+
+  std::uint64_t getTick() const { return tick; }
+  float getTickSeconds() const { return tickSeconds; }
+  unsigned int getWorldSeed() const { return worldSeed; }
+  const InputState& getInput() const { return input; }
+
+  Registry& getRegistry() { return *registry; }
+  const Map& getMap() const { return *map; }
+  EventBus& getEventBus() { return *eventBus; }
+  const ItemDatabase& getItemDatabase() const { return *itemDatabase; }
+  const MobDatabase& getMobDatabase() const { return *mobDatabase; }
+  const SkillDatabase& getSkillDatabase() const { return *skillDatabase; }
+  const SkillTreeDefinition& getSkillTreeDefinition() const { return *skillTreeDefinition; }
+  const QuestDatabase& getQuestDatabase() const { return *questDatabase; }
+  const StatusEffectDatabase& getStatusEffectDatabase() const { return *statusEffectDatabase; }
+  const StatusEffects& getStatusEffects() const { return statusEffects; }
+  const QuestSystem& getQuestSystem() const { return *questSystem; }
+  const RespawnSystem& getRespawnSystem() const { return *respawnSystem; }
+  // Every mob by centre; current as of the end of the last update().
+  const SpatialGrid& getMobGrid() const { return mobGrid; }
+
+  int getPlayerEntityId() const { return playerEntityId; }
+  const std::vector<int>& getMobEntityIds() const { return mobEntityIds; }
+  const std::vector<int>& getLootEntityIds() const { return lootEntityIds; }
+  const std::vector<int>& getProjectileEntityIds() const { return projectileEntityIds; }
+  const std::vector<int>& getNpcEntityIds() const { return npcEntityIds; }
+  const std::vector<int>& getShopNpcIds() const { return shopNpcIds; }
+
+  float getAttackCooldownRemaining() const { return attackCooldownRemaining; }
+  float getPlayerHitFlashTimer() const { return playerHitFlashTimer; }
+  float getFacingX() const { return facingX; }
+  float getFacingY() const { return facingY; }
+  bool isPlayerGhost() const { return playerGhost; }
+  bool hasPlayerCorpse() const { return hasCorpse; }
+  const Position& getCorpsePosition() const { return corpsePosition; }
+  int getAutoTargetId() const { return currentAutoTargetId; }
+  int getNearbyNpcId() const { return currentNpcId; }
+  int getActiveNpcId() const { return activeNpcId; }
+  int getActiveNpcQuestSelection() const { return activeNpcQuestSelection; }
+  bool isShopOpen() const { return shopOpen; }
+  bool isClassSelectionVisible() const { return classSelectionVisible; }
+  const MobLodCounts& getMobLodCounts() const { return mobLodCounts; }
+
+private:
+  // A living mob's components, looked up before the AI fans out across threads.
+  struct MobAiEntry {
+    int entityId = -1;
+    MobComponent* mob = nullptr;
+    TransformComponent* transform = nullptr;
+    const CollisionComponent* collision = nullptr;
+    HealthComponent* health = nullptr;
+  };
+
+  // Player state every mob reads during the think phase, fixed at the start of the tick.
+  struct MobThinkContext {
+    Position playerPosition = Position(0.0f, 0.0f);
+    Position playerCenter = Position(0.0f, 0.0f);
+    int playerTileX = 0;
+    int playerTileY = 0;
+    bool playerAlive = false;
+    float dt = 0.0f;
+  };
+
+  // An attack a mob is ready to make, resolved serially after the think phase.
+  struct MobAttack {
+    int mobEntityId = -1;
+    MobComponent* mob = nullptr;
+    HealthComponent* health = nullptr;
+    Position mobCenter = Position(0.0f, 0.0f);
+    float distToPlayer = 0.0f;
+  };
+
+  enum class ScheduledEventKind : std::uint8_t { BuffExpiry, LootDespawn };
+
+  // Something due on a later tick; id is the buff id or the loot entity id.
+  struct ScheduledEvent {
+    ScheduledEventKind kind = ScheduledEventKind::BuffExpiry;
+    int id = -1;
+  };
+
+  struct MobAiChunk {
+    std::vector<MobAttack> attacks;
+    MobLodCounts lodCounts;
+  };
+
+  void captureInput(const InputFrame& frame);
+  void applyPanelCommand(const PanelCommand& command);
+  void updateNpcInteraction();
+  void updateAutoTargetAndFacing(float dt);
+  void updatePlayerAttack(float dt);
+  bool damageMob(int mobEntityId, int damage, bool isCrit, const Position& hitPosition);
+  void handleMobKilled(int mobEntityId, const Position& position);
+  void updateStatusEffects();
+  bool castSkill(const SkillDef& skill);
+  void indexMob(int mobEntityId);
+  void applySkillEffects(const SkillDef& skill, const std::vector<int>& targets,
+                         const Position& origin);
+  void updateMobBehavior(float dt);
+  void thinkMob(const MobAiEntry& entry, const MobThinkContext& context, MobAiChunk& output) const;
+  void resolveMobAttack(const MobAttack& attack, const Position& playerCenter);
+  void updatePlayerDeathState();
+  void updateRegionAndQuestState();
+  void updateClassUnlockAndSelection();
+  void updateSystems(const std::pair<int, int>& movementInput, float dt);
+  void updateLootPickup();
+  void updateSkillBarAndBuffs();
+  void applyOrRefreshBuff(BuffComponent& buffs, int buffId, const std::string& name,
+                          float duration);
+  void scheduleLootDespawn(int lootEntityId);
+  void processTimers();
+  void despawnLoot(int lootEntityId);
+  void applyClassSelection(CharacterClass selectedClass);
+
+  std::unique_ptr<Registry> registry;
+  std::unique_ptr<Map> map;
+  std::unique_ptr<ItemDatabase> itemDatabase;
+  std::unique_ptr<MobDatabase> mobDatabase;
+  std::unique_ptr<SkillDatabase> skillDatabase;
+  std::unique_ptr<SkillTreeDefinition> skillTreeDefinition;
+  std::unique_ptr<QuestDatabase> questDatabase;
+  std::unique_ptr<StatusEffectDatabase> statusEffectDatabase;
+  std::unique_ptr<QuestSystem> questSystem;
+  std::unique_ptr<EventBus> eventBus;
+  std::unique_ptr<RespawnSystem> respawnSystem;
+  InputState input;
+  std::uint64_t tick = 0;
+  float tickSeconds = 1.0f / 60.0f;
+  TimerWheel<ScheduledEvent> timers;
+  std::vector<ScheduledEvent> firedTimers;
+  StatusEffects statusEffects;
+  // Mobs killed since the last status effect update, whose effects are dropped then.
+  std::vector<int> killedMobIds;
+  MobLodCounts mobLodCounts;
+  std::unique_ptr<WorkerPool> aiWorkers;
+  std::vector<MobAiEntry> mobAiEntries;
+  std::vector<MobAiChunk> mobAiChunks;
+  // Every mob by centre, dead or alive. Refreshed at the end of the mob update, which follows
+  // all movement and pushback, and whenever a mob respawns.
+  SpatialGrid mobGrid;
+  std::vector<int> skillCandidates;
+  std::vector<int> skillTargets;
+  int playerEntityId = -1;
+  std::vector<int> mobEntityIds;
+  std::vector<int> lootEntityIds;
+  ItemSweeper itemSweeper;
+  std::vector<int> projectileEntityIds;
+  std::vector<int> npcEntityIds;
+  std::vector<int> shopNpcIds;
+  float attackCooldownRemaining = 0.0f;
+  std::array<bool, 5> wasSkillPressed = {false, false, false, false, false};
+  bool wasPickupPressed = false;
+  bool wasInteractPressed = false;
+  bool wasResurrectPressed = false;
+  bool wasDebugPressed = false;
+  bool wasQuestLogPressed = false;
+  bool wasAcceptQuestPressed = false;
+  bool wasTurnInQuestPressed = false;
+  bool wasQuestPrevPressed = false;
+  bool wasQuestNextPressed = false;
+  bool wasClassMenuPressed = false;
+  std::array<bool, 4> wasClassChoicePressed = {false, false, false, false};
+  bool wasMousePressed = false;
+  int lastRegionIndex = -1;
+  float playerHitFlashTimer = 0.0f;
+  float playerKnockbackImmunityRemaining = 0.0f;
+  float facingX = 0.0f;
+  float facingY = 1.0f;
+  float facingAngle = 1.5707964f;
+  bool playerGhost = false;
+  bool hasCorpse = false;
+  Position corpsePosition = Position(0.0f, 0.0f);
+  int currentAutoTargetId = -1;
+  int currentNpcId = -1;
+  int activeNpcId = -1;
+  int activeNpcQuestSelection = 0;
+  bool shopOpen = false;
+  bool classSelectionVisible = false;
+  bool classUnlockAnnounced = false;
+  unsigned int worldSeed = 0;
+  Rng rng;
+  Rng lootRng;
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "ecs/component/derived_stats_component.h"
+#include "ecs/position.h"
+#include "skills/skill.h"
+
+// Geometry and scaling behind skill casts. The simulation gathers candidates with one spatial
+// query over skillAreaBounds, keeps those isInSkillArea accepts, then runs each effect over the
+// whole hit list.
+
+struct SkillAreaBounds {
+  float x = 0.0f;
+  float y = 0.0f;
+  float width = 0.0f;
+  float height = 0.0f;
+};
+
+SkillAreaBounds skillAreaBounds(const SkillTargeting& targeting, const Position& origin,
+                                float facingX, float facingY);
+// Whether a target centre lies in the shape; Self and Projectile shapes cover no area.
+bool isInSkillArea(const SkillTargeting& targeting, const Position& origin, float facingX,
+                   float facingY, const Position& target);
+// The effect's amount with the caster's stat scaling applied, rounded to whole points.
+int resolveSkillEffectAmount(const SkillEffect& effect, const DerivedStatsComponent& derived);
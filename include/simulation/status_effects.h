@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "skills/status_effect.h"
+
+// Health change from one damage or heal over time pulse; negative amounts are damage.
+struct StatusHealthChange {
+  int entityId = -1;
+  int amount = 0;
+};
+
+// Status effects on any number of entities, held as one structure of arrays per effect type so a
+// tick is a few straight passes over packed counters instead of a walk over entities. Durations
+// and pulse intervals are whole ticks counted down in place. Applying an effect the entity already
+// has refreshes it rather than stacking a second copy.
+class StatusEffects {
+public:
+  // power scales damage and heal pulses; it is usually the source's attack power.
+  void apply(int entityId, const StatusEffectDef& def, float power, float tickSeconds);
+  // Drops every effect on the given entities in one pass, e.g. the mobs that died this tick.
+  void clear(std::vector<int> entityIds);
+  // Counts every effect down one tick, queues the pulses that came due and rebuilds the
+  // per-entity modifiers.
+  void update();
+
+  // Pulses from the last update(), in a fixed order for a given history of calls.
+  const std::vector<StatusHealthChange>& getHealthChanges() const { return healthChanges; }
+  float speedMultiplier(int entityId) const;
+  float damageMultiplier(int entityId) const;
+  bool isStunned(int entityId) const;
+  // Whether a stun or slow currently changes how fast the entity moves.
+  bool affectsMovement(int entityId) const;
+  std::size_t activeCount() const;
+
+private:
+  struct PeriodicGroup {
+    std::vector<int> entityIds;
+    std::vector<int> effectIds;
+    std::vector<int> amounts;
+    std::vector<std::int32_t> pulseIntervals;
+    std::vector<std::int32_t> ticksToPulse;
+    std::vector<std::int32_t> ticksRemaining;
+  };
+
+  struct ModifierGroup {
+    std::vector<int> entityIds;
+    std::vector<int> effectIds;
+    std::vector<float> magnitudes;
+    std::vector<std::int32_t> ticksRemaining;
+  };
+
+  void tickPeriodic(PeriodicGroup& group, int sign);
+  void tickModifiers(ModifierGroup& group);
+  void removePeriodic(PeriodicGroup& group, std::size_t index);
+  void removeModifier(ModifierGroup& group, std::size_t index);
+  void rebuildModifiers();
+  void trackEntity(int entityId);
+
+  PeriodicGroup damageOverTime;
+  PeriodicGroup healOverTime;
+  ModifierGroup slows;
+  ModifierGroup stuns;
+  ModifierGroup statModifiers;
+  // (entity, effect id) to its index in the effect's group, so a refresh is one lookup.
+  std::unordered_map<std::uint64_t, std::uint32_t> indexByKey;
+  std::vector<StatusHealthChange> healthChanges;
+  // Folded modifiers indexed by entity id; only entities listed in modifiedEntities differ from
+  // the defaults.
+  std::vector<float> speedMultipliers;
+  std::vector<float> damageMultipliers;
+  std::vector<std::uint8_t> stunned;
+  std::vector<int> modifiedEntities;
+};
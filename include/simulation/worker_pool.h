@@ -0,0 +1,38 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of threads kept alive across ticks, so per-tick parallel work does not pay for
+// thread creation. run() hands out task indices to the workers and the calling thread alike and
+// returns once every task has finished.
+class WorkerPool {
+public:
+  explicit WorkerPool(unsigned int workerCount);
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  void run(std::size_t taskCount, const std::function<void(std::size_t)>& task);
+  unsigned int getWorkerCount() const { return static_cast<unsigned int>(workers.size()); }
+
+private:
+  void workerLoop();
+  void drainTasks();
+
+  std::vector<std::thread> workers;
+  std::mutex mutex;
+  std::condition_variable workReady;
+  std::condition_variable workDone;
+  const std::function<void(std::size_t)>* task = nullptr;
+  std::size_t taskCount = 0;
+  std::size_t nextTask = 0;
+  std::size_t pendingTasks = 0;
+  std::size_t generation = 0;
+  bool stopping = false;
+};
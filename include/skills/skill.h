@@ -1,10 +1,49 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <vector>
+
+enum class SkillTargetShape : std::uint8_t { Self, Circle, Cone, Line, Projectile };
+
+enum class SkillEffectType : std::uint8_t { Damage, Heal, Knockback, Status };
+
+enum class SkillScalingStat : std::uint8_t {
+  None,
+  AttackPower,
+  Strength,
+  Dexterity,
+  Intellect,
+  Luck
+};
+
+// Where a skill lands, measured from the caster's centre along its facing.
+struct SkillTargeting {
+  SkillTargetShape shape = SkillTargetShape::Self;
+  // Circle radius, cone and line length, or projectile travel.
+  float range = 0.0f;
+  // Cone half angle in radians.
+  float halfAngle = 0.0f;
+  // Full width of a line.
+  float width = 0.0f;
+  float projectileSpeed = 0.0f;
+};
+
+// Damage and heal amounts are hit points, knockback is pixels; each is amount plus scaling times
+// the caster's scalingStat. Heals always land on the caster, as do statuses from a Self skill.
+struct SkillEffect {
+  SkillEffectType type = SkillEffectType::Damage;
+  float amount = 0.0f;
+  SkillScalingStat scalingStat = SkillScalingStat::None;
+  float scaling = 0.0f;
+  int statusEffectId = 0;
+};
 
 struct SkillDef {
   int id = 0;
   std::string name;
   float cooldown = 0.0f;
   float buffDuration = 0.0f;
+  SkillTargeting targeting;
+  std::vector<SkillEffect> effects;
 };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <unordered_set>
 #include <vector>
 
 struct SkillNodeDef {
@@ -9,6 +10,16 @@ struct SkillNodeDef {
   std::vector<int> prerequisites;
 };
 
+inline bool prerequisitesMet(const std::unordered_set<int>& unlockedSkills,
+                             const SkillNodeDef& node) {
+  for (int prereq : node.prerequisites) {
+    if (unlockedSkills.count(prereq) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
 class SkillTreeDefinition {
 public:
   SkillTreeDefinition();
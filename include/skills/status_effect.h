@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+enum class StatusEffectType : std::uint8_t {
+  DamageOverTime,
+  HealOverTime,
+  Slow,
+  Stun,
+  StatModifier
+};
+
+struct StatusEffectDef {
+  int id = 0;
+  std::string name;
+  StatusEffectType type = StatusEffectType::DamageOverTime;
+  float duration = 0.0f;
+  // Seconds between pulses of a damage or heal over time.
+  float tickInterval = 1.0f;
+  // Share of the source's power per pulse for DoT/HoT, share of speed removed for a slow, and
+  // change to damage dealt for a stat modifier. Unused by stuns.
+  float magnitude = 0.0f;
+};
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <unordered_map>
+
+#include "skills/status_effect.h"
+
+class StatusEffectDatabase {
+public:
+  StatusEffectDatabase();
+
+  const StatusEffectDef* getEffect(int id) const;
+
+private:
+  void addEffect(StatusEffectDef def);
+
+  std::unordered_map<int, StatusEffectDef> effects;
+};
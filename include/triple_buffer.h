@@ -0,0 +1,41 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+
+// Lock-free single-producer/single-consumer handoff of the latest value. The writer fills back()
+// and publishes it; the reader acquires whatever was published last and reads front(). Each side
+// owns one slot and the third is exchanged atomically, so neither ever waits on the other.
+// Slots are recycled, so the writer must overwrite every field of back() before publishing.
+template <typename T> class TripleBuffer {
+public:
+  T& back() { return slots[writeIndex]; }
+
+  void publish() {
+    const unsigned int previous =
+        this->middle.exchange(this->writeIndex | FRESH_BIT, std::memory_order_acq_rel);
+    this->writeIndex = previous & INDEX_MASK;
+  }
+
+  // Returns true if a newer value was swapped into front().
+  bool acquire() {
+    if ((this->middle.load(std::memory_order_relaxed) & FRESH_BIT) == 0) {
+      return false;
+    }
+    const unsigned int previous =
+        this->middle.exchange(this->readIndex, std::memory_order_acq_rel);
+    this->readIndex = previous & INDEX_MASK;
+    return true;
+  }
+
+  const T& front() const { return slots[readIndex]; }
+
+private:
+  static constexpr unsigned int INDEX_MASK = 0x3;
+  static constexpr unsigned int FRESH_BIT = 0x4;
+
+  std::array<T, 3> slots{};
+  std::atomic<unsigned int> middle{1};
+  unsigned int writeIndex = 0;
+  unsigned int readIndex = 2;
+};
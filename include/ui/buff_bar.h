@@ -1,11 +1,19 @@
 #pragma once
 
+#include <cstdint>
+
 #include "SDL3/SDL.h"
-#include <SDL3_ttf/SDL_ttf.h>
 
 #include "ecs/component/buff_component.h"
+#include "ui/panel_cache.h"
+#include "ui/text_renderer.h"
 
 class BuffBar {
 public:
-  void render(SDL_Renderer* renderer, TTF_Font* font, const BuffComponent& buffs);
+  void render(SDL_Renderer* renderer, TextRenderer& text, const BuffComponent& buffs,
+              std::uint64_t tick, float tickSeconds);
+  void invalidate() { cache.invalidate(); }
+
+private:
+  PanelCache cache;
 };
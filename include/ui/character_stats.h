@@ -1,27 +1,34 @@
 #pragma once
 
 #include "SDL3/SDL.h"
-#include <SDL3_ttf/SDL_ttf.h>
 #include <string>
+#include <vector>
 
 #include "ecs/component/health_component.h"
 #include "ecs/component/level_component.h"
 #include "ecs/component/mana_component.h"
 #include "ecs/component/stats_component.h"
+#include "simulation/input_source.h"
+#include "ui/panel_cache.h"
+#include "ui/text_renderer.h"
 
 class CharacterStats {
 public:
   CharacterStats() = default;
 
+  // A click on a plus queues a SpendStatPoint command; the simulation spends the point.
   void handleInput(int mouseX, int mouseY, bool mousePressed, int windowWidth,
-                   StatsComponent& stats, bool isVisible);
-  void render(SDL_Renderer* renderer, TTF_Font* font, int windowWidth,
+                   const StatsComponent& stats, bool isVisible,
+                   std::vector<PanelCommand>& commands);
+  void render(SDL_Renderer* renderer, TextRenderer& text, int windowWidth,
               const HealthComponent& health, const ManaComponent& mana, const LevelComponent& level,
               int attackPower, const std::string& className, int strength, int gold, int dexterity,
-              int intellect, int luck, int unspentPoints, bool isVisible) const;
+              int intellect, int luck, int unspentPoints, bool isVisible);
+  void invalidate();
   static SDL_FRect panelRectForTesting(int windowWidth);
   static SDL_FRect plusRectForTesting(const SDL_FRect& panel, int index);
 
 private:
   bool wasMousePressed = false;
+  PanelCache cache;
 };
@@ -1,28 +1,55 @@
 #pragma once
 
-#include <string>
-#include <vector>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
 
 #include "SDL3/SDL.h"
 #include "ecs/position.h"
 #include "events/event_bus.h"
-#include <SDL3_ttf/SDL_ttf.h>
+#include "ui/text_renderer.h"
 
+// Floating combat and info labels kept in a fixed pool. Numeric events for the same target that
+// land within a short window merge into one ticking label, and the oldest labels give way once
+// the on-screen cap is reached.
 class FloatingTextSystem {
 public:
+  static constexpr std::size_t CAPACITY = 128;
+  static constexpr std::size_t DEFAULT_MAX_VISIBLE = 48;
+  static constexpr std::size_t MAX_TEXT_LENGTH = 47;
+
   struct FloatingText {
-    std::string text;
+    std::array<char, MAX_TEXT_LENGTH + 1> text{};
+    std::uint8_t length = 0;
     Position position;
     float lifetime = 0.0f;
     FloatingTextKind kind = FloatingTextKind::Info;
+    int targetId = -1;
+    int amount = 0;
+    const char* prefix = "";
+
+    std::string_view view() const { return std::string_view(text.data(), length); }
   };
 
-  explicit FloatingTextSystem(EventBus& eventBus);
+  explicit FloatingTextSystem(EventBus& eventBus, std::size_t maxVisible = DEFAULT_MAX_VISIBLE);
 
   void update(float dt);
-  void render(SDL_Renderer* renderer, const Position& cameraPosition, TTF_Font* font);
+  void setMaxVisible(std::size_t maxVisible);
+  std::span<const FloatingText> getFloatingTexts() const {
+    return std::span<const FloatingText>(floatingTexts.data(), count);
+  }
+  static void render(std::span<const FloatingText> texts, const Position& cameraPosition,
+                     TextRenderer& textRenderer);
 
 private:
+  void spawn(const FloatingTextEvent& event);
+  bool mergeIntoExisting(const FloatingTextEvent& event);
+  FloatingText& allocate();
+
   EventBus& eventBus;
-  std::vector<FloatingText> floatingTexts;
+  std::array<FloatingText, CAPACITY> floatingTexts{};
+  std::size_t count = 0;
+  std::size_t maxVisible;
 };
@@ -1,24 +1,29 @@
 #pragma once
 
 #include "SDL3/SDL.h"
-#include <SDL3_ttf/SDL_ttf.h>
+#include <vector>
 
 #include "ecs/component/class_component.h"
 #include "ecs/component/equipment_component.h"
 #include "ecs/component/inventory_component.h"
 #include "ecs/component/level_component.h"
 #include "items/item_database.h"
+#include "simulation/input_source.h"
+#include "ui/panel_cache.h"
+#include "ui/text_renderer.h"
 
 class Inventory {
 public:
   Inventory() = default;
 
+  // Clicks become equip and unequip commands for the simulation rather than edits here.
   void handleInput(const bool* keyboardState, int mouseX, int mouseY, bool mousePressed,
-                   InventoryComponent& inventory, EquipmentComponent& equipment,
+                   const InventoryComponent& inventory, const EquipmentComponent& equipment,
                    const ItemDatabase& database, const LevelComponent& level,
-                   const ClassComponent& characterClass);
-  void render(SDL_Renderer* renderer, TTF_Font* font, const InventoryComponent& inventory,
+                   const ClassComponent& characterClass, std::vector<PanelCommand>& commands);
+  void render(SDL_Renderer* renderer, TextRenderer& text, const InventoryComponent& inventory,
               const EquipmentComponent& equipment, const ItemDatabase& database);
+  void invalidate();
   bool isStatsVisible() const { return isStatsOpen; }
 
 private:
@@ -31,4 +36,6 @@ private:
   bool isStatsOpen = false;
   int lastMouseX = 0;
   int lastMouseY = 0;
+  PanelCache inventoryCache;
+  PanelCache equipmentCache;
 };
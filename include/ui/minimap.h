@@ -14,12 +14,20 @@ struct MinimapMarker {
 class Minimap {
 public:
   Minimap(int width, int height, int margin);
+  ~Minimap();
+  Minimap(const Minimap&) = delete;
+  Minimap& operator=(const Minimap&) = delete;
 
   void render(SDL_Renderer* renderer, const Map& map, const Position& playerPosition,
               int windowWidth, int windowHeight, const std::vector<MinimapMarker>& markers);
+  void invalidate();
 
 private:
+  void rebuildTerrain(SDL_Renderer* renderer, const Map& map);
+
   int width;
   int height;
   int margin;
+  SDL_Texture* terrainTexture = nullptr;
+  const Map* terrainMap = nullptr;
 };
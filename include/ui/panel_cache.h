@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "SDL3/SDL.h"
+
+// Accumulates everything a panel's pixels depend on into a 64-bit FNV-1a signature.
+class PanelKey {
+public:
+  PanelKey& add(std::uint64_t value);
+  PanelKey& add(int value);
+  PanelKey& add(bool value) { return add(value ? 1 : 0); }
+  PanelKey& add(float value);
+  PanelKey& add(const std::string& value);
+  std::uint64_t value() const { return hash; }
+
+private:
+  std::uint64_t hash = 14695981039346656037ull;
+};
+
+// Retains a panel's pixels in a target texture. Each frame the panel hands begin() the key of its
+// backing data; the version advances only when that key changes, and only then does the caller
+// redraw. Panels keep drawing in window coordinates: the texture spans from the window origin to
+// the panel's far corner and only the panel bounds are composited.
+class PanelCache {
+public:
+  PanelCache() = default;
+  ~PanelCache();
+  PanelCache(const PanelCache&) = delete;
+  PanelCache& operator=(const PanelCache&) = delete;
+
+  // Returns true when the caller must draw the panel; drawing goes to the cache until end(). If
+  // no target texture is available the panel is drawn straight to the screen instead.
+  bool begin(SDL_Renderer* renderer, const SDL_FRect& bounds, std::uint64_t key);
+  void end(SDL_Renderer* renderer);
+  void present(SDL_Renderer* renderer) const;
+  void invalidate();
+
+  std::uint64_t getVersion() const { return version; }
+  int getRedrawCount() const { return redrawCount; }
+
+private:
+  bool ensureTexture(SDL_Renderer* renderer, int width, int height);
+
+  SDL_Texture* texture = nullptr;
+  SDL_Texture* previousTarget = nullptr;
+  SDL_FRect bounds = {0.0f, 0.0f, 0.0f, 0.0f};
+  std::uint64_t key = 0;
+  std::uint64_t version = 0;
+  std::uint64_t drawnVersion = 0;
+  int textureWidth = 0;
+  int textureHeight = 0;
+  int redrawCount = 0;
+  bool valid = false;
+  bool drawingDirect = false;
+};
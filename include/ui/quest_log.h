@@ -1,11 +1,12 @@
 #pragma once
 
 #include "SDL3/SDL.h"
-#include <SDL3_ttf/SDL_ttf.h>
 
 #include "ecs/component/quest_log_component.h"
 #include "items/item_database.h"
 #include "quests/quest_database.h"
+#include "ui/panel_cache.h"
+#include "ui/text_renderer.h"
 
 class QuestLog {
 public:
@@ -13,7 +14,11 @@ public:
 
   SDL_FRect panelRect(int windowWidth, int windowHeight) const;
 
-  void render(SDL_Renderer* renderer, TTF_Font* font, const QuestLogComponent& questLog,
+  void render(SDL_Renderer* renderer, TextRenderer& text, const QuestLogComponent& questLog,
               const QuestDatabase& questDatabase, const ItemDatabase& itemDatabase,
-              int windowWidth, int windowHeight, bool isVisible, float& scroll) const;
+              int windowWidth, int windowHeight, bool isVisible, float& scroll);
+  void invalidate();
+
+private:
+  PanelCache cache;
 };
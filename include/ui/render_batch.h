@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "SDL3/SDL.h"
+
+// Collects untextured and textured quads into per-(texture, blend mode) vertex buffers and submits
+// each group with one SDL_RenderGeometry call on flush(). Groups are flushed in the order they
+// were first used, so primitives that must stack across groups need a flush() in between.
+class RenderBatch {
+public:
+  explicit RenderBatch(SDL_Renderer* renderer);
+  RenderBatch(const RenderBatch&) = delete;
+  RenderBatch& operator=(const RenderBatch&) = delete;
+
+  void fillRect(const SDL_FRect& rect, SDL_Color color,
+                SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND);
+  void outlineRect(const SDL_FRect& rect, SDL_Color color,
+                   SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND);
+  void line(float x0, float y0, float x1, float y1, SDL_Color color,
+            SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND);
+  void circle(float centerX, float centerY, float radius, SDL_Color color, int segments = 32,
+              SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND);
+  void texturedRect(SDL_Texture* texture, const SDL_FRect* source, const SDL_FRect& destination,
+                    SDL_Color tint = SDL_Color{255, 255, 255, 255},
+                    SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND);
+  void flush();
+
+  int getLastDrawCalls() const { return lastDrawCalls; }
+  int getLastQuadCount() const { return lastQuadCount; }
+
+private:
+  struct Group {
+    SDL_Texture* texture = nullptr;
+    SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND;
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+  };
+
+  Group& groupFor(SDL_Texture* texture, SDL_BlendMode blendMode);
+  void appendQuad(Group& group, const SDL_FPoint (&corners)[4], SDL_FColor color,
+                  const SDL_FPoint (&uvs)[4]);
+
+  SDL_Renderer* renderer;
+  std::vector<Group> groups;
+  std::vector<std::size_t> pendingOrder;
+  int lastDrawCalls = 0;
+  int lastQuadCount = 0;
+};
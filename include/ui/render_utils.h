@@ -1,7 +1,15 @@
 #pragma once
 
 #include "SDL3/SDL.h"
+#include "ecs/color.h"
 #include "ecs/position.h"
+#include "world/tile.h"
+
+inline SDL_Color toSdlColor(const Color& color) {
+  return SDL_Color{color.r, color.g, color.b, color.a};
+}
+
+SDL_Color tileColor(Tile tile);
 
 void drawCircle(SDL_Renderer* renderer, const Position& center, float radius,
                 const Position& cameraPosition, SDL_Color color);
@@ -1,13 +1,16 @@
 #pragma once
 
 #include "SDL3/SDL.h"
-#include <SDL3_ttf/SDL_ttf.h>
 #include <string>
+#include <vector>
 
 #include "ecs/component/inventory_component.h"
 #include "ecs/component/shop_component.h"
 #include "ecs/component/stats_component.h"
 #include "items/item_database.h"
+#include "simulation/input_source.h"
+#include "ui/panel_cache.h"
+#include "ui/text_renderer.h"
 
 struct ShopPanelState {
   float shopScroll = 0.0f;
@@ -22,14 +25,21 @@ public:
 
   void update(float dt, ShopPanelState& state) const;
 
+  // Purchases and sales are queued as commands; the notice reflects the state shown, and the
+  // simulation checks gold and space again when it applies them.
   void handleInput(float mouseX, float mouseY, float mouseWheelDelta, bool click,
-                   int windowWidth, int windowHeight,
-                   ShopPanelState& state, ShopComponent& shop, InventoryComponent& inventory,
-                   StatsComponent& stats, const ItemDatabase& itemDatabase) const;
+                   int windowWidth, int windowHeight, ShopPanelState& state,
+                   const ShopComponent& shop, const InventoryComponent& inventory,
+                   const StatsComponent& stats, const ItemDatabase& itemDatabase,
+                   std::vector<PanelCommand>& commands) const;
 
-  void render(SDL_Renderer* renderer, TTF_Font* font, int windowWidth, int windowHeight,
+  void render(SDL_Renderer* renderer, TextRenderer& text, int windowWidth, int windowHeight,
               float mouseX, float mouseY, const std::string& npcName,
               const ShopPanelState& state,
               const ShopComponent& shop, const InventoryComponent& inventory,
-              const StatsComponent& stats, const ItemDatabase& itemDatabase) const;
+              const StatsComponent& stats, const ItemDatabase& itemDatabase);
+  void invalidate();
+
+private:
+  PanelCache cache;
 };
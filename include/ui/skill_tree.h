@@ -1,20 +1,24 @@
 #pragma once
 
 #include "SDL3/SDL.h"
-#include <SDL3_ttf/SDL_ttf.h>
+#include <vector>
 
 #include "ecs/component/skill_tree_component.h"
+#include "simulation/input_source.h"
 #include "skills/skill_database.h"
 #include "skills/skill_tree.h"
+#include "ui/panel_cache.h"
+#include "ui/text_renderer.h"
 
 class SkillTree {
 public:
   void handleInput(const bool* keyboardState, int mouseX, int mouseY, bool mousePressed,
-                   SkillTreeComponent& tree, const SkillTreeDefinition& definition,
-                   int windowWidth);
-  void render(SDL_Renderer* renderer, TTF_Font* font, const SkillTreeComponent& tree,
+                   const SkillTreeComponent& tree, const SkillTreeDefinition& definition,
+                   int windowWidth, std::vector<PanelCommand>& commands);
+  void render(SDL_Renderer* renderer, TextRenderer& text, const SkillTreeComponent& tree,
               const SkillTreeDefinition& definition, const SkillDatabase& database,
               int windowWidth, int windowHeight);
+  void invalidate();
   bool isOpen() const { return isOpenFlag; }
 
 private:
@@ -23,4 +27,5 @@ private:
   bool isOpenFlag = false;
   int lastMouseX = 0;
   int lastMouseY = 0;
+  PanelCache cache;
 };
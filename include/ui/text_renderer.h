@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "SDL3/SDL.h"
+#include <SDL3_ttf/SDL_ttf.h>
+
+#include "ui/text_utils.h"
+
+// Draws text from a packed glyph atlas owned per font (and so per point size). Strings are shaped
+// once into atlas quads and cached by content; queued strings are submitted together with a
+// single SDL_RenderGeometry call on flush().
+class TextRenderer {
+public:
+  TextRenderer(SDL_Renderer* renderer, TTF_Font* font);
+  ~TextRenderer();
+  TextRenderer(const TextRenderer&) = delete;
+  TextRenderer& operator=(const TextRenderer&) = delete;
+
+  SDL_FPoint measure(const std::string& text);
+  const std::vector<std::string>& wrap(const std::string& text, int maxWidth);
+  SDL_FPoint draw(const std::string& text, float x, float y, SDL_Color color, float scale = 1.0f);
+  SDL_FPoint drawOutlined(const std::string& text, float x, float y, SDL_Color color,
+                          SDL_Color outlineColor, float scale = 1.0f);
+  SDL_FPoint queue(const std::string& text, float x, float y, SDL_Color color,
+                   float scale = 1.0f);
+  SDL_FPoint queueOutlined(const std::string& text, float x, float y, SDL_Color color,
+                           SDL_Color outlineColor, float scale = 1.0f);
+  // Lays fast-changing strings (ticking combat numbers) out straight from the cached glyphs
+  // instead of adding each one to the shaped string cache.
+  SDL_FPoint queueTransient(std::string_view text, float x, float y, SDL_Color color,
+                            float scale = 1.0f);
+  SDL_FPoint queueTransientOutlined(std::string_view text, float x, float y, SDL_Color color,
+                                    SDL_Color outlineColor, float scale = 1.0f);
+  void flush();
+  void invalidate();
+
+  TTF_Font* getFont() const { return font; }
+  float lineHeight() const { return static_cast<float>(fontHeight); }
+
+private:
+  struct Glyph {
+    SDL_FRect source;
+    int advance = 0;
+  };
+  struct GlyphQuad {
+    SDL_FRect source;
+    float offsetX = 0.0f;
+  };
+  struct ShapedText {
+    std::vector<GlyphQuad> quads;
+    float width = 0.0f;
+  };
+
+  const ShapedText* shape(const std::string& text);
+  bool shapeWithRepack(std::string_view text, ShapedText& shaped);
+  bool shapeInto(std::string_view text, ShapedText& shaped);
+  const Glyph* glyphFor(std::uint32_t codepoint);
+  bool ensureAtlas();
+  void resetAtlas();
+  void appendQuads(const ShapedText& shaped, float x, float y, SDL_Color color, float scale);
+  void appendOutlined(const ShapedText& shaped, float x, float y, SDL_Color color,
+                      SDL_Color outlineColor, float scale);
+
+  SDL_Renderer* renderer;
+  TTF_Font* font;
+  int fontHeight = 0;
+  SDL_Texture* atlas = nullptr;
+  int shelfX = 0;
+  int shelfY = 0;
+  int shelfHeight = 0;
+  std::unordered_map<std::uint32_t, Glyph> glyphs;
+  std::unordered_map<std::string, ShapedText> shapedCache;
+  ShapedText transientShape;
+  TextLayoutCache layoutCache;
+  std::vector<SDL_Vertex> vertices;
+  std::vector<int> indices;
+};
@@ -1,8 +1,41 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <list>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include <SDL3_ttf/SDL_ttf.h>
 
+// Decodes the UTF-8 sequence starting at index and advances past it. Malformed input yields '?'.
+std::uint32_t decodeUtf8(std::string_view text, std::size_t& index);
+
 std::vector<std::string> wrapText(TTF_Font* font, const std::string& text, int maxWidth);
+
+// Remembers wrapped lines per (font, text, max width), so text that is re-wrapped every frame is
+// measured once. Misses measure with cached glyph advances and kerning instead of shaping each
+// candidate line. Layouts live in list nodes and the least recently used one is evicted first, so
+// returned lines survive later wraps of other text and stay valid until evicted or clear().
+class TextLayoutCache {
+public:
+  const std::vector<std::string>& wrap(TTF_Font* font, const std::string& text, int maxWidth);
+  void clear();
+
+private:
+  struct Layout {
+    const std::string* text = nullptr;
+    TTF_Font* font = nullptr;
+    int maxWidth = 0;
+    std::vector<std::string> lines;
+  };
+
+  void evictLeastRecent();
+
+  // Most recently used first.
+  std::list<Layout> recency;
+  std::unordered_map<std::string, std::vector<std::list<Layout>::iterator>> layouts;
+  std::unordered_map<TTF_Font*, std::unordered_map<std::uint32_t, int>> advances;
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "SDL3/SDL.h"
+#include "ecs/position.h"
+#include "world/map.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+class TileChunkCache {
+public:
+  explicit TileChunkCache(int chunkTiles = 16, std::size_t maxChunks = 48);
+  ~TileChunkCache();
+  TileChunkCache(const TileChunkCache&) = delete;
+  TileChunkCache& operator=(const TileChunkCache&) = delete;
+
+  void render(SDL_Renderer* renderer, const Map& map, const Position& cameraPosition,
+              int viewWidth, int viewHeight);
+  void invalidateTile(int tileX, int tileY);
+  void invalidate();
+  int getLastDrawCalls() const { return lastDrawCalls; }
+
+private:
+  struct Chunk {
+    SDL_Texture* texture = nullptr;
+    bool dirty = true;
+    std::uint64_t lastUsedFrame = 0;
+  };
+
+  void bakeChunk(SDL_Renderer* renderer, const Map& map, int chunkX, int chunkY, Chunk& chunk);
+  void evictLeastRecentlyUsed();
+
+  std::unordered_map<int, Chunk> chunks;
+  const Map* cachedMap = nullptr;
+  int chunkTiles;
+  std::size_t maxChunks;
+  std::uint64_t frame = 0;
+  int lastDrawCalls = 0;
+};
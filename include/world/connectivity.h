@@ -0,0 +1,20 @@
+#pragma once
+
+#include <vector>
+
+#include "world/coordinate.h"
+#include "world/region.h"
+#include "world/tile.h"
+
+constexpr int NO_COMPONENT = -1;
+
+// Labels 4-connected walkable tiles with dense component ids in row-major order of first
+// appearance. Non-walkable tiles get NO_COMPONENT. Large grids are split into row strips that
+// are labelled on worker threads and stitched together along the strip seams.
+std::vector<int> labelWalkableComponents(const std::vector<Tile>& tiles, int width, int height);
+
+// Carves corridors of grass along a fewest-blocked-tiles path tree so every spawn region, goblin
+// camp and dungeon entrance shares a component with the hub tile. Updates the component labels
+// in place and returns the number of carved tiles.
+int carveRegionConnections(std::vector<Tile>& tiles, std::vector<int>& components, int width,
+                           int height, const std::vector<Region>& regions, const Coordinate& hub);
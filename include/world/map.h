@@ -3,6 +3,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "world/connectivity.h"
 #include "world/coordinate.h"
 #include "world/region.h"
 #include "world/tile.h"
@@ -10,21 +11,27 @@
 class Map {
 public:
   Map() = delete;
-  Map(int width, int height, std::unordered_map<Coordinate, Tile> tiles,
+  Map(int width, int height, std::vector<Tile> tiles, std::vector<Region> regions,
+      Coordinate startingPosition);
+  Map(int width, int height, const std::unordered_map<Coordinate, Tile>& tiles,
       std::vector<Region> regions, Coordinate startingPosition);
   ~Map() = default;
 
   void print();
+  int connectRegions();
   const std::vector<Region>& getRegions() const { return regions; }
   const Coordinate& getStartingPosition() const { return startingPosition; }
   Tile getTile(int x, int y) const;
   bool isWalkable(int x, int y) const;
   bool isInside(int x, int y) const;
+  int getComponent(int x, int y) const;
+  bool isReachable(int fromX, int fromY, int toX, int toY) const;
   int getWidth() const { return width; }
   int getHeight() const { return height; }
 
 private:
-  std::unordered_map<Coordinate, Tile> tiles;
+  std::vector<Tile> tiles;
+  std::vector<int> components;
   std::vector<Region> regions;
   Coordinate startingPosition;
   int width;
@@ -39,26 +46,24 @@ inline bool Map::isWalkable(int x, int y) const {
   if (!isInside(x, y)) {
     return false;
   }
-  auto it = tiles.find(Coordinate(x, y));
-  if (it == tiles.end()) {
-    return false;
-  }
-  switch (it->second) {
-  case Tile::Grass:
-  case Tile::Town:
-  case Tile::DungeonEntrance:
-    return true;
-  case Tile::Water:
-  case Tile::Mountain:
-    return false;
-  }
-  return false;
+  return isWalkableTile(tiles[(y * width) + x]);
 }
 
 inline Tile Map::getTile(int x, int y) const {
-  auto it = tiles.find(Coordinate(x, y));
-  if (it == tiles.end()) {
+  if (!isInside(x, y)) {
     return Tile::Grass;
   }
-  return it->second;
+  return tiles[(y * width) + x];
+}
+
+inline int Map::getComponent(int x, int y) const {
+  if (!isInside(x, y)) {
+    return NO_COMPONENT;
+  }
+  return components[(y * width) + x];
+}
+
+inline bool Map::isReachable(int fromX, int fromY, int toX, int toY) const {
+  const int component = getComponent(fromX, fromY);
+  return component != NO_COMPONENT && component == getComponent(toX, toY);
 }
@@ -1,5 +1,20 @@
 #pragma once
 
+#include <cstdint>
+
 constexpr int TILE_SIZE = 32;
 
-enum class Tile { Grass = 0, Water, Mountain, Town, DungeonEntrance };
+enum class Tile : std::uint8_t { Grass = 0, Water, Mountain, Town, DungeonEntrance };
+
+inline bool isWalkableTile(Tile tile) {
+  switch (tile) {
+  case Tile::Grass:
+  case Tile::Town:
+  case Tile::DungeonEntrance:
+    return true;
+  case Tile::Water:
+  case Tile::Mountain:
+    return false;
+  }
+  return false;
+}
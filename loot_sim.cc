@@ -0,0 +1,316 @@
+#include "items/item_database.h"
+#include "mobs/mob_database.h"
+#include "rng.h"
+#include "spdlog/sinks/stdout_color_sinks.h"
+#include "spdlog/spdlog.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace {
+constexpr unsigned long DEFAULT_KILLS = 20000000;
+constexpr float DEFAULT_SECONDS_PER_KILL = 12.0f;
+constexpr std::uint64_t SIM_SEED = 0x6C6F6F74ULL;
+constexpr int LEVEL_CAP = 60;
+constexpr int REPORT_LEVEL_STEP = 5;
+constexpr std::size_t RARITY_COUNT = static_cast<std::size_t>(ItemRarity::Epic) + 1;
+// Same divisor the shop applies when buying drops back.
+constexpr int SELL_DIVISOR = 2;
+// Generated drops are only read once, so each worker clears its database this often.
+constexpr unsigned long RELEASE_INTERVAL = 4096;
+
+constexpr std::array<CharacterClass, 4> SIM_CLASSES = {
+    CharacterClass::Warrior, CharacterClass::Mage, CharacterClass::Archer, CharacterClass::Rogue};
+constexpr std::array<const char*, 4> SIM_CLASS_NAMES = {"Warrior", "Mage", "Archer", "Rogue"};
+
+unsigned long parseNumber(const char* text, unsigned long fallback) {
+  char* end = nullptr;
+  const unsigned long parsed = std::strtoul(text, &end, 10);
+  return (end && *end == '\0' && end != text) ? parsed : fallback;
+}
+
+float parseSeconds(const char* text, float fallback) {
+  char* end = nullptr;
+  const float parsed = std::strtof(text, &end);
+  return (end && *end == '\0' && end != text && parsed > 0.0f) ? parsed : fallback;
+}
+
+// Experience the simulation asks for to leave a level: 100 at level 1, 100 more each level.
+std::uint64_t experienceToLevelUp(int level) { return static_cast<std::uint64_t>(level) * 100; }
+
+// Where each counter sits in one flat array, so a worker's tally merges with a single loop.
+class TallyLayout {
+public:
+  explicit TallyLayout(std::size_t archetypeCount)
+      : archetypeBase(LEVEL_CAP * LEVEL_FIELDS),
+        classBase(archetypeBase + (archetypeCount * ARCHETYPE_FIELDS)),
+        total(classBase + (SIM_CLASSES.size() * CLASS_FIELDS)) {}
+
+  enum LevelField : std::size_t { LevelKills, LevelExperience, LevelGold, LevelRarityBase };
+  enum RarityField : std::size_t { RarityDrops, RarityArmor, RarityPrimary, RarityPrice };
+  enum ClassField : std::size_t { ClassKills, ClassGold, ClassRarityBase };
+
+  std::size_t level(int level, LevelField field) const {
+    return (static_cast<std::size_t>(level - 1) * LEVEL_FIELDS) + field;
+  }
+  std::size_t levelRarity(int level, std::size_t rarity, RarityField field) const {
+    return this->level(level, LevelRarityBase) + (rarity * RARITY_FIELDS) + field;
+  }
+  // Slot 0 counts kills, then one slot per rarity.
+  std::size_t archetype(std::size_t index, std::size_t slot) const {
+    return this->archetypeBase + (index * ARCHETYPE_FIELDS) + slot;
+  }
+  std::size_t characterClass(std::size_t index, std::size_t field) const {
+    return this->classBase + (index * CLASS_FIELDS) + field;
+  }
+  std::size_t size() const { return this->total; }
+
+private:
+  static constexpr std::size_t RARITY_FIELDS = 4;
+  static constexpr std::size_t LEVEL_FIELDS = LevelRarityBase + (RARITY_COUNT * RARITY_FIELDS);
+  static constexpr std::size_t ARCHETYPE_FIELDS = 1 + RARITY_COUNT;
+  static constexpr std::size_t CLASS_FIELDS = ClassRarityBase + RARITY_COUNT;
+
+  std::size_t archetypeBase;
+  std::size_t classBase;
+  std::size_t total;
+};
+
+// One cell is a player level and class; its kills always draw from the same stream, so the
+// totals do not depend on how many workers share the cells.
+struct SimCell {
+  int level = 1;
+  std::size_t classIndex = 0;
+  unsigned long kills = 0;
+};
+
+void simulateCell(const SimCell& cell, const MobDatabase& mobs, ItemDatabase& items,
+                  int spawnTierCount, const TallyLayout& layout, std::vector<std::uint64_t>& tally,
+                  unsigned long& dropsSinceRelease) {
+  std::uint64_t mixer = SIM_SEED + (static_cast<std::uint64_t>(cell.level) * SIM_CLASSES.size()) +
+                        cell.classIndex;
+  Rng rng(splitMix64(mixer));
+  const CharacterClass characterClass = SIM_CLASSES[cell.classIndex];
+  const MobArchetype* firstArchetype = mobs.allArchetypes().data();
+  std::vector<int> noReferences;
+
+  for (unsigned long kill = 0; kill < cell.kills; ++kill) {
+    const int spawnTier = static_cast<int>(rng.index(static_cast<std::size_t>(spawnTierCount)));
+    const MobArchetype& archetype = mobs.randomArchetypeForBand(spawnTier, cell.level, rng);
+    const std::size_t archetypeIndex = static_cast<std::size_t>(&archetype - firstArchetype);
+    tally[layout.level(cell.level, TallyLayout::LevelKills)] += 1;
+    tally[layout.level(cell.level, TallyLayout::LevelExperience)] +=
+        static_cast<std::uint64_t>(mobs.resolveStats(archetype.type, cell.level).experience);
+    tally[layout.archetype(archetypeIndex, 0)] += 1;
+    tally[layout.characterClass(cell.classIndex, TallyLayout::ClassKills)] += 1;
+
+    const EquipmentDropTable* dropTable = mobs.rollEquipmentDrop(archetype.type, rng);
+    if (!dropTable) {
+      continue;
+    }
+    const int itemId = items.generateEquipmentDrop(cell.level, characterClass, rng, *dropTable);
+    const ItemDef* def = items.getItem(itemId);
+    if (!def) {
+      continue;
+    }
+    const std::size_t rarity = static_cast<std::size_t>(def->rarity);
+    const PrimaryStatBonuses& primary = def->stats.primary;
+    const int primaryTotal =
+        primary.strength + primary.dexterity + primary.intellect + primary.luck;
+    const std::uint64_t gold = static_cast<std::uint64_t>(std::max(1, def->price / SELL_DIVISOR));
+    tally[layout.level(cell.level, TallyLayout::LevelGold)] += gold;
+    tally[layout.levelRarity(cell.level, rarity, TallyLayout::RarityDrops)] += 1;
+    tally[layout.levelRarity(cell.level, rarity, TallyLayout::RarityArmor)] +=
+        static_cast<std::uint64_t>(armorForItem(*def));
+    tally[layout.levelRarity(cell.level, rarity, TallyLayout::RarityPrimary)] +=
+        static_cast<std::uint64_t>(primaryTotal);
+    tally[layout.levelRarity(cell.level, rarity, TallyLayout::RarityPrice)] +=
+        static_cast<std::uint64_t>(def->price);
+    tally[layout.archetype(archetypeIndex, 1 + rarity)] += 1;
+    tally[layout.characterClass(cell.classIndex, TallyLayout::ClassGold)] += gold;
+    tally[layout.characterClass(cell.classIndex, TallyLayout::ClassRarityBase + rarity)] += 1;
+
+    if (++dropsSinceRelease >= RELEASE_INTERVAL) {
+      items.releaseUnreferenced(noReferences);
+      dropsSinceRelease = 0;
+    }
+  }
+}
+
+double ratio(std::uint64_t numerator, std::uint64_t denominator) {
+  return denominator > 0 ? static_cast<double>(numerator) / static_cast<double>(denominator) : 0.0;
+}
+
+void reportArchetypes(spdlog::logger& console, const MobDatabase& mobs, const TallyLayout& layout,
+                      const std::vector<std::uint64_t>& totals) {
+  console.info("{:<14} {:>12} {:>8} {:>8} {:>8} {:>8}", "archetype", "kills", "drop%", "common%",
+               "rare%", "epic%");
+  const std::vector<MobArchetype>& archetypes = mobs.allArchetypes();
+  for (std::size_t index = 0; index < archetypes.size(); ++index) {
+    const std::uint64_t kills = totals[layout.archetype(index, 0)];
+    std::array<std::uint64_t, RARITY_COUNT> drops{};
+    std::uint64_t dropTotal = 0;
+    for (std::size_t rarity = 0; rarity < RARITY_COUNT; ++rarity) {
+      drops[rarity] = totals[layout.archetype(index, 1 + rarity)];
+      dropTotal += drops[rarity];
+    }
+    console.info("{:<14} {:>12} {:>8.2f} {:>8.2f} {:>8.2f} {:>8.2f}", archetypes[index].name,
+                 kills, 100.0 * ratio(dropTotal, kills), 100.0 * ratio(drops[0], dropTotal),
+                 100.0 * ratio(drops[1], dropTotal), 100.0 * ratio(drops[2], dropTotal));
+  }
+}
+
+void reportClasses(spdlog::logger& console, const TallyLayout& layout,
+                   const std::vector<std::uint64_t>& totals) {
+  console.info("{:<14} {:>12} {:>10} {:>8} {:>8} {:>8}", "class", "kills", "gold/kill",
+               "common%", "rare%", "epic%");
+  for (std::size_t index = 0; index < SIM_CLASSES.size(); ++index) {
+    const std::uint64_t kills = totals[layout.characterClass(index, TallyLayout::ClassKills)];
+    std::array<std::uint64_t, RARITY_COUNT> drops{};
+    std::uint64_t dropTotal = 0;
+    for (std::size_t rarity = 0; rarity < RARITY_COUNT; ++rarity) {
+      drops[rarity] = totals[layout.characterClass(index, TallyLayout::ClassRarityBase + rarity)];
+      dropTotal += drops[rarity];
+    }
+    console.info("{:<14} {:>12} {:>10.2f} {:>8.2f} {:>8.2f} {:>8.2f}", SIM_CLASS_NAMES[index],
+                 kills, ratio(totals[layout.characterClass(index, TallyLayout::ClassGold)], kills),
+                 100.0 * ratio(drops[0], dropTotal), 100.0 * ratio(drops[1], dropTotal),
+                 100.0 * ratio(drops[2], dropTotal));
+  }
+}
+
+// Mean armor / primary total / price of the drops at each rarity, every few levels.
+void reportStatCurves(spdlog::logger& console, const TallyLayout& layout,
+                      const std::vector<std::uint64_t>& totals) {
+  console.info("{:>5} {:>22} {:>22} {:>22}", "level", "common arm/pri/price", "rare arm/pri/price",
+               "epic arm/pri/price");
+  for (int level = 1; level <= LEVEL_CAP; ++level) {
+    if (level != 1 && level % REPORT_LEVEL_STEP != 0) {
+      continue;
+    }
+    std::array<std::array<double, 3>, RARITY_COUNT> means{};
+    for (std::size_t rarity = 0; rarity < RARITY_COUNT; ++rarity) {
+      const std::uint64_t drops =
+          totals[layout.levelRarity(level, rarity, TallyLayout::RarityDrops)];
+      means[rarity] = {
+          ratio(totals[layout.levelRarity(level, rarity, TallyLayout::RarityArmor)], drops),
+          ratio(totals[layout.levelRarity(level, rarity, TallyLayout::RarityPrimary)], drops),
+          ratio(totals[layout.levelRarity(level, rarity, TallyLayout::RarityPrice)], drops)};
+    }
+    console.info("{:>5} {:>7.1f}/{:>6.1f}/{:>7.1f} {:>7.1f}/{:>6.1f}/{:>7.1f} "
+                 "{:>7.1f}/{:>6.1f}/{:>7.1f}",
+                 level, means[0][0], means[0][1], means[0][2], means[1][0], means[1][1],
+                 means[1][2], means[2][0], means[2][1], means[2][2]);
+  }
+}
+
+// Income and levelling pace for a player who kills one mob of their own level every
+// secondsPerKill, fighting across every spawn tier.
+void reportProgression(spdlog::logger& console, const TallyLayout& layout,
+                       const std::vector<std::uint64_t>& totals, float secondsPerKill) {
+  const double killsPerHour = 3600.0 / secondsPerKill;
+  console.info("{:>5} {:>9} {:>10} {:>10} {:>8} {:>12} {:>10}", "level", "xp/kill", "xp/hour",
+               "gold/hour", "drop%", "min to next", "total h");
+  double cumulativeHours = 0.0;
+  for (int level = 1; level <= LEVEL_CAP; ++level) {
+    const std::uint64_t kills = totals[layout.level(level, TallyLayout::LevelKills)];
+    const double experiencePerKill =
+        ratio(totals[layout.level(level, TallyLayout::LevelExperience)], kills);
+    const double goldPerKill = ratio(totals[layout.level(level, TallyLayout::LevelGold)], kills);
+    std::uint64_t drops = 0;
+    for (std::size_t rarity = 0; rarity < RARITY_COUNT; ++rarity) {
+      drops += totals[layout.levelRarity(level, rarity, TallyLayout::RarityDrops)];
+    }
+    double hoursToNext = 0.0;
+    if (level < LEVEL_CAP && experiencePerKill > 0.0) {
+      hoursToNext = static_cast<double>(experienceToLevelUp(level)) /
+                    (experiencePerKill * killsPerHour);
+    }
+    if (level == 1 || level % REPORT_LEVEL_STEP == 0 || level == LEVEL_CAP) {
+      console.info("{:>5} {:>9.1f} {:>10.0f} {:>10.0f} {:>8.2f} {:>12.1f} {:>10.2f}", level,
+                   experiencePerKill, experiencePerKill * killsPerHour, goldPerKill * killsPerHour,
+                   100.0 * ratio(drops, kills), hoursToNext * 60.0, cumulativeHours);
+    }
+    cumulativeHours += hoursToNext;
+  }
+}
+} // namespace
+
+// Usage: kingdom_of_nin_loot_sim [kills] [threads] [seconds-per-kill]
+// Rolls kills for every player level and class against the live mob and loot tables, then
+// reports drop rarity, item stat curves, gold and XP per hour and time to level.
+int main(int argc, char** argv) {
+  auto console = spdlog::stdout_color_mt("console");
+  const unsigned long totalKills = argc > 1 ? parseNumber(argv[1], DEFAULT_KILLS) : DEFAULT_KILLS;
+  const unsigned long hardwareThreads = std::max(1U, std::thread::hardware_concurrency());
+  const unsigned long threadCount =
+      std::max(1UL, argc > 2 ? parseNumber(argv[2], hardwareThreads) : hardwareThreads);
+  const float secondsPerKill =
+      argc > 3 ? parseSeconds(argv[3], DEFAULT_SECONDS_PER_KILL) : DEFAULT_SECONDS_PER_KILL;
+
+  const MobDatabase mobs;
+  int spawnTierCount = 1;
+  for (const MobArchetype& archetype : mobs.allArchetypes()) {
+    spawnTierCount = std::max(spawnTierCount, archetype.maxSpawnTier + 1);
+  }
+  const TallyLayout layout(mobs.allArchetypes().size());
+
+  std::vector<SimCell> cells;
+  const std::size_t cellCount = LEVEL_CAP * SIM_CLASSES.size();
+  for (int level = 1; level <= LEVEL_CAP; ++level) {
+    for (std::size_t classIndex = 0; classIndex < SIM_CLASSES.size(); ++classIndex) {
+      const unsigned long kills = (totalKills / cellCount) +
+                                  (cells.size() < totalKills % cellCount ? 1UL : 0UL);
+      cells.push_back(SimCell{level, classIndex, kills});
+    }
+  }
+
+  // Workers claim cells from a shared counter and add their private tallies into the totals
+  // once at the end, so nothing is locked on the hot path.
+  std::vector<std::atomic<std::uint64_t>> totals(layout.size());
+  std::atomic<std::size_t> nextCell{0};
+  const auto worker = [&]() {
+    ItemDatabase items;
+    std::vector<std::uint64_t> tally(layout.size(), 0);
+    unsigned long dropsSinceRelease = 0;
+    for (std::size_t index = nextCell.fetch_add(1, std::memory_order_relaxed);
+         index < cells.size(); index = nextCell.fetch_add(1, std::memory_order_relaxed)) {
+      simulateCell(cells[index], mobs, items, spawnTierCount, layout, tally, dropsSinceRelease);
+    }
+    for (std::size_t slot = 0; slot < tally.size(); ++slot) {
+      if (tally[slot] != 0) {
+        totals[slot].fetch_add(tally[slot], std::memory_order_relaxed);
+      }
+    }
+  };
+
+  using Clock = std::chrono::steady_clock;
+  const Clock::time_point start = Clock::now();
+  std::vector<std::thread> threads;
+  for (unsigned long i = 1; i < threadCount; ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+  std::vector<std::uint64_t> merged(layout.size());
+  for (std::size_t slot = 0; slot < merged.size(); ++slot) {
+    merged[slot] = totals[slot].load(std::memory_order_relaxed);
+  }
+  console->info("{} kills on {} threads in {:.2f}s ({:.0f} kills/s)", totalKills, threadCount,
+               elapsed, elapsed > 0.0 ? static_cast<double>(totalKills) / elapsed : 0.0);
+  reportArchetypes(*console, mobs, layout, merged);
+  reportClasses(*console, layout, merged);
+  reportStatCurves(*console, layout, merged);
+  reportProgression(*console, layout, merged, secondsPerKill);
+  return EXIT_SUCCESS;
+}
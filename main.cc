@@ -1,17 +1,56 @@
 #include "game.h"
 #include "spdlog/sinks/stdout_color_sinks.h"
 #include "spdlog/spdlog.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace {
+constexpr double FIXED_DT = FIXED_TIMESTEP;
+// Frames longer than this (breakpoints, window drags) are clamped instead of replayed.
+constexpr double MAX_FRAME_TIME = 0.25;
+constexpr int MAX_STEPS_PER_FRAME = 5;
+} // namespace
 
 int main() {
+  using Clock = std::chrono::steady_clock;
   auto console = spdlog::stdout_color_mt("console");
   spdlog::get("console")->info("Kingdom of Nin");
   std::unique_ptr<Game> game = std::make_unique<Game>();
 
-  float dt = 1.0 / 60.0;
+  double accumulator = 0.0;
+  Clock::time_point previousTime = Clock::now();
   while (game->isRunning()) {
-    game->update(dt);
+    const Clock::time_point currentTime = Clock::now();
+    const double frameTime =
+        std::min(std::chrono::duration<double>(currentTime - previousTime).count(), MAX_FRAME_TIME);
+    previousTime = currentTime;
+
+    // With a simulation thread the game steps itself; this loop only renders.
+    if (!game->isSimulationThreaded()) {
+      accumulator += frameTime;
+      int steps = 0;
+      while (accumulator >= FIXED_DT && steps < MAX_STEPS_PER_FRAME) {
+        game->update(static_cast<float>(FIXED_DT));
+        accumulator -= FIXED_DT;
+        ++steps;
+      }
+      if (steps == MAX_STEPS_PER_FRAME) {
+        // Too far behind to catch up; drop the backlog rather than spiralling.
+        accumulator = std::min(accumulator, FIXED_DT);
+      }
+      game->interpolate(static_cast<float>(accumulator / FIXED_DT));
+    }
     game->render();
-    std::this_thread::sleep_for(std::chrono::milliseconds(16));
+
+    if (!game->isVsyncEnabled()) {
+      // Without vsync, present blocks for nothing; sleep until the next step is due.
+      const double elapsed = std::chrono::duration<double>(Clock::now() - currentTime).count();
+      const double untilNextStep = FIXED_DT - accumulator - elapsed;
+      if (untilNextStep > 0.0) {
+        std::this_thread::sleep_for(std::chrono::duration<double>(untilNextStep));
+      }
+    }
   }
   return 0;
 }
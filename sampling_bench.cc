@@ -0,0 +1,107 @@
+#include "alias_table.h"
+#include "mobs/mob_database.h"
+#include "rng.h"
+#include "spdlog/sinks/stdout_color_sinks.h"
+#include "spdlog/spdlog.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+constexpr unsigned long DEFAULT_SAMPLES = 5000000;
+constexpr int SPAWN_TIERS = 12;
+constexpr int LEVEL_CAP = 60;
+
+unsigned long parseNumber(const char* text, unsigned long fallback) {
+  char* end = nullptr;
+  const unsigned long parsed = std::strtoul(text, &end, 10);
+  return (end && *end == '\0' && end != text) ? parsed : fallback;
+}
+
+// The band roll as it was before the alias tables: filter the roster into fresh vectors, then
+// build a discrete_distribution for the one draw.
+const MobArchetype& linearBandRoll(const MobDatabase& database, int spawnTier, int level,
+                                   std::mt19937& rng) {
+  const std::vector<MobArchetype>& archetypes = database.allArchetypes();
+  std::vector<const MobArchetype*> candidates;
+  std::vector<int> weights;
+  for (const MobArchetype& archetype : archetypes) {
+    if (spawnTier < archetype.minSpawnTier || spawnTier > archetype.maxSpawnTier) {
+      continue;
+    }
+    if (level < archetype.minSpawnLevel || level > archetype.maxSpawnLevel) {
+      continue;
+    }
+    candidates.push_back(&archetype);
+    weights.push_back(std::max(1, archetype.spawnWeight));
+  }
+  if (candidates.empty()) {
+    std::uniform_int_distribution<std::size_t> dist(0, archetypes.size() - 1);
+    return archetypes[dist(rng)];
+  }
+  std::discrete_distribution<std::size_t> dist(weights.begin(), weights.end());
+  return *candidates[dist(rng)];
+}
+
+// The rarity roll as it was: sum the weights, then walk them.
+int linearRarityRoll(const EquipmentDropGenerationOptions& options, std::mt19937& rng) {
+  const int total = options.commonWeight + options.rareWeight + options.epicWeight;
+  std::uniform_int_distribution<int> dist(1, total);
+  const int roll = dist(rng);
+  if (roll <= options.commonWeight) {
+    return 0;
+  }
+  return roll <= options.commonWeight + options.rareWeight ? 1 : 2;
+}
+
+template <typename Body>
+void measure(spdlog::logger& console, const char* label, unsigned long samples, Body&& body) {
+  using Clock = std::chrono::steady_clock;
+  std::uint64_t checksum = 0;
+  const Clock::time_point start = Clock::now();
+  for (unsigned long i = 0; i < samples; ++i) {
+    checksum += body(i);
+  }
+  const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+  console.info("{:<28} {:>12.0f} samples/s (checksum {})", label,
+               elapsed > 0.0 ? static_cast<double>(samples) / elapsed : 0.0, checksum);
+}
+} // namespace
+
+// Usage: kingdom_of_nin_sampling_bench [samples]
+// Times the spawn band and rarity rolls the old way and through the alias tables.
+int main(int argc, char** argv) {
+  auto console = spdlog::stdout_color_mt("console");
+  const unsigned long samples = argc > 1 ? parseNumber(argv[1], DEFAULT_SAMPLES) : DEFAULT_SAMPLES;
+  const MobDatabase database;
+  const EquipmentDropGenerationOptions options;
+  const EquipmentDropTable dropTable(options);
+
+  std::mt19937 legacyRng(1);
+  Rng rng(1);
+  const auto tierFor = [](unsigned long i) { return static_cast<int>(i % SPAWN_TIERS); };
+  const auto levelFor = [](unsigned long i) { return 1 + static_cast<int>((i / 7) % LEVEL_CAP); };
+
+  measure(*console, "band roll, linear", samples, [&](unsigned long i) {
+    return static_cast<std::uint64_t>(
+        linearBandRoll(database, tierFor(i), levelFor(i), legacyRng).type);
+  });
+  measure(*console, "band roll, alias table", samples, [&](unsigned long i) {
+    return static_cast<std::uint64_t>(
+        database.randomArchetypeForBand(tierFor(i), levelFor(i), rng).type);
+  });
+  measure(*console, "rarity roll, linear", samples, [&](unsigned long) {
+    return static_cast<std::uint64_t>(linearRarityRoll(options, legacyRng));
+  });
+  measure(*console, "rarity roll, alias table", samples, [&](unsigned long) {
+    return static_cast<std::uint64_t>(dropTable.rarity.sample(rng));
+  });
+  measure(*console, "drop roll, alias table", samples, [&](unsigned long i) {
+    const MobType type = database.allArchetypes()[i % database.allArchetypes().size()].type;
+    return database.rollEquipmentDrop(type, rng) != nullptr ? std::uint64_t{1} : 0;
+  });
+  return EXIT_SUCCESS;
+}
@@ -1,8 +1,8 @@
 #include "ecs/registry.h"
-#include "SDL3/SDL.h"
 #include "ecs/component/buff_component.h"
 #include "ecs/component/class_component.h"
 #include "ecs/component/collision_component.h"
+#include "ecs/component/derived_stats_component.h"
 #include "ecs/component/equipment_component.h"
 #include "ecs/component/graphic_component.h"
 #include "ecs/component/health_component.h"
@@ -53,6 +53,7 @@ Registry::Registry()
   registerComponent<ClassComponent>();
   registerComponent<SkillBarComponent>();
   registerComponent<SkillTreeComponent>();
+  registerComponent<DerivedStatsComponent>();
 
   {
     auto signature = std::bitset<MAX_COMPONENTS>();
@@ -0,0 +1,99 @@
+#include "ecs/spatial_grid.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+std::int64_t packCell(std::int64_t column, std::int64_t row) {
+  return (column << 32) ^ (row & 0xffffffff);
+}
+} // namespace
+
+SpatialGrid::SpatialGrid(float cellSize) : cellSize(std::max(1.0f, cellSize)) {}
+
+void SpatialGrid::clear() {
+  this->cells.clear();
+  this->locations.clear();
+}
+
+void SpatialGrid::update(int entityId, float x, float y) {
+  const std::int64_t cell = cellFor(x, y);
+  auto it = this->locations.find(entityId);
+  if (it != this->locations.end()) {
+    if (it->second.cell == cell) {
+      Entry& entry = this->cells[cell][it->second.slot];
+      entry.x = x;
+      entry.y = y;
+      return;
+    }
+    removeFromCell(it->second);
+  } else {
+    it = this->locations.emplace(entityId, Location{}).first;
+  }
+  std::vector<Entry>& entries = this->cells[cell];
+  it->second = Location{cell, static_cast<int>(entries.size())};
+  entries.push_back(Entry{entityId, x, y});
+}
+
+void SpatialGrid::remove(int entityId) {
+  auto it = this->locations.find(entityId);
+  if (it == this->locations.end()) {
+    return;
+  }
+  removeFromCell(it->second);
+  this->locations.erase(it);
+}
+
+void SpatialGrid::query(float x, float y, float width, float height,
+                        std::vector<int>& out) const {
+  const float right = x + width;
+  const float bottom = y + height;
+  const std::int64_t firstColumn = static_cast<std::int64_t>(std::floor(x / this->cellSize));
+  const std::int64_t firstRow = static_cast<std::int64_t>(std::floor(y / this->cellSize));
+  const std::int64_t lastColumn = static_cast<std::int64_t>(std::floor(right / this->cellSize));
+  const std::int64_t lastRow = static_cast<std::int64_t>(std::floor(bottom / this->cellSize));
+
+  const std::size_t firstOut = out.size();
+  auto collect = [&](const std::vector<Entry>& entries) {
+    for (const Entry& entry : entries) {
+      if (entry.x >= x && entry.x <= right && entry.y >= y && entry.y <= bottom) {
+        out.push_back(entry.entityId);
+      }
+    }
+  };
+  const double rectCells = static_cast<double>(lastColumn - firstColumn + 1) *
+                           static_cast<double>(lastRow - firstRow + 1);
+  if (rectCells > static_cast<double>(this->cells.size())) {
+    // The rect spans more cells than the grid holds, so walking those is cheaper.
+    for (const auto& [cell, entries] : this->cells) {
+      collect(entries);
+    }
+  } else {
+    for (std::int64_t row = firstRow; row <= lastRow; ++row) {
+      for (std::int64_t column = firstColumn; column <= lastColumn; ++column) {
+        auto cell = this->cells.find(packCell(column, row));
+        if (cell != this->cells.end()) {
+          collect(cell->second);
+        }
+      }
+    }
+  }
+  // Cell order depends on movement history; id order keeps callers deterministic.
+  std::sort(out.begin() + static_cast<std::ptrdiff_t>(firstOut), out.end());
+}
+
+std::int64_t SpatialGrid::cellFor(float x, float y) const {
+  return packCell(static_cast<std::int64_t>(std::floor(x / this->cellSize)),
+                  static_cast<std::int64_t>(std::floor(y / this->cellSize)));
+}
+
+// Swaps the last entry of the cell into the freed slot. Emptied cells are kept, so an entity
+// pacing across a cell border does not allocate.
+void SpatialGrid::removeFromCell(const Location& location) {
+  std::vector<Entry>& entries = this->cells[location.cell];
+  if (location.slot != static_cast<int>(entries.size()) - 1) {
+    entries[location.slot] = entries.back();
+    this->locations[entries[location.slot].entityId].slot = location.slot;
+  }
+  entries.pop_back();
+}
@@ -1,28 +1,35 @@
 #include "ecs/system/graphic_system.h"
-#include "SDL3/SDL.h"
 #include "ecs/component/graphic_component.h"
 #include "ecs/component/transform_component.h"
 #include "ecs/registry.h"
-#include <SDL3/SDL_rect.h>
+
+namespace {
+constexpr float SPRITE_SIZE = 32.0f;
+} // namespace
 
 GraphicSystem::GraphicSystem(Registry& registry, std::bitset<MAX_COMPONENTS> signature)
     : System(registry, signature) {}
 
-void GraphicSystem::render(SDL_Renderer* renderer, const Position& cameraPosition) {
+// A plain rect test per entity. Keeping an index current would need a hook in everything that
+// moves a sprite, for little gain over this one pass.
+void GraphicSystem::collectVisible(float viewX, float viewY, float viewWidth, float viewHeight,
+                                   std::vector<SpriteSnapshot>& out) {
+  // Anchors are top-left corners, so widen the view up and left by one sprite.
+  const float left = viewX - SPRITE_SIZE;
+  const float top = viewY - SPRITE_SIZE;
+  const float right = viewX + viewWidth;
+  const float bottom = viewY + viewHeight;
+  this->lastCullStats = CullStats{};
   for (auto it = this->entityIdsBegin(); it != this->entityIdsEnd(); ++it) {
-    int entityId = *it;
-    // Render each entity based on its components
-    // This is a placeholder for actual rendering logic
-    const GraphicComponent& graphicComponent = registry.getComponent<GraphicComponent>(entityId);
-    const TransformComponent& transformComponent =
-        registry.getComponent<TransformComponent>(entityId);
-    SDL_FRect adjustedRect = {transformComponent.position.x - cameraPosition.x,
-                              transformComponent.position.y - cameraPosition.y, 32, 32};
-    // Use graphicComponent data to render the entity
-    SDL_SetRenderDrawColor(renderer, graphicComponent.color.r, graphicComponent.color.g,
-                           graphicComponent.color.b, graphicComponent.color.a);
-    SDL_RenderFillRect(renderer, &adjustedRect);
-    SDL_SetRenderDrawColor(renderer, 20, 20, 20, 255);
-    SDL_RenderRect(renderer, &adjustedRect);
+    const TransformComponent& transformComponent = registry.getComponent<TransformComponent>(*it);
+    const Position& position = transformComponent.position;
+    if (position.x < left || position.x > right || position.y < top || position.y > bottom) {
+      this->lastCullStats.culled += 1;
+      continue;
+    }
+    this->lastCullStats.visible += 1;
+    const GraphicComponent& graphicComponent = registry.getComponent<GraphicComponent>(*it);
+    out.push_back(SpriteSnapshot{transformComponent.previousPosition, position,
+                                 graphicComponent.color});
   }
 }
@@ -1,6 +1,7 @@
 #include "ecs/system/respawn_system.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <optional>
 
 #include "ecs/component/collision_component.h"
@@ -18,9 +19,10 @@ constexpr float MOB_SPAWN_ANIMATION_SECONDS = 0.6f;
 constexpr int MOB_LEVEL_CAP = 60;
 
 std::optional<Coordinate> firstWalkableInRegion(const Map& map, const Region& region) {
+  const Coordinate& start = map.getStartingPosition();
   for (int y = region.y; y < region.y + region.height; ++y) {
     for (int x = region.x; x < region.x + region.width; ++x) {
-      if (map.isWalkable(x, y)) {
+      if (map.isReachable(x, y, start.x, start.y)) {
         return Coordinate(x, y);
       }
     }
@@ -29,16 +31,15 @@ std::optional<Coordinate> firstWalkableInRegion(const Map& map, const Region& re
 }
 
 std::optional<Position> randomSpawnPosition(const Map& map, const Region& region,
-                                            std::mt19937& rng) {
+                                            Rng& rng) {
   if (region.width <= 0 || region.height <= 0) {
     return std::nullopt;
   }
-  std::uniform_int_distribution<int> distX(region.x, region.x + region.width - 1);
-  std::uniform_int_distribution<int> distY(region.y, region.y + region.height - 1);
+  const Coordinate& start = map.getStartingPosition();
   for (int attempt = 0; attempt < 30; ++attempt) {
-    const int tileX = distX(rng);
-    const int tileY = distY(rng);
-    if (!map.isWalkable(tileX, tileY)) {
+    const int tileX = rng.range(region.x, region.x + region.width - 1);
+    const int tileY = rng.range(region.y, region.y + region.height - 1);
+    if (!map.isReachable(tileX, tileY, start.x, start.y)) {
       continue;
     }
     return Position(tileX * TILE_SIZE, tileY * TILE_SIZE);
@@ -54,17 +55,16 @@ int clampedMobLevel(int level) {
   return std::clamp(level, 1, MOB_LEVEL_CAP);
 }
 
-int rollMobLevel(int minLevel, int maxLevel, std::mt19937& rng) {
+int rollMobLevel(int minLevel, int maxLevel, Rng& rng) {
   const int clampedMin = clampedMobLevel(minLevel);
   const int clampedMax = std::clamp(maxLevel, clampedMin, MOB_LEVEL_CAP);
-  std::uniform_int_distribution<int> dist(clampedMin, clampedMax);
-  return dist(rng);
+  return rng.range(clampedMin, clampedMax);
 }
 
 int spawnMob(Registry& registry, const Position& position, const Region& region,
              std::vector<int>& mobEntityIds, const MobDatabase& mobDatabase,
              const MobArchetype& archetype, int mobLevel) {
-  const MobResolvedStats resolved = mobDatabase.resolveStats(archetype.type, mobLevel);
+  const MobResolvedStats& resolved = mobDatabase.resolveStats(archetype.type, mobLevel);
   int mobEntityId = registry.createEntity();
   registry.registerComponentForEntity<TransformComponent>(
       std::make_unique<TransformComponent>(position), mobEntityId);
@@ -79,12 +79,8 @@ int spawnMob(Registry& registry, const Position& position, const Region& region,
   const int tileX = static_cast<int>(position.x / TILE_SIZE);
   const int tileY = static_cast<int>(position.y / TILE_SIZE);
   registry.registerComponentForEntity<MobComponent>(
-      std::make_unique<MobComponent>(
-          archetype.type, resolved.level, tileX, tileY, region.x, region.y, region.width,
-          region.height, resolved.aggroRange, resolved.leashRange, resolved.speed,
-          resolved.experience, resolved.attackDamage, resolved.attackCooldown, resolved.attackRange,
-          resolved.behavior, resolved.abilityType, resolved.preferredRange, resolved.abilityValue,
-          resolved.abilityCooldown),
+      std::make_unique<MobComponent>(archetype.type, &resolved, tileX, tileY, region.x, region.y,
+                                     region.width, region.height),
       mobEntityId);
   mobEntityIds.push_back(mobEntityId);
   return mobEntityId;
@@ -92,7 +88,7 @@ int spawnMob(Registry& registry, const Position& position, const Region& region,
 
 void resetMob(Registry& registry, int entityId, const Position& position, const Region& region,
               const MobDatabase& mobDatabase, const MobArchetype& archetype, int mobLevel) {
-  const MobResolvedStats resolved = mobDatabase.resolveStats(archetype.type, mobLevel);
+  const MobResolvedStats& resolved = mobDatabase.resolveStats(archetype.type, mobLevel);
   TransformComponent& transform = registry.getComponent<TransformComponent>(entityId);
   GraphicComponent& graphic = registry.getComponent<GraphicComponent>(entityId);
   HealthComponent& health = registry.getComponent<HealthComponent>(entityId);
@@ -109,21 +105,10 @@ void resetMob(Registry& registry, int entityId, const Position& position, const
   mob.regionWidth = region.width;
   mob.regionHeight = region.height;
   mob.type = archetype.type;
-  mob.level = resolved.level;
-  mob.aggroRange = resolved.aggroRange;
-  mob.leashRange = resolved.leashRange;
-  mob.speed = resolved.speed;
-  mob.experience = resolved.experience;
-  mob.attackDamage = resolved.attackDamage;
-  mob.attackCooldown = resolved.attackCooldown;
-  mob.attackRange = resolved.attackRange;
-  mob.behavior = resolved.behavior;
-  mob.abilityType = resolved.abilityType;
-  mob.preferredRange = resolved.preferredRange;
-  mob.abilityValue = resolved.abilityValue;
-  mob.abilityCooldown = resolved.abilityCooldown;
-  mob.attackTimer = 0.0f;
-  mob.abilityTimer = 0.0f;
+  mob.stats = &resolved;
+  mob.attackReadyTick = 0;
+  mob.abilityReadyTick = 0;
+  mob.deferredSeconds = 0.0f;
   health.max = resolved.maxHealth;
   health.current = resolved.maxHealth;
 }
@@ -145,6 +130,7 @@ void RespawnSystem::beginSpawnAnimation(int entityId, GraphicComponent& graphic,
 void RespawnSystem::initialize(const Map& map, Registry& registry, std::vector<int>& mobEntityIds) {
   spawnRegions.clear();
   spawnAnimations.clear();
+  slotsByEntity.clear();
   for (const Region& region : map.getRegions()) {
     if (region.type != RegionType::SpawnRegion) {
       continue;
@@ -153,28 +139,35 @@ void RespawnSystem::initialize(const Map& map, Registry& registry, std::vector<i
     const int maxMobLevel = std::clamp(region.maxLevel, minMobLevel, MOB_LEVEL_CAP);
     SpawnRegionState state{region, minMobLevel, maxMobLevel, std::max(0, region.spawnTier),
                            std::vector<SpawnSlot>(SPAWN_REGION_MOB_COUNT)};
-    for (SpawnSlot& slot : state.slots) {
+    spawnRegions.push_back(std::move(state));
+    const int regionIndex = static_cast<int>(spawnRegions.size()) - 1;
+    SpawnRegionState& spawnRegion = spawnRegions.back();
+    for (int slotIndex = 0; slotIndex < SPAWN_REGION_MOB_COUNT; ++slotIndex) {
+      SpawnSlot& slot = spawnRegion.slots[slotIndex];
       std::optional<Position> spawnPosition = randomSpawnPosition(map, region, rng);
       if (!spawnPosition.has_value()) {
         slot.entityId = -1;
-        slot.respawnTimer = MOB_RESPAWN_SECONDS;
+        scheduleRespawn(SlotRef{regionIndex, slotIndex});
         continue;
       }
-      const int mobLevel = rollMobLevel(state.minMobLevel, state.maxMobLevel, rng);
+      const int mobLevel = rollMobLevel(spawnRegion.minMobLevel, spawnRegion.maxMobLevel, rng);
       const MobArchetype& archetype =
-          this->mobDatabase.randomArchetypeForBand(state.spawnTier, mobLevel, rng);
+          this->mobDatabase.randomArchetypeForBand(spawnRegion.spawnTier, mobLevel, rng);
       slot.entityId = spawnMob(registry, *spawnPosition, region, mobEntityIds, this->mobDatabase,
                                archetype, mobLevel);
-      slot.respawnTimer = 0.0f;
+      slotsByEntity[slot.entityId] = SlotRef{regionIndex, slotIndex};
       GraphicComponent& graphic = registry.getComponent<GraphicComponent>(slot.entityId);
       beginSpawnAnimation(slot.entityId, graphic, MOB_SPAWN_ANIMATION_SECONDS);
     }
-    spawnRegions.push_back(std::move(state));
   }
 }
 
 void RespawnSystem::update(float dt, const Map& map, Registry& registry,
                            std::vector<int>& mobEntityIds) {
+  this->tick += 1;
+  if (dt > 0.0f) {
+    this->tickSeconds = dt;
+  }
   for (auto it = spawnAnimations.begin(); it != spawnAnimations.end();) {
     SpawnAnimation& animation = it->second;
     animation.remaining = std::max(0.0f, animation.remaining - dt);
@@ -182,8 +175,8 @@ void RespawnSystem::update(float dt, const Map& map, Registry& registry,
     const float progress =
         animation.duration > 0.0f ? (1.0f - (animation.remaining / animation.duration)) : 1.0f;
     const float clamped = std::clamp(progress, 0.0f, 1.0f);
-    SDL_Color color = animation.baseColor;
-    color.a = static_cast<Uint8>(static_cast<float>(animation.baseColor.a) * clamped);
+    Color color = animation.baseColor;
+    color.a = static_cast<std::uint8_t>(static_cast<float>(animation.baseColor.a) * clamped);
     graphic.color = color;
     if (animation.remaining <= 0.0f) {
       graphic.color = animation.baseColor;
@@ -193,41 +186,55 @@ void RespawnSystem::update(float dt, const Map& map, Registry& registry,
     }
   }
 
-  for (SpawnRegionState& spawnRegion : spawnRegions) {
-    for (SpawnSlot& slot : spawnRegion.slots) {
-      if (slot.respawnTimer > 0.0f) {
-        slot.respawnTimer = std::max(0.0f, slot.respawnTimer - dt);
-        if (slot.respawnTimer <= 0.0f) {
-          std::optional<Position> spawnPosition = randomSpawnPosition(map, spawnRegion.region, rng);
-          if (!spawnPosition.has_value()) {
-            slot.respawnTimer = MOB_RESPAWN_SECONDS;
-            continue;
-          }
-          const int mobLevel = rollMobLevel(spawnRegion.minMobLevel, spawnRegion.maxMobLevel, rng);
-          const MobArchetype& archetype =
-              this->mobDatabase.randomArchetypeForBand(spawnRegion.spawnTier, mobLevel, rng);
-          if (slot.entityId < 0) {
-            slot.entityId = spawnMob(registry, *spawnPosition, spawnRegion.region, mobEntityIds,
-                                     this->mobDatabase, archetype, mobLevel);
-          } else {
-            resetMob(registry, slot.entityId, *spawnPosition, spawnRegion.region, this->mobDatabase,
-                     archetype, mobLevel);
-          }
-          GraphicComponent& graphic = registry.getComponent<GraphicComponent>(slot.entityId);
-          beginSpawnAnimation(slot.entityId, graphic, MOB_SPAWN_ANIMATION_SECONDS);
-        }
-        continue;
-      }
-      if (slot.entityId < 0) {
-        slot.respawnTimer = MOB_RESPAWN_SECONDS;
-        continue;
-      }
-      const HealthComponent& health = registry.getComponent<HealthComponent>(slot.entityId);
-      if (health.current <= 0) {
-        slot.respawnTimer = MOB_RESPAWN_SECONDS;
-      }
-    }
+  this->dueRespawns.clear();
+  this->respawnedEntityIds.clear();
+  this->respawnTimers.advance(this->tick, this->dueRespawns);
+  for (const SlotRef& slotRef : this->dueRespawns) {
+    respawn(slotRef, map, registry, mobEntityIds);
+  }
+}
+
+void RespawnSystem::onMobKilled(int entityId) {
+  auto it = slotsByEntity.find(entityId);
+  if (it == slotsByEntity.end()) {
+    return;
+  }
+  scheduleRespawn(it->second);
+}
+
+void RespawnSystem::scheduleRespawn(const SlotRef& slotRef) {
+  SpawnSlot& slot = spawnRegions[slotRef.region].slots[slotRef.slot];
+  if (this->respawnTimers.isPending(slot.respawnTimer)) {
+    return;
+  }
+  slot.respawnTimer = this->respawnTimers.schedule(
+      this->tick + ticksForSeconds(MOB_RESPAWN_SECONDS, this->tickSeconds), slotRef);
+}
+
+void RespawnSystem::respawn(const SlotRef& slotRef, const Map& map, Registry& registry,
+                            std::vector<int>& mobEntityIds) {
+  SpawnRegionState& spawnRegion = spawnRegions[slotRef.region];
+  SpawnSlot& slot = spawnRegion.slots[slotRef.slot];
+  slot.respawnTimer = NO_TIMER;
+  std::optional<Position> spawnPosition = randomSpawnPosition(map, spawnRegion.region, rng);
+  if (!spawnPosition.has_value()) {
+    scheduleRespawn(slotRef);
+    return;
+  }
+  const int mobLevel = rollMobLevel(spawnRegion.minMobLevel, spawnRegion.maxMobLevel, rng);
+  const MobArchetype& archetype =
+      this->mobDatabase.randomArchetypeForBand(spawnRegion.spawnTier, mobLevel, rng);
+  if (slot.entityId < 0) {
+    slot.entityId = spawnMob(registry, *spawnPosition, spawnRegion.region, mobEntityIds,
+                             this->mobDatabase, archetype, mobLevel);
+    slotsByEntity[slot.entityId] = slotRef;
+  } else {
+    resetMob(registry, slot.entityId, *spawnPosition, spawnRegion.region, this->mobDatabase,
+             archetype, mobLevel);
   }
+  GraphicComponent& graphic = registry.getComponent<GraphicComponent>(slot.entityId);
+  beginSpawnAnimation(slot.entityId, graphic, MOB_SPAWN_ANIMATION_SECONDS);
+  this->respawnedEntityIds.push_back(slot.entityId);
 }
 
 bool RespawnSystem::isSpawning(int entityId) const {
@@ -3,14 +3,19 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace {
 constexpr int ITEM_LEVEL_CAP = 60;
+constexpr std::uint64_t NAME_SEED_SALT = 0x6E616D65ULL;
 constexpr std::array<ItemSlot, 8> kArmorDropSlots = {
     ItemSlot::Shield, ItemSlot::Chest, ItemSlot::Chest,     ItemSlot::Pants,
     ItemSlot::Pants,  ItemSlot::Boots, ItemSlot::Shoulders, ItemSlot::Cape};
+constexpr std::array<ItemRarity, 3> kDropRarities = {ItemRarity::Common, ItemRarity::Rare,
+                                                     ItemRarity::Epic};
 
 constexpr std::array<const char*, 5> kCommonPrefixes = {"Worn", "Sturdy", "Reliable", "Fine",
                                                         "Traveler's"};
@@ -55,44 +60,33 @@ const char* classLabel(CharacterClass characterClass) {
   return "Adventurer";
 }
 
-ItemRarity rollRarity(std::mt19937& rng, const EquipmentDropGenerationOptions& options) {
-  int commonWeight = std::max(0, options.commonWeight);
-  int rareWeight = std::max(0, options.rareWeight);
-  int epicWeight = std::max(0, options.epicWeight);
-  int totalWeight = commonWeight + rareWeight + epicWeight;
-  if (totalWeight <= 0) {
-    commonWeight = 70;
-    rareWeight = 25;
-    epicWeight = 5;
-    totalWeight = commonWeight + rareWeight + epicWeight;
+// Outcome i of EquipmentDropTable::rarity is kDropRarities[i].
+std::vector<int> rarityWeights(const EquipmentDropGenerationOptions& options) {
+  std::vector<int> weights = {std::max(0, options.commonWeight), std::max(0, options.rareWeight),
+                              std::max(0, options.epicWeight)};
+  if (weights[0] + weights[1] + weights[2] <= 0) {
+    weights = {70, 25, 5};
   }
-  std::uniform_int_distribution<int> dist(1, totalWeight);
-  const int roll = dist(rng);
-  if (roll <= commonWeight) {
-    return ItemRarity::Common;
-  }
-  if (roll <= commonWeight + rareWeight) {
-    return ItemRarity::Rare;
-  }
-  return ItemRarity::Epic;
+  return weights;
 }
 
-ItemSlot rollDropSlot(std::mt19937& rng, const EquipmentDropGenerationOptions& options) {
+// Outcome 0 of EquipmentDropTable::slot is a weapon and outcome i is kArmorDropSlots[i - 1]. The
+// weapon weight is spread over as many shares as there are armor entries, so one sample picks
+// both the category and the armor slot.
+std::vector<int> slotWeights(const EquipmentDropGenerationOptions& options) {
   int weaponWeight = std::max(0, options.weaponWeight);
   int armorWeight = std::max(0, options.armorWeight);
-  int totalWeight = weaponWeight + armorWeight;
-  if (totalWeight <= 0) {
+  if (weaponWeight + armorWeight <= 0) {
     weaponWeight = 35;
     armorWeight = 65;
-    totalWeight = weaponWeight + armorWeight;
   }
-  std::uniform_int_distribution<int> categoryDist(1, totalWeight);
-  const int categoryRoll = categoryDist(rng);
-  if (categoryRoll <= weaponWeight) {
-    return ItemSlot::Weapon;
-  }
-  std::uniform_int_distribution<std::size_t> armorSlotDist(0, kArmorDropSlots.size() - 1);
-  return kArmorDropSlots[armorSlotDist(rng)];
+  std::vector<int> weights(kArmorDropSlots.size() + 1, armorWeight);
+  weights[0] = weaponWeight * static_cast<int>(kArmorDropSlots.size());
+  return weights;
+}
+
+ItemSlot dropSlotForOutcome(std::size_t outcome) {
+  return outcome == 0 ? ItemSlot::Weapon : kArmorDropSlots[outcome - 1];
 }
 
 float rarityMultiplier(ItemRarity rarity) {
@@ -119,25 +113,19 @@ int rarityFlatBonus(ItemRarity rarity, int level) {
   return 0;
 }
 
-float rollVariance(ItemRarity rarity, std::mt19937& rng) {
+float rollVariance(ItemRarity rarity, Rng& rng) {
   switch (rarity) {
-  case ItemRarity::Common: {
-    std::uniform_real_distribution<float> dist(0.88f, 1.12f);
-    return dist(rng);
-  }
-  case ItemRarity::Rare: {
-    std::uniform_real_distribution<float> dist(0.92f, 1.18f);
-    return dist(rng);
-  }
-  case ItemRarity::Epic: {
-    std::uniform_real_distribution<float> dist(0.96f, 1.25f);
-    return dist(rng);
-  }
+  case ItemRarity::Common:
+    return rng.range(0.88f, 1.12f);
+  case ItemRarity::Rare:
+    return rng.range(0.92f, 1.18f);
+  case ItemRarity::Epic:
+    return rng.range(0.96f, 1.25f);
   }
   return 1.0f;
 }
 
-int focusStatIndex(CharacterClass characterClass, std::mt19937& rng) {
+int focusStatIndex(CharacterClass characterClass, Rng& rng) {
   switch (characterClass) {
   case CharacterClass::Warrior:
     return 0;
@@ -150,8 +138,7 @@ int focusStatIndex(CharacterClass characterClass, std::mt19937& rng) {
   case CharacterClass::Any:
     break;
   }
-  std::uniform_int_distribution<int> dist(0, 3);
-  return dist(rng);
+  return rng.range(0, 3);
 }
 
 void addPrimaryStatByIndex(PrimaryStatBonuses& stats, int statIndex, int amount) {
@@ -173,13 +160,12 @@ void addPrimaryStatByIndex(PrimaryStatBonuses& stats, int statIndex, int amount)
   }
 }
 
-WeaponType weaponTypeForClass(CharacterClass characterClass, std::mt19937& rng) {
+WeaponType weaponTypeForClass(CharacterClass characterClass, Rng& rng) {
   switch (characterClass) {
   case CharacterClass::Warrior: {
     const std::array<WeaponType, 3> options = {WeaponType::OneHandedSword, WeaponType::Polearm,
                                                WeaponType::Spear};
-    std::uniform_int_distribution<std::size_t> dist(0, options.size() - 1);
-    return options[dist(rng)];
+    return options[rng.index(options.size())];
   }
   case CharacterClass::Mage:
     return WeaponType::Wand;
@@ -193,20 +179,14 @@ WeaponType weaponTypeForClass(CharacterClass characterClass, std::mt19937& rng)
   return WeaponType::OneHandedSword;
 }
 
-const char* randomPrefix(ItemRarity rarity, std::mt19937& rng) {
+const char* randomPrefix(ItemRarity rarity, Rng& rng) {
   switch (rarity) {
-  case ItemRarity::Common: {
-    std::uniform_int_distribution<std::size_t> dist(0, kCommonPrefixes.size() - 1);
-    return kCommonPrefixes[dist(rng)];
-  }
-  case ItemRarity::Rare: {
-    std::uniform_int_distribution<std::size_t> dist(0, kRarePrefixes.size() - 1);
-    return kRarePrefixes[dist(rng)];
-  }
-  case ItemRarity::Epic: {
-    std::uniform_int_distribution<std::size_t> dist(0, kEpicPrefixes.size() - 1);
-    return kEpicPrefixes[dist(rng)];
-  }
+  case ItemRarity::Common:
+    return kCommonPrefixes[rng.index(kCommonPrefixes.size())];
+  case ItemRarity::Rare:
+    return kRarePrefixes[rng.index(kRarePrefixes.size())];
+  case ItemRarity::Epic:
+    return kEpicPrefixes[rng.index(kEpicPrefixes.size())];
   }
   return "Gear";
 }
@@ -227,176 +207,248 @@ void applyWeaponProjectileDefaults(ItemDef& def) {
     break;
   }
 }
+
+// Stats come from the roll's seed; the name draws from its own stream so it can be built later
+// without replaying the stat rolls.
+ItemDef buildRolledItem(int id, const RolledItem& roll) {
+  Rng rng(roll.seed);
+  const int level = roll.level;
+  const ItemRarity rarity = roll.rarity;
+  const ItemSlot slot = roll.slot;
+  const CharacterClass preferredClass = roll.preferredClass;
+
+  ItemDef generated;
+  generated.id = id;
+  generated.slot = slot;
+  generated.rarity = rarity;
+  generated.requiredLevel = level;
+  generated.allowedClasses = classMaskFor(preferredClass);
+
+  const float multiplier = rarityMultiplier(rarity);
+  const float variance = rollVariance(rarity, rng);
+  const int flatBonus = rarityFlatBonus(rarity, level);
+  if (slot == ItemSlot::Weapon) {
+    generated.weaponType = weaponTypeForClass(preferredClass, rng);
+    applyWeaponProjectileDefaults(generated);
+  } else if (slot == ItemSlot::Shield) {
+    const float baseArmor = 3.0f + (static_cast<float>(level) * 1.4f);
+    generated.stats.armor =
+        std::max(1, static_cast<int>(std::round(baseArmor * multiplier * variance)) + flatBonus);
+  } else {
+    const float baseArmor = 2.0f + (static_cast<float>(level) * 1.1f);
+    generated.stats.armor =
+        std::max(1, static_cast<int>(std::round(baseArmor * multiplier * variance)) + flatBonus);
+  }
+
+  const int focusedStat = focusStatIndex(preferredClass, rng);
+  const float primaryBase =
+      (slot == ItemSlot::Weapon) ? (2.0f + (0.6f * level)) : (1.0f + (0.45f * level));
+  const int primaryBonus =
+      std::max(1, static_cast<int>(std::round(primaryBase * multiplier * variance)));
+  addPrimaryStatByIndex(primaryStatsForItem(generated), focusedStat, primaryBonus);
+
+  if (rarity != ItemRarity::Common) {
+    std::array<int, 3> candidateStats{};
+    std::size_t candidateCount = 0;
+    for (int statIndex = 0; statIndex < 4; ++statIndex) {
+      if (statIndex != focusedStat) {
+        candidateStats[candidateCount++] = statIndex;
+      }
+    }
+    for (std::size_t i = candidateCount; i > 1; --i) {
+      std::swap(candidateStats[i - 1], candidateStats[rng.index(i)]);
+    }
+
+    const int extraCount = (rarity == ItemRarity::Rare) ? 1 : 2;
+    for (int i = 0; i < extraCount; ++i) {
+      const int statIndex = candidateStats[static_cast<std::size_t>(i)];
+      const int extraBonus =
+          std::max(1, static_cast<int>(std::round((0.15f * level) * multiplier)) + flatBonus);
+      addPrimaryStatByIndex(primaryStatsForItem(generated), statIndex, extraBonus);
+    }
+  }
+
+  const PrimaryStatBonuses& primary = primaryStatsForItem(generated);
+  const int primaryTotal = primary.strength + primary.dexterity + primary.intellect + primary.luck;
+  generated.price = std::max(10, (level * 3) + (flatBonus * 5) + (armorForItem(generated) * 2) +
+                                     (primaryBonus * 3) + (primaryTotal * 2));
+  return generated;
+}
+
+std::string rolledItemName(const RolledItem& roll) {
+  Rng nameRng(roll.seed ^ NAME_SEED_SALT);
+  return std::string(randomPrefix(roll.rarity, nameRng)) + " " + classLabel(roll.preferredClass) +
+         " " + slotName(roll.slot) + " (" + itemRarityName(roll.rarity) + " L" +
+         std::to_string(roll.level) + ")";
+}
 } // namespace
 
 ItemDatabase::ItemDatabase() {
   ItemDef basicSword;
   basicSword.id = 1;
-  basicSword.name = "Basic Sword";
   basicSword.slot = ItemSlot::Weapon;
   basicSword.requiredLevel = 1;
-  basicSword.allowedClasses = {CharacterClass::Any};
+  basicSword.allowedClasses = classMaskFor(CharacterClass::Any);
   basicSword.weaponType = WeaponType::OneHandedSword;
-  basicSword.weaponStats.primary.strength = 2;
+  basicSword.stats.primary.strength = 2;
   basicSword.price = 20;
-  addItem(basicSword);
+  addItem(basicSword, "Basic Sword");
 
   ItemDef basicSpear;
   basicSpear.id = 5;
-  basicSpear.name = "Basic Spear";
   basicSpear.slot = ItemSlot::Weapon;
   basicSpear.requiredLevel = 1;
-  basicSpear.allowedClasses = {CharacterClass::Any};
+  basicSpear.allowedClasses = classMaskFor(CharacterClass::Any);
   basicSpear.weaponType = WeaponType::Spear;
-  basicSpear.weaponStats.primary.strength = 3;
+  basicSpear.stats.primary.strength = 3;
   basicSpear.price = 24;
-  addItem(basicSpear);
+  addItem(basicSpear, "Basic Spear");
 
   ItemDef basicBow;
   basicBow.id = 6;
-  basicBow.name = "Basic Bow";
   basicBow.slot = ItemSlot::Weapon;
   basicBow.requiredLevel = 1;
-  basicBow.allowedClasses = {CharacterClass::Archer};
+  basicBow.allowedClasses = classMaskFor(CharacterClass::Archer);
   basicBow.weaponType = WeaponType::Bow;
-  basicBow.weaponStats.primary.dexterity = 2;
+  basicBow.stats.primary.dexterity = 2;
   basicBow.projectile.speed = 220.0f;
   basicBow.projectile.radius = 9.0f;
   basicBow.projectile.trailLength = 22.0f;
   basicBow.price = 30;
-  addItem(basicBow);
+  addItem(basicBow, "Basic Bow");
 
   ItemDef basicWand;
   basicWand.id = 7;
-  basicWand.name = "Basic Wand";
   basicWand.slot = ItemSlot::Weapon;
   basicWand.requiredLevel = 1;
-  basicWand.allowedClasses = {CharacterClass::Mage};
+  basicWand.allowedClasses = classMaskFor(CharacterClass::Mage);
   basicWand.weaponType = WeaponType::Wand;
-  basicWand.weaponStats.primary.intellect = 2;
+  basicWand.stats.primary.intellect = 2;
   basicWand.projectile.speed = 200.0f;
   basicWand.projectile.radius = 10.0f;
   basicWand.projectile.trailLength = 26.0f;
   basicWand.price = 28;
-  addItem(basicWand);
+  addItem(basicWand, "Basic Wand");
 
   ItemDef basicDagger;
   basicDagger.id = 8;
-  basicDagger.name = "Basic Dagger";
   basicDagger.slot = ItemSlot::Weapon;
   basicDagger.requiredLevel = 1;
-  basicDagger.allowedClasses = {CharacterClass::Rogue};
+  basicDagger.allowedClasses = classMaskFor(CharacterClass::Rogue);
   basicDagger.weaponType = WeaponType::Dagger;
-  basicDagger.weaponStats.primary.luck = 2;
+  basicDagger.stats.primary.luck = 2;
   basicDagger.price = 18;
-  addItem(basicDagger);
+  addItem(basicDagger, "Basic Dagger");
 
   ItemDef basicShield;
   basicShield.id = 2;
-  basicShield.name = "Basic Shield";
   basicShield.slot = ItemSlot::Shield;
   basicShield.requiredLevel = 1;
-  basicShield.allowedClasses = {CharacterClass::Any};
-  basicShield.armorStats.armor = 3;
+  basicShield.allowedClasses = classMaskFor(CharacterClass::Any);
+  basicShield.stats.armor = 3;
   basicShield.price = 16;
-  addItem(basicShield);
+  addItem(basicShield, "Basic Shield");
 
   ItemDef basicBoots;
   basicBoots.id = 3;
-  basicBoots.name = "Basic Boots";
   basicBoots.slot = ItemSlot::Boots;
   basicBoots.requiredLevel = 1;
-  basicBoots.allowedClasses = {CharacterClass::Any};
-  basicBoots.armorStats.armor = 1;
+  basicBoots.allowedClasses = classMaskFor(CharacterClass::Any);
+  basicBoots.stats.armor = 1;
   basicBoots.price = 12;
-  addItem(basicBoots);
+  addItem(basicBoots, "Basic Boots");
 
   ItemDef basicChest;
   basicChest.id = 4;
-  basicChest.name = "Basic Tunic";
   basicChest.slot = ItemSlot::Chest;
   basicChest.requiredLevel = 1;
-  basicChest.allowedClasses = {CharacterClass::Any};
-  basicChest.armorStats.armor = 2;
+  basicChest.allowedClasses = classMaskFor(CharacterClass::Any);
+  basicChest.stats.armor = 2;
   basicChest.price = 22;
-  addItem(basicChest);
+  addItem(basicChest, "Basic Tunic");
 }
 
+EquipmentDropTable::EquipmentDropTable(const EquipmentDropGenerationOptions& options)
+    : rarity(rarityWeights(options)), slot(slotWeights(options)) {}
+
 const ItemDef* ItemDatabase::getItem(int id) const {
-  auto it = items.find(id);
-  if (it == items.end()) {
+  if (id >= FIRST_GENERATED_ITEM_ID) {
+    const GeneratedItem* generated = findGenerated(id);
+    return generated ? &generated->def : nullptr;
+  }
+  if (id <= 0 || static_cast<std::size_t>(id) >= this->items.size()) {
     return nullptr;
   }
-  return &it->second;
+  const ItemDef& def = this->items[static_cast<std::size_t>(id)];
+  return def.id == id ? &def : nullptr;
 }
 
-void ItemDatabase::addItem(ItemDef def) {
-  items.emplace(def.id, std::move(def));
+const RolledItem* ItemDatabase::getRolledItem(int id) const {
+  const GeneratedItem* generated = findGenerated(id);
+  return generated ? &generated->roll : nullptr;
 }
 
-int ItemDatabase::generateEquipmentDrop(int targetLevel, CharacterClass preferredClass,
-                                        std::mt19937& rng,
-                                        const EquipmentDropGenerationOptions& options) {
-  const int level = std::clamp(targetLevel, 1, ITEM_LEVEL_CAP);
-  const ItemRarity rarity = rollRarity(rng, options);
-  const ItemSlot slot = rollDropSlot(rng, options);
-
-  ItemDef generated;
-  generated.id = this->nextGeneratedItemId++;
-  generated.slot = slot;
-  generated.rarity = rarity;
-  generated.requiredLevel = level;
-  generated.allowedClasses = (preferredClass == CharacterClass::Any)
-                                 ? std::unordered_set<CharacterClass>{CharacterClass::Any}
-                                 : std::unordered_set<CharacterClass>{preferredClass};
-
-  const float multiplier = rarityMultiplier(rarity);
-  const float variance = rollVariance(rarity, rng);
-  const int flatBonus = rarityFlatBonus(rarity, level);
-  if (slot == ItemSlot::Weapon) {
-    generated.weaponType = weaponTypeForClass(preferredClass, rng);
-    applyWeaponProjectileDefaults(generated);
-  } else if (slot == ItemSlot::Shield) {
-    const float baseArmor = 3.0f + (static_cast<float>(level) * 1.4f);
-    generated.armorStats.armor =
-        std::max(1, static_cast<int>(std::round(baseArmor * multiplier * variance)) + flatBonus);
-  } else {
-    const float baseArmor = 2.0f + (static_cast<float>(level) * 1.1f);
-    generated.armorStats.armor =
-        std::max(1, static_cast<int>(std::round(baseArmor * multiplier * variance)) + flatBonus);
+std::string ItemDatabase::itemName(const ItemDef& def) const {
+  if (def.id >= FIRST_GENERATED_ITEM_ID) {
+    const GeneratedItem* generated = findGenerated(def.id);
+    return generated ? rolledItemName(generated->roll) : std::string();
   }
+  return this->namePool[def.nameId];
+}
 
-  const int focusedStat = focusStatIndex(preferredClass, rng);
-  const float primaryBase =
-      (slot == ItemSlot::Weapon) ? (2.0f + (0.6f * level)) : (1.0f + (0.45f * level));
-  const int primaryBonus =
-      std::max(1, static_cast<int>(std::round(primaryBase * multiplier * variance)));
-  addPrimaryStatByIndex(primaryStatsForItem(generated), focusedStat, primaryBonus);
+const ItemDatabase::GeneratedItem* ItemDatabase::findGenerated(int id) const {
+  auto it = std::lower_bound(
+      this->rolledItems.begin(), this->rolledItems.end(), id,
+      [](const GeneratedItem& item, int itemId) { return item.def.id < itemId; });
+  return (it != this->rolledItems.end() && it->def.id == id) ? &*it : nullptr;
+}
 
-  if (rarity != ItemRarity::Common) {
-    std::vector<int> candidateStats = {0, 1, 2, 3};
-    candidateStats.erase(std::remove(candidateStats.begin(), candidateStats.end(), focusedStat),
-                         candidateStats.end());
-    std::shuffle(candidateStats.begin(), candidateStats.end(), rng);
+void ItemDatabase::addItem(ItemDef def, std::string_view name) {
+  def.nameId = internName(name);
+  const std::size_t index = static_cast<std::size_t>(def.id);
+  if (index >= this->items.size()) {
+    this->items.resize(index + 1);
+  }
+  this->items[index] = def;
+}
 
-    const int extraCount = (rarity == ItemRarity::Rare) ? 1 : 2;
-    for (int i = 0; i < extraCount; ++i) {
-      const int statIndex = candidateStats[static_cast<std::size_t>(i)];
-      const int extraBonus =
-          std::max(1, static_cast<int>(std::round((0.15f * level) * multiplier)) + flatBonus);
-      addPrimaryStatByIndex(primaryStatsForItem(generated), statIndex, extraBonus);
-    }
+std::uint16_t ItemDatabase::internName(std::string_view name) {
+  auto it = std::find(this->namePool.begin(), this->namePool.end(), name);
+  if (it != this->namePool.end()) {
+    return static_cast<std::uint16_t>(it - this->namePool.begin());
   }
+  this->namePool.emplace_back(name);
+  return static_cast<std::uint16_t>(this->namePool.size() - 1);
+}
 
-  const std::string rarityToken = itemRarityName(rarity);
-  const std::string classToken = classLabel(preferredClass);
-  const PrimaryStatBonuses& primary = primaryStatsForItem(generated);
-  const int primaryTotal = primary.strength + primary.dexterity + primary.intellect + primary.luck;
-  generated.name = std::string(randomPrefix(rarity, rng)) + " " + classToken + " " +
-                   slotName(slot) + " (" + rarityToken + " L" + std::to_string(level) + ")";
-  generated.price = std::max(10, (level * 3) + (flatBonus * 5) + (armorForItem(generated) * 2) +
-                                     (primaryBonus * 3) + (primaryTotal * 2));
+int ItemDatabase::generateEquipmentDrop(int targetLevel, CharacterClass preferredClass,
+                                        Rng& rng,
+                                        const EquipmentDropGenerationOptions& options) {
+  return generateEquipmentDrop(targetLevel, preferredClass, rng, EquipmentDropTable(options));
+}
+
+int ItemDatabase::generateEquipmentDrop(int targetLevel, CharacterClass preferredClass,
+                                        Rng& rng, const EquipmentDropTable& table) {
+  RolledItem roll;
+  roll.level = static_cast<std::uint16_t>(std::clamp(targetLevel, 1, ITEM_LEVEL_CAP));
+  roll.rarity = kDropRarities[table.rarity.sample(rng)];
+  roll.slot = dropSlotForOutcome(table.slot.sample(rng));
+  roll.preferredClass = preferredClass;
+  roll.seed = rng();
+  const int id = this->nextGeneratedItemId++;
+  this->rolledItems.push_back(GeneratedItem{roll, buildRolledItem(id, roll)});
+  this->version += 1;
+  return id;
+}
 
-  addItem(generated);
-  return generated.id;
+void ItemDatabase::releaseUnreferenced(std::vector<int>& referencedIds) {
+  std::sort(referencedIds.begin(), referencedIds.end());
+  this->rolledItems.erase(
+      std::remove_if(this->rolledItems.begin(), this->rolledItems.end(),
+                     [&referencedIds](const GeneratedItem& item) {
+                       return !std::binary_search(referencedIds.begin(), referencedIds.end(),
+                                                  item.def.id);
+                     }),
+      this->rolledItems.end());
+  this->version += 1;
 }
@@ -1,20 +1,46 @@
 #include "mobs/mob_database.h"
 
 #include <algorithm>
+#include <map>
 
 namespace {
 constexpr int MOB_LEVEL_CAP = 60;
+const MobResolvedStats UNKNOWN_STATS{};
 
 int clampedWeight(int value) {
   return std::max(0, value);
 }
+
+MobResolvedStats computeStats(const MobArchetype& archetype, int level) {
+  const int levelOffset = level - 1;
+  MobResolvedStats resolved;
+  resolved.level = level;
+  resolved.color = archetype.color;
+  resolved.maxHealth = std::max(1, archetype.baseHealth + (levelOffset * archetype.healthPerLevel));
+  resolved.experience =
+      std::max(1, archetype.baseExperience + (levelOffset * archetype.experiencePerLevel));
+  resolved.attackDamage =
+      std::max(1, archetype.baseAttackDamage + (levelOffset * archetype.attackDamagePerLevel));
+  resolved.attackCooldown = archetype.attackCooldown;
+  resolved.attackRange = archetype.attackRange;
+  resolved.speed = archetype.speed;
+  resolved.aggroRange = archetype.aggroRange;
+  resolved.leashRange = archetype.leashRange;
+  resolved.behavior = archetype.behavior;
+  resolved.abilityType = archetype.abilityType;
+  resolved.preferredRange =
+      (archetype.preferredRange > 0.0f) ? archetype.preferredRange : archetype.attackRange;
+  resolved.abilityValue = archetype.abilityValue;
+  resolved.abilityCooldown = archetype.abilityCooldown;
+  return resolved;
+}
 } // namespace
 
 MobDatabase::MobDatabase() {
   this->archetypes = {
       {MobType::Goblin,
        "Goblin",
-       SDL_Color{40, 200, 80, 255},
+       Color{40, 200, 80, 255},
        20,
        5,
        20,
@@ -34,7 +60,7 @@ MobDatabase::MobDatabase() {
        MobLootTable{25, EquipmentDropGenerationOptions{30, 70, 80, 18, 2}}},
       {MobType::GoblinArcher,
        "Goblin Archer",
-       SDL_Color{60, 160, 220, 255},
+       Color{60, 160, 220, 255},
        16,
        4,
        25,
@@ -54,7 +80,7 @@ MobDatabase::MobDatabase() {
        MobLootTable{20, EquipmentDropGenerationOptions{45, 55, 65, 30, 5}}},
       {MobType::GoblinBrute,
        "Goblin Brute",
-       SDL_Color{120, 180, 60, 255},
+       Color{120, 180, 60, 255},
        30,
        7,
        35,
@@ -74,7 +100,7 @@ MobDatabase::MobDatabase() {
        MobLootTable{15, EquipmentDropGenerationOptions{50, 50, 55, 33, 12}}},
       {MobType::Skeleton,
        "Skeleton",
-       SDL_Color{206, 206, 198, 255},
+       Color{206, 206, 198, 255},
        24,
        6,
        24,
@@ -94,7 +120,7 @@ MobDatabase::MobDatabase() {
        MobLootTable{22, EquipmentDropGenerationOptions{35, 65, 72, 24, 4}}},
       {MobType::SkeletonArcher,
        "Skeleton Archer",
-       SDL_Color{170, 180, 196, 255},
+       Color{170, 180, 196, 255},
        20,
        5,
        27,
@@ -114,7 +140,7 @@ MobDatabase::MobDatabase() {
        MobLootTable{18, EquipmentDropGenerationOptions{50, 50, 60, 32, 8}}},
       {MobType::Necromancer,
        "Necromancer",
-       SDL_Color{125, 110, 180, 255},
+       Color{125, 110, 180, 255},
        18,
        4,
        34,
@@ -134,7 +160,7 @@ MobDatabase::MobDatabase() {
        MobLootTable{14, EquipmentDropGenerationOptions{45, 55, 45, 37, 18}}},
       {MobType::Wolf,
        "Wolf",
-       SDL_Color{130, 130, 130, 255},
+       Color{130, 130, 130, 255},
        18,
        5,
        22,
@@ -154,7 +180,7 @@ MobDatabase::MobDatabase() {
        MobLootTable{28, EquipmentDropGenerationOptions{20, 80, 82, 16, 2}}},
       {MobType::DireWolf,
        "Dire Wolf",
-       SDL_Color{90, 95, 105, 255},
+       Color{90, 95, 105, 255},
        28,
        6,
        30,
@@ -174,7 +200,7 @@ MobDatabase::MobDatabase() {
        MobLootTable{20, EquipmentDropGenerationOptions{25, 75, 75, 22, 3}}},
       {MobType::Bandit,
        "Bandit",
-       SDL_Color{186, 152, 110, 255},
+       Color{186, 152, 110, 255},
        26,
        6,
        32,
@@ -194,7 +220,7 @@ MobDatabase::MobDatabase() {
        MobLootTable{20, EquipmentDropGenerationOptions{40, 60, 70, 25, 5}}},
       {MobType::BanditArcher,
        "Bandit Archer",
-       SDL_Color{168, 130, 90, 255},
+       Color{168, 130, 90, 255},
        22,
        5,
        34,
@@ -214,7 +240,7 @@ MobDatabase::MobDatabase() {
        MobLootTable{18, EquipmentDropGenerationOptions{55, 45, 60, 32, 8}}},
       {MobType::BanditBruiser,
        "Bandit Bruiser",
-       SDL_Color{148, 110, 86, 255},
+       Color{148, 110, 86, 255},
        36,
        8,
        40,
@@ -234,7 +260,7 @@ MobDatabase::MobDatabase() {
        MobLootTable{12, EquipmentDropGenerationOptions{45, 55, 50, 35, 15}}},
       {MobType::Slime,
        "Slime",
-       SDL_Color{96, 212, 186, 255},
+       Color{96, 212, 186, 255},
        34,
        9,
        38,
@@ -254,7 +280,7 @@ MobDatabase::MobDatabase() {
        MobLootTable{35, EquipmentDropGenerationOptions{10, 90, 88, 11, 1}}},
       {MobType::ArcaneWisp,
        "Arcane Wisp",
-       SDL_Color{130, 182, 255, 255},
+       Color{130, 182, 255, 255},
        24,
        5,
        42,
@@ -274,7 +300,7 @@ MobDatabase::MobDatabase() {
        MobLootTable{24, EquipmentDropGenerationOptions{50, 50, 58, 33, 9}}},
       {MobType::ArcaneSentinel,
        "Arcane Sentinel",
-       SDL_Color{120, 132, 220, 255},
+       Color{120, 132, 220, 255},
        42,
        10,
        48,
@@ -294,7 +320,7 @@ MobDatabase::MobDatabase() {
        MobLootTable{14, EquipmentDropGenerationOptions{40, 60, 48, 35, 17}}},
       {MobType::Ogre,
        "Ogre",
-       SDL_Color{90, 170, 120, 255},
+       Color{90, 170, 120, 255},
        52,
        12,
        56,
@@ -399,97 +425,129 @@ MobDatabase::MobDatabase() {
       break;
     }
   }
+  buildStatTable();
+  buildSamplingTables();
 }
 
-const MobArchetype* MobDatabase::get(MobType type) const {
-  for (const MobArchetype& archetype : this->archetypes) {
-    if (archetype.type == type) {
-      return &archetype;
+void MobDatabase::buildStatTable() {
+  this->indexByType.fill(-1);
+  this->statTable.clear();
+  this->statTable.reserve(this->archetypes.size() * MOB_LEVEL_CAP);
+  for (std::size_t i = 0; i < this->archetypes.size(); ++i) {
+    const MobArchetype& archetype = this->archetypes[i];
+    const std::size_t typeIndex = static_cast<std::size_t>(archetype.type);
+    // The first archetype for a type wins, as the old linear lookup did.
+    if (typeIndex < this->indexByType.size() && this->indexByType[typeIndex] < 0) {
+      this->indexByType[typeIndex] = static_cast<int>(i);
+    }
+    for (int level = 1; level <= MOB_LEVEL_CAP; ++level) {
+      this->statTable.push_back(computeStats(archetype, level));
     }
   }
-  return nullptr;
 }
 
-const MobArchetype& MobDatabase::randomArchetype(std::mt19937& rng) const {
-  std::uniform_int_distribution<std::size_t> dist(0, this->archetypes.size() - 1);
-  return this->archetypes[dist(rng)];
+int MobDatabase::archetypeIndex(MobType type) const {
+  const std::size_t typeIndex = static_cast<std::size_t>(type);
+  return typeIndex < this->indexByType.size() ? this->indexByType[typeIndex] : -1;
 }
 
-const MobArchetype& MobDatabase::randomArchetypeForBand(int spawnTier, int level,
-                                                        std::mt19937& rng) const {
-  std::vector<const MobArchetype*> candidates;
-  std::vector<int> weights;
-  const int clampedLevel = std::clamp(level, 1, MOB_LEVEL_CAP);
+void MobDatabase::buildSamplingTables() {
+  this->lootTables.clear();
+  this->lootTables.reserve(this->archetypes.size());
   for (const MobArchetype& archetype : this->archetypes) {
-    if (spawnTier < archetype.minSpawnTier || spawnTier > archetype.maxSpawnTier) {
-      continue;
-    }
-    if (clampedLevel < archetype.minSpawnLevel || clampedLevel > archetype.maxSpawnLevel) {
-      continue;
+    const MobLootTable& table = archetype.lootTable;
+    const EquipmentDropGenerationOptions& drop = table.equipmentDropOptions;
+    const int rarityWeight = clampedWeight(drop.commonWeight) + clampedWeight(drop.rareWeight) +
+                             clampedWeight(drop.epicWeight);
+    // A table with no rarity weight never drops, whatever its no-drop weight.
+    const int dropWeight = rarityWeight;
+    const int noDropWeight = rarityWeight > 0 ? clampedWeight(table.noDropWeight) : 1;
+    this->lootTables.push_back(
+        CompiledLootTable{AliasTable({noDropWeight, dropWeight}), EquipmentDropTable(drop)});
+  }
+
+  this->spawnTierCount = 0;
+  for (const MobArchetype& archetype : this->archetypes) {
+    this->spawnTierCount = std::max(this->spawnTierCount, archetype.maxSpawnTier + 1);
+  }
+  this->spawnBands.clear();
+  this->bandByTierLevel.assign(static_cast<std::size_t>(this->spawnTierCount) * MOB_LEVEL_CAP, -1);
+  // Most tier and level pairs share a roster, so identical rosters share one band.
+  std::map<std::vector<std::uint32_t>, int> bandByRoster;
+  for (int tier = 0; tier < this->spawnTierCount; ++tier) {
+    for (int level = 1; level <= MOB_LEVEL_CAP; ++level) {
+      std::vector<std::uint32_t> roster;
+      for (std::size_t i = 0; i < this->archetypes.size(); ++i) {
+        const MobArchetype& archetype = this->archetypes[i];
+        if (tier < archetype.minSpawnTier || tier > archetype.maxSpawnTier) {
+          continue;
+        }
+        if (level < archetype.minSpawnLevel || level > archetype.maxSpawnLevel) {
+          continue;
+        }
+        roster.push_back(static_cast<std::uint32_t>(i));
+      }
+      if (roster.empty()) {
+        continue;
+      }
+      auto [it, inserted] =
+          bandByRoster.emplace(roster, static_cast<int>(this->spawnBands.size()));
+      if (inserted) {
+        std::vector<int> weights;
+        weights.reserve(roster.size());
+        for (std::uint32_t index : roster) {
+          weights.push_back(std::max(1, this->archetypes[index].spawnWeight));
+        }
+        this->spawnBands.push_back(SpawnBand{std::move(roster), AliasTable(weights)});
+      }
+      this->bandByTierLevel[(static_cast<std::size_t>(tier) * MOB_LEVEL_CAP) + (level - 1)] =
+          it->second;
     }
-    candidates.push_back(&archetype);
-    weights.push_back(std::max(1, archetype.spawnWeight));
   }
-  if (candidates.empty()) {
+}
+
+const MobArchetype* MobDatabase::get(MobType type) const {
+  const int index = archetypeIndex(type);
+  return index < 0 ? nullptr : &this->archetypes[static_cast<std::size_t>(index)];
+}
+
+const MobArchetype& MobDatabase::randomArchetype(Rng& rng) const {
+  return this->archetypes[rng.index(this->archetypes.size())];
+}
+
+const MobArchetype& MobDatabase::randomArchetypeForBand(int spawnTier, int level,
+                                                        Rng& rng) const {
+  if (spawnTier < 0 || spawnTier >= this->spawnTierCount) {
     return randomArchetype(rng);
   }
-  std::discrete_distribution<std::size_t> dist(weights.begin(), weights.end());
-  return *candidates[dist(rng)];
+  const int clampedLevel = std::clamp(level, 1, MOB_LEVEL_CAP);
+  const int bandIndex =
+      this->bandByTierLevel[(static_cast<std::size_t>(spawnTier) * MOB_LEVEL_CAP) +
+                            (clampedLevel - 1)];
+  if (bandIndex < 0) {
+    return randomArchetype(rng);
+  }
+  const SpawnBand& band = this->spawnBands[static_cast<std::size_t>(bandIndex)];
+  return this->archetypes[band.archetypeIndices[band.weights.sample(rng)]];
 }
 
-MobResolvedStats MobDatabase::resolveStats(MobType type, int level) const {
-  const MobArchetype* archetype = get(type);
-  if (!archetype) {
-    return MobResolvedStats{};
+const MobResolvedStats& MobDatabase::resolveStats(MobType type, int level) const {
+  const int index = archetypeIndex(type);
+  if (index < 0) {
+    return UNKNOWN_STATS;
   }
   const int clampedLevel = std::clamp(level, 1, MOB_LEVEL_CAP);
-  const int levelOffset = clampedLevel - 1;
-  MobResolvedStats resolved;
-  resolved.level = clampedLevel;
-  resolved.color = archetype->color;
-  resolved.maxHealth =
-      std::max(1, archetype->baseHealth + (levelOffset * archetype->healthPerLevel));
-  resolved.experience =
-      std::max(1, archetype->baseExperience + (levelOffset * archetype->experiencePerLevel));
-  resolved.attackDamage =
-      std::max(1, archetype->baseAttackDamage + (levelOffset * archetype->attackDamagePerLevel));
-  resolved.attackCooldown = archetype->attackCooldown;
-  resolved.attackRange = archetype->attackRange;
-  resolved.speed = archetype->speed;
-  resolved.aggroRange = archetype->aggroRange;
-  resolved.leashRange = archetype->leashRange;
-  resolved.behavior = archetype->behavior;
-  resolved.abilityType = archetype->abilityType;
-  resolved.preferredRange =
-      (archetype->preferredRange > 0.0f) ? archetype->preferredRange : archetype->attackRange;
-  resolved.abilityValue = archetype->abilityValue;
-  resolved.abilityCooldown = archetype->abilityCooldown;
-  return resolved;
+  return this->statTable[(static_cast<std::size_t>(index) * MOB_LEVEL_CAP) + (clampedLevel - 1)];
 }
 
-bool MobDatabase::rollEquipmentDrop(MobType type, std::mt19937& rng,
-                                    EquipmentDropGenerationOptions& outOptions) const {
-  const MobArchetype* archetype = get(type);
-  if (!archetype) {
-    return false;
-  }
-  const MobLootTable& table = archetype->lootTable;
-  const EquipmentDropGenerationOptions& drop = table.equipmentDropOptions;
-  const int rarityWeight = clampedWeight(drop.commonWeight) + clampedWeight(drop.rareWeight) +
-                           clampedWeight(drop.epicWeight);
-  if (rarityWeight <= 0) {
-    return false;
-  }
-  const int noDropWeight = clampedWeight(table.noDropWeight);
-  const int totalWeight = noDropWeight + rarityWeight;
-  if (totalWeight <= 0) {
-    return false;
+const EquipmentDropTable* MobDatabase::rollEquipmentDrop(MobType type, Rng& rng) const {
+  const int index = archetypeIndex(type);
+  if (index < 0) {
+    return nullptr;
   }
-  std::uniform_int_distribution<int> dist(1, totalWeight);
-  const int roll = dist(rng);
-  if (roll <= noDropWeight) {
-    return false;
+  const CompiledLootTable& table = this->lootTables[static_cast<std::size_t>(index)];
+  if (table.dropRoll.sample(rng) == 0) {
+    return nullptr;
   }
-  outOptions = drop;
-  return true;
+  return &table.equipment;
 }
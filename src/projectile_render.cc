@@ -0,0 +1,45 @@
+#include "projectile_render.h"
+
+#include "ecs/component/projectile_component.h"
+#include "ecs/component/transform_component.h"
+#include "ui/render_utils.h"
+#include <cmath>
+
+void snapshotProjectiles(Registry& registry, const std::vector<int>& projectileEntityIds,
+                         std::vector<ProjectileSnapshot>& out) {
+  for (int projectileId : projectileEntityIds) {
+    const TransformComponent& projectileTransform =
+        registry.getComponent<TransformComponent>(projectileId);
+    const ProjectileComponent& projectile =
+        registry.getComponent<ProjectileComponent>(projectileId);
+    out.push_back(ProjectileSnapshot{projectileTransform.previousPosition,
+                                     projectileTransform.position, projectile.radius,
+                                     projectile.trailLength, projectile.velocityX,
+                                     projectile.velocityY, projectile.color});
+  }
+}
+
+void renderProjectiles(RenderBatch& batch, const Position& cameraPosition,
+                       const std::vector<ProjectileSnapshot>& projectiles, float alpha) {
+  for (const ProjectileSnapshot& projectile : projectiles) {
+    const Position position = interpolatePosition(projectile.previous, projectile.current, alpha);
+    const float size = projectile.radius * 2.0f;
+    const float screenX = position.x - cameraPosition.x;
+    const float screenY = position.y - cameraPosition.y;
+    SDL_FRect projectileRect = {screenX - projectile.radius, screenY - projectile.radius, size,
+                                size};
+    batch.fillRect(projectileRect, toSdlColor(projectile.color));
+    if (projectile.trailLength > 0.0f) {
+      const float speed = std::sqrt((projectile.velocityX * projectile.velocityX) +
+                                    (projectile.velocityY * projectile.velocityY));
+      if (speed > 0.001f) {
+        const float nx = projectile.velocityX / speed;
+        const float ny = projectile.velocityY / speed;
+        batch.line(screenX - (nx * projectile.trailLength), screenY - (ny * projectile.trailLength),
+                   screenX, screenY, SDL_Color{255, 255, 255, 200});
+      }
+    }
+    batch.circle(screenX, screenY, projectile.radius + 2.0f, SDL_Color{255, 255, 255, 200});
+    batch.outlineRect(projectileRect, SDL_Color{30, 30, 30, 200});
+  }
+}
@@ -0,0 +1,237 @@
+#include "simulation/game_rules.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+int primaryStatForClass(const EffectivePrimaryStats& effective, CharacterClass characterClass) {
+  switch (characterClass) {
+  case CharacterClass::Warrior:
+    return effective.strength;
+  case CharacterClass::Archer:
+    return effective.dexterity;
+  case CharacterClass::Mage:
+    return effective.intellect;
+  case CharacterClass::Rogue:
+    return effective.luck;
+  case CharacterClass::Any:
+    break;
+  }
+  return std::max({effective.strength, effective.dexterity, effective.intellect, effective.luck});
+}
+
+void refreshSecondaryStats(StatsComponent& stats, const EffectivePrimaryStats& effectiveStats) {
+  stats.critChanceBonus =
+      std::clamp(0.0025f * static_cast<float>(effectiveStats.luck), 0.0f, 0.35f);
+  stats.critDamageBonus = std::clamp(0.01f * static_cast<float>(effectiveStats.luck), 0.0f, 1.2f);
+  stats.accuracy = std::clamp(0.72f + (0.012f * static_cast<float>(effectiveStats.dexterity)) +
+                                  (0.0015f * static_cast<float>(effectiveStats.luck)),
+                              0.72f, 0.99f);
+  stats.dodge = std::clamp((0.0025f * static_cast<float>(effectiveStats.dexterity)) +
+                               (0.001f * static_cast<float>(effectiveStats.luck)),
+                           0.0f, 0.35f);
+  stats.parry = std::clamp((0.0015f * static_cast<float>(effectiveStats.strength)) +
+                               (0.001f * static_cast<float>(effectiveStats.dexterity)),
+                           0.0f, 0.25f);
+}
+} // namespace
+
+const char* className(CharacterClass characterClass) {
+  switch (characterClass) {
+  case CharacterClass::Warrior:
+    return "Warrior";
+  case CharacterClass::Mage:
+    return "Mage";
+  case CharacterClass::Archer:
+    return "Archer";
+  case CharacterClass::Rogue:
+    return "Rogue";
+  case CharacterClass::Any:
+    break;
+  }
+  return "Adventurer";
+}
+
+Color lootColorForItem(const ItemDef* def) {
+  if (!def) {
+    return Color{200, 200, 200, 255};
+  }
+  switch (def->rarity) {
+  case ItemRarity::Common:
+    return Color{210, 210, 210, 255};
+  case ItemRarity::Rare:
+    return Color{100, 160, 255, 255};
+  case ItemRarity::Epic:
+    return Color{200, 120, 255, 255};
+  }
+  return Color{200, 200, 200, 255};
+}
+
+int computeAttackPower(const StatsComponent& stats, const EquipmentComponent& equipment,
+                       const ItemDatabase& database, CharacterClass characterClass) {
+  return stats.baseAttackPower +
+         primaryStatForClass(computeEffectivePrimaryStats(stats, equipment, database),
+                             characterClass);
+}
+
+int computeArmor(const StatsComponent& stats, const EquipmentComponent& equipment,
+                 const ItemDatabase& database) {
+  int total = stats.baseArmor;
+  for (const auto& entry : equipment.equipped) {
+    const ItemDef* def = database.getItem(entry.second.itemId);
+    if (!def) {
+      continue;
+    }
+    total += armorForItem(*def);
+  }
+  return total;
+}
+
+EffectivePrimaryStats computeEffectivePrimaryStats(const StatsComponent& stats,
+                                                   const EquipmentComponent& equipment,
+                                                   const ItemDatabase& database) {
+  EffectivePrimaryStats effective{stats.strength, stats.dexterity, stats.intellect, stats.luck};
+  for (const auto& entry : equipment.equipped) {
+    const ItemDef* def = database.getItem(entry.second.itemId);
+    if (!def) {
+      continue;
+    }
+    const PrimaryStatBonuses& primary = primaryStatsForItem(*def);
+    effective.strength += primary.strength;
+    effective.dexterity += primary.dexterity;
+    effective.intellect += primary.intellect;
+    effective.luck += primary.luck;
+  }
+  return effective;
+}
+
+AttackProfile attackProfileForWeapon(const EquipmentComponent& equipment,
+                                     const ItemDatabase& database) {
+  AttackProfile profile;
+  auto weaponIt = equipment.equipped.find(ItemSlot::Weapon);
+  if (weaponIt == equipment.equipped.end()) {
+    return profile;
+  }
+  const ItemDef* def = database.getItem(weaponIt->second.itemId);
+  if (!def) {
+    return profile;
+  }
+  switch (def->weaponType) {
+  case WeaponType::OneHandedSword:
+    profile.halfAngle = 0.75f;
+    profile.range = ATTACK_RANGE;
+    profile.cooldown = 0.5f;
+    break;
+  case WeaponType::TwoHandedSword:
+    profile.halfAngle = 0.9f;
+    profile.range = ATTACK_RANGE * 1.1f;
+    profile.cooldown = 0.8f;
+    break;
+  case WeaponType::Polearm:
+    profile.halfAngle = 0.6f;
+    profile.range = ATTACK_RANGE * 1.3f;
+    profile.cooldown = 0.9f;
+    break;
+  case WeaponType::Spear:
+    profile.halfAngle = 0.5f;
+    profile.range = ATTACK_RANGE * 1.4f;
+    profile.cooldown = 0.7f;
+    break;
+  case WeaponType::Bow:
+    profile.halfAngle = 0.35f;
+    profile.range = ATTACK_RANGE * 3.6f;
+    profile.cooldown = 0.9f;
+    profile.isRanged = true;
+    profile.projectileSpeed = 220.0f;
+    profile.projectileRadius = 9.0f;
+    profile.projectileTrailLength = 22.0f;
+    profile.projectileColor = Color{255, 220, 120, 255};
+    break;
+  case WeaponType::Wand:
+    profile.halfAngle = 0.4f;
+    profile.range = ATTACK_RANGE * 3.0f;
+    profile.cooldown = 0.8f;
+    profile.isRanged = true;
+    profile.projectileSpeed = 200.0f;
+    profile.projectileRadius = 10.0f;
+    profile.projectileTrailLength = 26.0f;
+    profile.projectileColor = Color{140, 200, 255, 255};
+    break;
+  case WeaponType::Dagger:
+    profile.halfAngle = 0.85f;
+    profile.range = ATTACK_RANGE * 0.85f;
+    profile.cooldown = 0.35f;
+    break;
+  case WeaponType::None:
+    profile.halfAngle = 0.65f;
+    profile.range = ATTACK_RANGE * 0.9f;
+    profile.cooldown = ATTACK_COOLDOWN_SECONDS;
+    break;
+  }
+  if (def->projectile.speed > 0.0f) {
+    profile.projectileSpeed = def->projectile.speed;
+  }
+  if (def->projectile.radius > 0.0f) {
+    profile.projectileRadius = def->projectile.radius;
+  }
+  if (def->projectile.trailLength > 0.0f) {
+    profile.projectileTrailLength = def->projectile.trailLength;
+  }
+  return profile;
+}
+
+bool refreshDerivedStats(DerivedStatsComponent& derived, StatsComponent& stats,
+                         const EquipmentComponent& equipment, const BuffComponent& buffs,
+                         int level, CharacterClass characterClass, const ItemDatabase& database) {
+  if (derived.computed && derived.equipmentVersion == equipment.version &&
+      derived.statsVersion == stats.version && derived.buffsVersion == buffs.version &&
+      derived.level == level && derived.characterClass == characterClass) {
+    return false;
+  }
+  derived.primary = computeEffectivePrimaryStats(stats, equipment, database);
+  refreshSecondaryStats(stats, derived.primary);
+  derived.armor = computeArmor(stats, equipment, database);
+  derived.attackPower =
+      stats.baseAttackPower + primaryStatForClass(derived.primary, characterClass);
+  derived.critChance = std::clamp(0.05f + stats.critChanceBonus, 0.05f, 0.65f);
+  derived.critMultiplier = std::clamp(1.5f + stats.critDamageBonus, 1.25f, 3.0f);
+  derived.attackProfile = attackProfileForWeapon(equipment, database);
+  derived.computed = true;
+  derived.equipmentVersion = equipment.version;
+  derived.statsVersion = stats.version;
+  derived.buffsVersion = buffs.version;
+  derived.level = level;
+  derived.characterClass = characterClass;
+  return true;
+}
+
+float squaredDistance(const Position& a, const Position& b) {
+  const float dx = a.x - b.x;
+  const float dy = a.y - b.y;
+  return (dx * dx) + (dy * dy);
+}
+
+Position centerForEntity(const TransformComponent& transform, const CollisionComponent& collision) {
+  return Position(transform.position.x + (collision.width / 2.0f),
+                  transform.position.y + (collision.height / 2.0f));
+}
+
+bool isInFacingArc(const Position& origin, const Position& target, float facingX, float facingY,
+                   float halfAngle) {
+  const float dx = target.x - origin.x;
+  const float dy = target.y - origin.y;
+  const float length = std::sqrt((dx * dx) + (dy * dy));
+  if (length <= 0.001f) {
+    return true;
+  }
+  const float facingLength = std::sqrt((facingX * facingX) + (facingY * facingY));
+  if (facingLength <= 0.001f) {
+    return true;
+  }
+  const float nx = dx / length;
+  const float ny = dy / length;
+  const float fnx = facingX / facingLength;
+  const float fny = facingY / facingLength;
+  const float dot = (nx * fnx) + (ny * fny);
+  return dot >= std::cos(halfAngle);
+}
@@ -0,0 +1,304 @@
+#include "simulation/input_recording.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace {
+constexpr std::array<char, 4> RECORDING_MAGIC = {'N', 'I', 'N', 'R'};
+// Bumped when the frame encoding or Simulation::computeStateHash() changes, since stored hashes
+// are compared as they are.
+constexpr std::uint32_t RECORDING_VERSION = 3;
+
+// Per-frame mask bits; a field is only written when it differs from the previous frame. The
+// wheel and panel commands belong to their tick alone, so they are written whenever present.
+constexpr std::uint8_t MOVE_CHANGED = 1 << 0;
+constexpr std::uint8_t BUTTONS_CHANGED = 1 << 1;
+constexpr std::uint8_t MOUSE_MOVED = 1 << 2;
+constexpr std::uint8_t MOUSE_PRESSED_TOGGLED = 1 << 3;
+constexpr std::uint8_t WHEEL_SCROLLED = 1 << 4;
+constexpr std::uint8_t COMMANDS_ISSUED = 1 << 5;
+constexpr PanelCommandType LAST_PANEL_COMMAND = PanelCommandType::UnlockSkill;
+
+void writeU32(std::vector<std::uint8_t>& out, std::uint32_t value) {
+  for (int shift = 0; shift < 32; shift += 8) {
+    out.push_back(static_cast<std::uint8_t>(value >> shift));
+  }
+}
+
+void writeU64(std::vector<std::uint8_t>& out, std::uint64_t value) {
+  for (int shift = 0; shift < 64; shift += 8) {
+    out.push_back(static_cast<std::uint8_t>(value >> shift));
+  }
+}
+
+void writeVarint(std::vector<std::uint8_t>& out, std::uint32_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<std::uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<std::uint8_t>(value));
+}
+
+void writeFloat(std::vector<std::uint8_t>& out, float value) {
+  std::uint32_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  writeU32(out, bits);
+}
+
+class Reader {
+public:
+  Reader(const std::vector<std::uint8_t>& data, std::size_t offset) : data(data), offset(offset) {}
+
+  bool readU8(std::uint8_t& value) {
+    if (this->offset >= this->data.size()) {
+      return false;
+    }
+    value = this->data[this->offset++];
+    return true;
+  }
+
+  bool readU32(std::uint32_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+      std::uint8_t byte = 0;
+      if (!readU8(byte)) {
+        return false;
+      }
+      value |= static_cast<std::uint32_t>(byte) << shift;
+    }
+    return true;
+  }
+
+  bool readU64(std::uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 8) {
+      std::uint8_t byte = 0;
+      if (!readU8(byte)) {
+        return false;
+      }
+      value |= static_cast<std::uint64_t>(byte) << shift;
+    }
+    return true;
+  }
+
+  bool readVarint(std::uint32_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+      std::uint8_t byte = 0;
+      if (!readU8(byte)) {
+        return false;
+      }
+      value |= static_cast<std::uint32_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  std::size_t remaining() const { return this->data.size() - this->offset; }
+
+  bool readFloat(float& value) {
+    std::uint32_t bits = 0;
+    if (!readU32(bits)) {
+      return false;
+    }
+    std::memcpy(&value, &bits, sizeof(value));
+    return true;
+  }
+
+private:
+  const std::vector<std::uint8_t>& data;
+  std::size_t offset;
+};
+
+void encodeFrame(std::vector<std::uint8_t>& out, const InputFrame& frame,
+                 const InputFrame& previous) {
+  std::uint8_t mask = 0;
+  if (frame.moveX != previous.moveX || frame.moveY != previous.moveY) {
+    mask |= MOVE_CHANGED;
+  }
+  if (frame.buttons != previous.buttons) {
+    mask |= BUTTONS_CHANGED;
+  }
+  if (frame.mouseX != previous.mouseX || frame.mouseY != previous.mouseY) {
+    mask |= MOUSE_MOVED;
+  }
+  if (frame.mousePressed != previous.mousePressed) {
+    mask |= MOUSE_PRESSED_TOGGLED;
+  }
+  if (frame.mouseWheelDelta != 0.0f) {
+    mask |= WHEEL_SCROLLED;
+  }
+  if (!frame.commands.empty()) {
+    mask |= COMMANDS_ISSUED;
+  }
+
+  out.push_back(mask);
+  if (mask & MOVE_CHANGED) {
+    out.push_back(static_cast<std::uint8_t>(static_cast<std::int8_t>(frame.moveX)));
+    out.push_back(static_cast<std::uint8_t>(static_cast<std::int8_t>(frame.moveY)));
+  }
+  if (mask & BUTTONS_CHANGED) {
+    writeVarint(out, frame.buttons);
+  }
+  if (mask & MOUSE_MOVED) {
+    writeFloat(out, frame.mouseX);
+    writeFloat(out, frame.mouseY);
+  }
+  if (mask & WHEEL_SCROLLED) {
+    writeFloat(out, frame.mouseWheelDelta);
+  }
+  if (mask & COMMANDS_ISSUED) {
+    writeVarint(out, static_cast<std::uint32_t>(frame.commands.size()));
+    for (const PanelCommand& command : frame.commands) {
+      out.push_back(static_cast<std::uint8_t>(command.type));
+      writeVarint(out, static_cast<std::uint32_t>(command.value));
+    }
+  }
+}
+
+bool decodeFrame(Reader& reader, InputFrame& frame) {
+  std::uint8_t mask = 0;
+  if (!reader.readU8(mask)) {
+    return false;
+  }
+  frame.mouseWheelDelta = 0.0f;
+  frame.commands.clear();
+  if (mask & MOVE_CHANGED) {
+    std::uint8_t moveX = 0;
+    std::uint8_t moveY = 0;
+    if (!reader.readU8(moveX) || !reader.readU8(moveY)) {
+      return false;
+    }
+    frame.moveX = static_cast<std::int8_t>(moveX);
+    frame.moveY = static_cast<std::int8_t>(moveY);
+  }
+  if ((mask & BUTTONS_CHANGED) && !reader.readVarint(frame.buttons)) {
+    return false;
+  }
+  if ((mask & MOUSE_MOVED) &&
+      (!reader.readFloat(frame.mouseX) || !reader.readFloat(frame.mouseY))) {
+    return false;
+  }
+  if (mask & MOUSE_PRESSED_TOGGLED) {
+    frame.mousePressed = !frame.mousePressed;
+  }
+  if ((mask & WHEEL_SCROLLED) && !reader.readFloat(frame.mouseWheelDelta)) {
+    return false;
+  }
+  if (mask & COMMANDS_ISSUED) {
+    // Each command takes at least two bytes, which bounds what a corrupt count can allocate.
+    std::uint32_t count = 0;
+    if (!reader.readVarint(count) || count > reader.remaining() / 2) {
+      return false;
+    }
+    frame.commands.resize(count);
+    for (PanelCommand& command : frame.commands) {
+      std::uint8_t type = 0;
+      std::uint32_t value = 0;
+      if (!reader.readU8(type) || type > static_cast<std::uint8_t>(LAST_PANEL_COMMAND) ||
+          !reader.readVarint(value)) {
+        return false;
+      }
+      command.type = static_cast<PanelCommandType>(type);
+      command.value = static_cast<int>(value);
+    }
+  }
+  return true;
+}
+} // namespace
+
+bool saveInputRecording(const std::string& path, const InputRecording& recording) {
+  std::vector<std::uint8_t> bytes(RECORDING_MAGIC.begin(), RECORDING_MAGIC.end());
+  writeU32(bytes, RECORDING_VERSION);
+  writeU32(bytes, recording.worldSeed);
+  writeU32(bytes, static_cast<std::uint32_t>(recording.frames.size()));
+  writeU32(bytes, static_cast<std::uint32_t>(recording.stateHashes.size()));
+  InputFrame previous;
+  for (const InputFrame& frame : recording.frames) {
+    encodeFrame(bytes, frame, previous);
+    previous = frame;
+  }
+  for (std::uint64_t hash : recording.stateHashes) {
+    writeU64(bytes, hash);
+  }
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    return false;
+  }
+  file.write(reinterpret_cast<const char*>(bytes.data()),
+             static_cast<std::streamsize>(bytes.size()));
+  return static_cast<bool>(file);
+}
+
+std::optional<InputRecording> loadInputRecording(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    return std::nullopt;
+  }
+  const std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(file)),
+                                        std::istreambuf_iterator<char>());
+  if (bytes.size() < RECORDING_MAGIC.size() ||
+      !std::equal(RECORDING_MAGIC.begin(), RECORDING_MAGIC.end(), bytes.begin())) {
+    return std::nullopt;
+  }
+
+  Reader reader(bytes, RECORDING_MAGIC.size());
+  std::uint32_t version = 0;
+  InputRecording recording;
+  std::uint32_t frameCount = 0;
+  std::uint32_t hashCount = 0;
+  if (!reader.readU32(version) || version != RECORDING_VERSION ||
+      !reader.readU32(recording.worldSeed) || !reader.readU32(frameCount) ||
+      !reader.readU32(hashCount)) {
+    return std::nullopt;
+  }
+
+  // Every frame takes at least a byte and every hash eight, which bounds what a corrupt
+  // header can make us allocate.
+  if (frameCount > bytes.size() || hashCount > bytes.size() / 8) {
+    return std::nullopt;
+  }
+  recording.frames.reserve(frameCount);
+  InputFrame frame;
+  for (std::uint32_t i = 0; i < frameCount; ++i) {
+    if (!decodeFrame(reader, frame)) {
+      return std::nullopt;
+    }
+    recording.frames.push_back(frame);
+  }
+  recording.stateHashes.resize(hashCount);
+  for (std::uint64_t& hash : recording.stateHashes) {
+    if (!reader.readU64(hash)) {
+      return std::nullopt;
+    }
+  }
+  return recording;
+}
+
+RecordingInputSource::RecordingInputSource(InputSource& source, unsigned int worldSeed)
+    : source(source) {
+  this->recording.worldSeed = worldSeed;
+}
+
+InputFrame RecordingInputSource::nextFrame() {
+  const InputFrame frame = this->source.nextFrame();
+  this->recording.frames.push_back(frame);
+  return frame;
+}
+
+void RecordingInputSource::recordStateHash(std::uint64_t hash) {
+  this->recording.stateHashes.push_back(hash);
+}
+
+InputFrame ReplayInputSource::nextFrame() {
+  if (isFinished()) {
+    return InputFrame{};
+  }
+  return this->recording.frames[this->nextIndex++];
+}
@@ -0,0 +1,28 @@
+#include "simulation/item_sweeper.h"
+
+#include "ecs/component/equipment_component.h"
+#include "ecs/component/inventory_component.h"
+#include "ecs/component/loot_component.h"
+#include <algorithm>
+
+bool ItemSweeper::sweep(ItemDatabase& database, Registry& registry,
+                        const std::vector<int>& lootEntityIds, int playerEntityId) {
+  if (database.generatedItemCount() < this->threshold) {
+    return false;
+  }
+  this->referencedIds.clear();
+  for (int lootEntityId : lootEntityIds) {
+    this->referencedIds.push_back(registry.getComponent<LootComponent>(lootEntityId).itemId);
+  }
+  const InventoryComponent& inventory = registry.getComponent<InventoryComponent>(playerEntityId);
+  for (const ItemInstance& item : inventory.items) {
+    this->referencedIds.push_back(item.itemId);
+  }
+  const EquipmentComponent& equipment = registry.getComponent<EquipmentComponent>(playerEntityId);
+  for (const auto& [slot, item] : equipment.equipped) {
+    this->referencedIds.push_back(item.itemId);
+  }
+  database.releaseUnreferenced(this->referencedIds);
+  this->threshold = std::max(MIN_THRESHOLD, database.generatedItemCount() * 2);
+  return true;
+}
@@ -0,0 +1,78 @@
+#include "simulation/mob_movement.h"
+
+#include "ecs/component/mob_component.h"
+#include "mobs/mob_database.h"
+#include "simulation/game_rules.h"
+#include "world/tile.h"
+#include <cmath>
+
+namespace {
+bool isBlockedByMap(const Map& map, const CollisionComponent& collision, float nextX, float nextY) {
+  const float left = nextX;
+  const float right = nextX + collision.width - 1.0f;
+  const float top = nextY;
+  const float bottom = nextY + collision.height - 1.0f;
+
+  const int tileLeft = static_cast<int>(left / TILE_SIZE);
+  const int tileRight = static_cast<int>(right / TILE_SIZE);
+  const int tileTop = static_cast<int>(top / TILE_SIZE);
+  const int tileBottom = static_cast<int>(bottom / TILE_SIZE);
+
+  return !map.isWalkable(tileLeft, tileTop) || !map.isWalkable(tileRight, tileTop) ||
+         !map.isWalkable(tileLeft, tileBottom) || !map.isWalkable(tileRight, tileBottom);
+}
+} // namespace
+
+void moveEntityToward(const Map& map, TransformComponent& transform,
+                      const CollisionComponent& collision, float speed, const Position& target,
+                      float dt) {
+  float dx = target.x - transform.position.x;
+  float dy = target.y - transform.position.y;
+  const float length = std::sqrt((dx * dx) + (dy * dy));
+  if (length <= 0.001f) {
+    return;
+  }
+  dx /= length;
+  dy /= length;
+  const float newX = transform.position.x + (dx * speed * dt);
+  const float newY = transform.position.y + (dy * speed * dt);
+
+  if (!isBlockedByMap(map, collision, newX, transform.position.y)) {
+    transform.position.x = newX;
+  }
+  if (!isBlockedByMap(map, collision, transform.position.x, newY)) {
+    transform.position.y = newY;
+  }
+}
+
+Position mobHomePosition(const MobComponent& mob) {
+  return Position(mob.homeX * TILE_SIZE, mob.homeY * TILE_SIZE);
+}
+
+Position mobHomeCenter(const MobComponent& mob, const CollisionComponent& collision) {
+  const Position homePosition = mobHomePosition(mob);
+  return Position(homePosition.x + (collision.width / 2.0f),
+                  homePosition.y + (collision.height / 2.0f));
+}
+
+void settleIdleMob(const Map& map, const MobComponent& mob, TransformComponent& transform,
+                   const CollisionComponent& collision, float seconds, float tickSeconds) {
+  if (mob.stats->speed <= 0.0f || tickSeconds <= 0.0f) {
+    return;
+  }
+  const Position homePosition = mobHomePosition(mob);
+  const Position homeCenter = mobHomeCenter(mob, collision);
+  const long steps = std::lround(seconds / tickSeconds);
+  for (long step = 0; step < steps; ++step) {
+    if (squaredDistance(centerForEntity(transform, collision), homeCenter) <=
+        MOB_HOME_RADIUS_SQUARED) {
+      return;
+    }
+    const Position before = transform.position;
+    moveEntityToward(map, transform, collision, mob.stats->speed, homePosition, tickSeconds);
+    // Pinned against a wall on both axes: every later step would be the same no-op.
+    if (transform.position.x == before.x && transform.position.y == before.y) {
+      return;
+    }
+  }
+}
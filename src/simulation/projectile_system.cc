@@ -1,10 +1,9 @@
-#include "gameplay/projectile_system.h"
+#include "simulation/projectile_system.h"
 
 #include "ecs/component/collision_component.h"
 #include "ecs/component/health_component.h"
 #include "ecs/component/projectile_component.h"
 #include "ecs/component/transform_component.h"
-#include "ui/render_utils.h"
 #include <algorithm>
 #include <cmath>
 
@@ -67,8 +66,8 @@ void updateProjectiles(float dt, Registry& registry, const Map& map,
         const float radius = (mobCollision.width / 2.0f) + projectile.radius;
         if (squaredDistance(projectileTransform.position, mobCenter) <= radius * radius) {
           if (onHit) {
-            onHit(projectile.targetEntityId, projectile.damage, projectile.isCrit, mobCenter,
-                  playerCenter);
+            onHit(projectile.targetEntityId, projectile.damage, projectile.isCrit,
+                  projectile.skillId, mobCenter, playerCenter);
           }
           shouldRemove = true;
         }
@@ -83,41 +82,3 @@ void updateProjectiles(float dt, Registry& registry, const Map& map,
     }
   }
 }
-
-void renderProjectiles(SDL_Renderer* renderer, const Position& cameraPosition, Registry& registry,
-                       const std::vector<int>& projectileEntityIds) {
-  SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-  for (int projectileId : projectileEntityIds) {
-    const TransformComponent& projectileTransform =
-        registry.getComponent<TransformComponent>(projectileId);
-    const ProjectileComponent& projectile =
-        registry.getComponent<ProjectileComponent>(projectileId);
-    const float size = projectile.radius * 2.0f;
-    SDL_FRect projectileRect = {projectileTransform.position.x - projectile.radius -
-                                    cameraPosition.x,
-                                projectileTransform.position.y - projectile.radius -
-                                    cameraPosition.y,
-                                size, size};
-    SDL_SetRenderDrawColor(renderer, projectile.color.r, projectile.color.g, projectile.color.b,
-                           projectile.color.a);
-    SDL_RenderFillRect(renderer, &projectileRect);
-    if (projectile.trailLength > 0.0f) {
-      const float speed = std::sqrt((projectile.velocityX * projectile.velocityX) +
-                                    (projectile.velocityY * projectile.velocityY));
-      if (speed > 0.001f) {
-        const float nx = projectile.velocityX / speed;
-        const float ny = projectile.velocityY / speed;
-        const float tailX = projectileTransform.position.x - (nx * projectile.trailLength);
-        const float tailY = projectileTransform.position.y - (ny * projectile.trailLength);
-        SDL_SetRenderDrawColor(renderer, 255, 255, 255, 200);
-        SDL_RenderLine(renderer, tailX - cameraPosition.x, tailY - cameraPosition.y,
-                       projectileTransform.position.x - cameraPosition.x,
-                       projectileTransform.position.y - cameraPosition.y);
-      }
-    }
-    drawCircle(renderer, projectileTransform.position, projectile.radius + 2.0f, cameraPosition,
-               SDL_Color{255, 255, 255, 200});
-    SDL_SetRenderDrawColor(renderer, 30, 30, 30, 200);
-    SDL_RenderRect(renderer, &projectileRect);
-  }
-}
@@ -0,0 +1,1889 @@
+#include "simulation/simulation.h"
+
+#include "ecs/component/buff_component.h"
+#include "ecs/component/class_component.h"
+#include "ecs/component/collision_component.h"
+#include "ecs/component/derived_stats_component.h"
+#include "ecs/component/equipment_component.h"
+#include "ecs/component/graphic_component.h"
+#include "ecs/component/health_component.h"
+#include "ecs/component/inventory_component.h"
+#include "ecs/component/level_component.h"
+#include "ecs/component/loot_component.h"
+#include "ecs/component/mana_component.h"
+#include "ecs/component/mob_component.h"
+#include "ecs/component/movement_component.h"
+#include "ecs/component/npc_component.h"
+#include "ecs/component/projectile_component.h"
+#include "ecs/component/pushback_component.h"
+#include "ecs/component/quest_log_component.h"
+#include "ecs/component/shop_component.h"
+#include "ecs/component/skill_bar_component.h"
+#include "ecs/component/skill_tree_component.h"
+#include "ecs/component/stats_component.h"
+#include "ecs/component/transform_component.h"
+#include "ecs/system/movement_system.h"
+#include "ecs/system/pushback_system.h"
+#include "events/events.h"
+#include "quests/quest_helpers.h"
+#include "simulation/game_rules.h"
+#include "simulation/mob_movement.h"
+#include "simulation/projectile_system.h"
+#include "simulation/skill_effects.h"
+#include "simulation/worker_pool.h"
+#include "world/generator.h"
+#include "world/region.h"
+#include "world/tile.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace {
+constexpr float AUTO_TARGET_RANGE_MULTIPLIER = 2.0f;
+constexpr float LOOT_DESPAWN_SECONDS = 90.0f;
+constexpr float NPC_INTERACT_RANGE = 52.0f;
+constexpr float FACING_TURN_SPEED = 8.0f;
+constexpr float PUSHBACK_DISTANCE = static_cast<float>(TILE_SIZE);
+constexpr float PUSHBACK_DURATION = 0.2f;
+constexpr float PLAYER_KNOCKBACK_IMMUNITY_SECONDS = 2.0f;
+constexpr float SKILL_PROJECTILE_RADIUS = 6.0f;
+constexpr float SKILL_PROJECTILE_TRAIL_LENGTH = 14.0f;
+constexpr Color SKILL_PROJECTILE_COLOR = {150, 210, 255, 255};
+// Mob AI detail by distance from the player. Active mobs get the full update every tick and
+// cover the screen plus any aggro or attack reach; reduced mobs can only walk home, so they do
+// it every few ticks with the time owed; sleeping mobs settle that time when they wake.
+constexpr float MOB_ACTIVE_RADIUS = 20.0f * TILE_SIZE;
+constexpr float MOB_REDUCED_RADIUS = 48.0f * TILE_SIZE;
+constexpr std::uint64_t MOB_REDUCED_INTERVAL = 4;
+// Mobs per think task; small enough that the default world still splits across workers.
+constexpr std::size_t MOB_AI_CHUNK_SIZE = 16;
+constexpr unsigned int COMBAT_SEED_SALT = 0xA53F91U;
+constexpr unsigned int LOOT_SEED_SALT = 0xBADC0DEU;
+constexpr unsigned int SPAWN_SEED_SALT = 0x51EED123U;
+
+// FNV-1a over the raw bytes of each value, so floats must match bit for bit.
+class StateHasher {
+public:
+  template <typename T> void add(const T& value) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(&value);
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+      this->hash = (this->hash ^ bytes[i]) * 0x100000001B3ULL;
+    }
+  }
+  void addPosition(const Position& position) {
+    add(position.x);
+    add(position.y);
+  }
+  std::uint64_t value() const { return this->hash; }
+
+private:
+  std::uint64_t hash = 0xCBF29CE484222325ULL;
+};
+
+InputButton offsetButton(InputButton first, std::size_t offset) {
+  return static_cast<InputButton>(static_cast<std::size_t>(first) + offset);
+}
+
+unsigned int deriveSeed(unsigned int baseSeed, unsigned int salt) {
+  return baseSeed ^ (salt + 0x9E3779B9U + (baseSeed << 6U) + (baseSeed >> 2U));
+}
+
+std::string regionName(RegionType type) {
+  switch (type) {
+  case RegionType::StartingZone:
+    return "Starting Zone";
+  case RegionType::SpawnRegion:
+    return "Spawn Region";
+  case RegionType::GoblinCamp:
+    return "Goblin Camp";
+  case RegionType::DungeonEntrance:
+    return "Dungeon Entrance";
+  }
+  return "Region";
+}
+
+float shortestAngleDiff(float from, float to) {
+  constexpr float kPi = 3.14159265f;
+  float diff = std::fmod(to - from, 2.0f * kPi);
+  if (diff > kPi) {
+    diff -= 2.0f * kPi;
+  } else if (diff < -kPi) {
+    diff += 2.0f * kPi;
+  }
+  return diff;
+}
+
+int regionIndexAt(const Map& map, int tileX, int tileY) {
+  const std::vector<Region>& regions = map.getRegions();
+  for (std::size_t i = 0; i < regions.size(); ++i) {
+    if (regions[i].contains(tileX, tileY)) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+bool isShopNpc(int npcId, const std::vector<int>& shopNpcIds) {
+  return std::find(shopNpcIds.begin(), shopNpcIds.end(), npcId) != shopNpcIds.end();
+}
+
+float mobEvasionChance(const MobComponent& mob) {
+  float base = 0.02f;
+  switch (mob.stats->behavior) {
+  case MobBehaviorType::Melee:
+    base = 0.03f;
+    break;
+  case MobBehaviorType::Ranged:
+    base = 0.055f;
+    break;
+  case MobBehaviorType::Caster:
+    base = 0.045f;
+    break;
+  case MobBehaviorType::Bruiser:
+    base = 0.015f;
+    break;
+  case MobBehaviorType::Skirmisher:
+    base = 0.06f;
+    break;
+  }
+  return std::clamp(base + (0.0018f * static_cast<float>(mob.stats->level)), 0.01f, 0.25f);
+}
+
+Position retreatTarget(const Position& mobCenter, const Position& playerCenter, float currentX,
+                       float currentY) {
+  float dx = mobCenter.x - playerCenter.x;
+  float dy = mobCenter.y - playerCenter.y;
+  const float length = std::sqrt((dx * dx) + (dy * dy));
+  if (length <= 0.001f) {
+    return Position(currentX, currentY);
+  }
+  dx /= length;
+  dy /= length;
+  return Position(currentX + (dx * TILE_SIZE * 2.0f), currentY + (dy * TILE_SIZE * 2.0f));
+}
+
+struct ClassDefaults {
+  int baseAttackPower = 1;
+  int baseArmor = 0;
+  int strength = 5;
+  int dexterity = 5;
+  int intellect = 5;
+  int luck = 5;
+  int health = 100;
+  int mana = 50;
+  int weaponId = 1;
+  int offhandId = 0;
+};
+
+bool isSkillUnlocked(const SkillTreeComponent& tree, int skillId) {
+  return tree.unlockedSkills.count(skillId) > 0;
+}
+
+ClassDefaults classDefaultsFor(CharacterClass characterClass) {
+  switch (characterClass) {
+  case CharacterClass::Warrior:
+    return ClassDefaults{2, 1, 8, 4, 2, 3, 130, 30, 1, 2};
+  case CharacterClass::Mage:
+    return ClassDefaults{1, 0, 2, 4, 9, 4, 80, 90, 7, 0};
+  case CharacterClass::Archer:
+    return ClassDefaults{1, 0, 4, 9, 3, 4, 95, 50, 6, 0};
+  case CharacterClass::Rogue:
+    return ClassDefaults{1, 0, 5, 8, 2, 7, 90, 40, 8, 0};
+  case CharacterClass::Any:
+    return ClassDefaults{1, 0, 5, 5, 5, 5, 100, 50, 1, 2};
+  }
+  return ClassDefaults{};
+}
+
+void applyLevelUps(LevelComponent& level, StatsComponent& stats, SkillTreeComponent& skillTree) {
+  while (level.level < PLAYER_LEVEL_CAP && level.experience >= level.nextLevelExperience) {
+    level.experience -= level.nextLevelExperience;
+    level.level += 1;
+    level.nextLevelExperience += 100;
+    stats.unspentPoints += 5;
+    skillTree.unspentPoints += 1;
+  }
+  if (level.level >= PLAYER_LEVEL_CAP) {
+    level.level = PLAYER_LEVEL_CAP;
+    level.experience = 0;
+    level.nextLevelExperience = 0;
+  }
+}
+
+bool equipItemByIndex(InventoryComponent& inventory, EquipmentComponent& equipment,
+                      const ItemDatabase& database, std::size_t index, int playerLevel,
+                      CharacterClass playerClass) {
+  std::optional<ItemInstance> item = inventory.takeItemAt(index);
+  if (!item.has_value()) {
+    return false;
+  }
+  const ItemDef* def = database.getItem(item->itemId);
+  if (!def) {
+    inventory.addItem(*item);
+    return false;
+  }
+  if (!meetsEquipRequirements(*def, playerLevel, playerClass)) {
+    inventory.addItem(*item);
+    return false;
+  }
+
+  auto equippedIt = equipment.equipped.find(def->slot);
+  if (equippedIt != equipment.equipped.end()) {
+    if (!inventory.addItem(equippedIt->second)) {
+      inventory.addItem(*item);
+      return false;
+    }
+    equipment.equipped.erase(equippedIt);
+  }
+
+  equipment.equipped[def->slot] = *item;
+  equipment.version += 1;
+  return true;
+}
+
+
+void applyPushback(Registry& registry, int targetEntityId, const Position& fromPosition,
+                   float distance, float duration) {
+  TransformComponent& targetTransform = registry.getComponent<TransformComponent>(targetEntityId);
+  const CollisionComponent& targetCollision =
+      registry.getComponent<CollisionComponent>(targetEntityId);
+  const Position targetCenter = centerForEntity(targetTransform, targetCollision);
+  float dx = targetCenter.x - fromPosition.x;
+  float dy = targetCenter.y - fromPosition.y;
+  const float length = std::sqrt((dx * dx) + (dy * dy));
+  if (length <= 0.001f || duration <= 0.0f) {
+    return;
+  }
+  dx /= length;
+  dy /= length;
+
+  PushbackComponent& pushback = registry.getComponent<PushbackComponent>(targetEntityId);
+  const float speed = distance / duration;
+  pushback.velocityX = dx * speed;
+  pushback.velocityY = dy * speed;
+  pushback.remaining = duration;
+}
+
+int createLootEntity(Registry& registry, const ItemDatabase& database, const Position& position,
+                     int itemId, std::vector<int>& lootEntityIds, bool allowDespawn = true) {
+  const ItemDef* def = database.getItem(itemId);
+  const Color lootColor = lootColorForItem(def);
+  int entityId = registry.createEntity();
+  registry.registerComponentForEntity<TransformComponent>(
+      std::make_unique<TransformComponent>(position), entityId);
+  registry.registerComponentForEntity<GraphicComponent>(
+      std::make_unique<GraphicComponent>(position, lootColor), entityId);
+  registry.registerComponentForEntity<CollisionComponent>(
+      std::make_unique<CollisionComponent>(32.0f, 32.0f, false), entityId);
+  const float despawnSeconds = allowDespawn ? LOOT_DESPAWN_SECONDS : 0.0f;
+  registry.registerComponentForEntity<LootComponent>(
+      std::make_unique<LootComponent>(itemId, despawnSeconds), entityId);
+  lootEntityIds.push_back(entityId);
+  return entityId;
+}
+
+int createNpcEntity(Registry& registry, const Position& position, std::string name,
+                    std::string dialogLine, std::vector<int>& npcEntityIds) {
+  int entityId = registry.createEntity();
+  registry.registerComponentForEntity<TransformComponent>(
+      std::make_unique<TransformComponent>(position), entityId);
+  registry.registerComponentForEntity<GraphicComponent>(
+      std::make_unique<GraphicComponent>(position, Color{220, 200, 120, 255}), entityId);
+  registry.registerComponentForEntity<CollisionComponent>(
+      std::make_unique<CollisionComponent>(32.0f, 32.0f, false), entityId);
+  registry.registerComponentForEntity<NpcComponent>(
+      std::make_unique<NpcComponent>(std::move(name), std::move(dialogLine)), entityId);
+  npcEntityIds.push_back(entityId);
+  return entityId;
+}
+
+int createShopNpcEntity(Registry& registry, const Position& position, std::string name,
+                        std::string dialogLine, std::vector<int> stock,
+                        std::vector<int>& npcEntityIds, std::vector<int>& shopNpcIds) {
+  int entityId =
+      createNpcEntity(registry, position, std::move(name), std::move(dialogLine), npcEntityIds);
+  registry.registerComponentForEntity<ShopComponent>(
+      std::make_unique<ShopComponent>(std::move(stock)), entityId);
+  shopNpcIds.push_back(entityId);
+  return entityId;
+}
+
+int createProjectileEntity(Registry& registry, const Position& position, float velocityX,
+                           float velocityY, float range, int sourceEntityId, int targetEntityId,
+                           int damage, bool isCrit, float radius, float trailLength,
+                           Color color, std::vector<int>& projectileEntityIds) {
+  int entityId = registry.createEntity();
+  registry.registerComponentForEntity<TransformComponent>(
+      std::make_unique<TransformComponent>(position), entityId);
+  auto projectile =
+      std::make_unique<ProjectileComponent>(sourceEntityId, targetEntityId, velocityX, velocityY,
+                                            range, damage, isCrit, radius, trailLength, color);
+  projectile->lastX = position.x;
+  projectile->lastY = position.y;
+  registry.registerComponentForEntity<ProjectileComponent>(std::move(projectile), entityId);
+  projectileEntityIds.push_back(entityId);
+  return entityId;
+}
+} // namespace
+
+Simulation::Simulation(unsigned int worldSeed, unsigned int aiWorkerThreads)
+    : worldSeed(worldSeed) {
+  if (aiWorkerThreads > 0) {
+    this->aiWorkers = std::make_unique<WorkerPool>(aiWorkerThreads);
+  }
+  this->rng.reseed(deriveSeed(this->worldSeed, COMBAT_SEED_SALT));
+  this->lootRng.reseed(deriveSeed(this->worldSeed, LOOT_SEED_SALT));
+  this->registry = std::make_unique<Registry>();
+  this->itemDatabase = std::make_unique<ItemDatabase>();
+  this->mobDatabase = std::make_unique<MobDatabase>();
+  this->skillDatabase = std::make_unique<SkillDatabase>();
+  this->skillTreeDefinition = std::make_unique<SkillTreeDefinition>();
+  this->questDatabase = std::make_unique<QuestDatabase>();
+  this->statusEffectDatabase = std::make_unique<StatusEffectDatabase>();
+  this->questSystem = std::make_unique<QuestSystem>(*this->questDatabase);
+  this->eventBus = std::make_unique<EventBus>();
+  this->respawnSystem = std::make_unique<RespawnSystem>(
+      *this->mobDatabase, deriveSeed(this->worldSeed, SPAWN_SEED_SALT));
+
+  Generator generator;
+  this->map = generator.generate();
+  this->map->print();
+
+  Coordinate start = this->map->getStartingPosition();
+  Position playerPosition(start.x * TILE_SIZE, start.y * TILE_SIZE);
+  this->playerEntityId = this->registry->createEntity();
+  this->registry->registerComponentForEntity<TransformComponent>(
+      std::make_unique<TransformComponent>(playerPosition), this->playerEntityId);
+  this->registry->registerComponentForEntity<MovementComponent>(
+      std::make_unique<MovementComponent>(100.0f), this->playerEntityId);
+  this->registry->registerComponentForEntity<GraphicComponent>(
+      std::make_unique<GraphicComponent>(playerPosition, Color{240, 240, 240, 255}),
+      this->playerEntityId);
+  this->registry->registerComponentForEntity<CollisionComponent>(
+      std::make_unique<CollisionComponent>(32.0f, 32.0f, true), this->playerEntityId);
+  this->registry->registerComponentForEntity<PushbackComponent>(
+      std::make_unique<PushbackComponent>(0.0f, 0.0f, 0.0f), this->playerEntityId);
+  this->registry->registerComponentForEntity<HealthComponent>(
+      std::make_unique<HealthComponent>(100, 100), this->playerEntityId);
+  this->registry->registerComponentForEntity<ManaComponent>(std::make_unique<ManaComponent>(50, 50),
+                                                            this->playerEntityId);
+  this->registry->registerComponentForEntity<LevelComponent>(
+      std::make_unique<LevelComponent>(1, 0, 100), this->playerEntityId);
+  this->registry->registerComponentForEntity<InventoryComponent>(
+      std::make_unique<InventoryComponent>(), this->playerEntityId);
+  this->registry->registerComponentForEntity<EquipmentComponent>(
+      std::make_unique<EquipmentComponent>(), this->playerEntityId);
+  this->registry->registerComponentForEntity<StatsComponent>(std::make_unique<StatsComponent>(),
+                                                             this->playerEntityId);
+  this->registry->registerComponentForEntity<SkillBarComponent>(
+      std::make_unique<SkillBarComponent>(), this->playerEntityId);
+  this->registry->registerComponentForEntity<SkillTreeComponent>(
+      std::make_unique<SkillTreeComponent>(), this->playerEntityId);
+  this->registry->registerComponentForEntity<BuffComponent>(std::make_unique<BuffComponent>(),
+                                                            this->playerEntityId);
+  this->registry->registerComponentForEntity<QuestLogComponent>(
+      std::make_unique<QuestLogComponent>(), this->playerEntityId);
+  constexpr CharacterClass kDefaultClass = CharacterClass::Any;
+  this->registry->registerComponentForEntity<ClassComponent>(
+      std::make_unique<ClassComponent>(kDefaultClass), this->playerEntityId);
+  this->registry->registerComponentForEntity<DerivedStatsComponent>(
+      std::make_unique<DerivedStatsComponent>(), this->playerEntityId);
+
+  {
+    InventoryComponent& inventory =
+        this->registry->getComponent<InventoryComponent>(this->playerEntityId);
+    EquipmentComponent& equipment =
+        this->registry->getComponent<EquipmentComponent>(this->playerEntityId);
+    StatsComponent& stats = this->registry->getComponent<StatsComponent>(this->playerEntityId);
+    HealthComponent& health = this->registry->getComponent<HealthComponent>(this->playerEntityId);
+    ManaComponent& mana = this->registry->getComponent<ManaComponent>(this->playerEntityId);
+    const ClassComponent& playerClass =
+        this->registry->getComponent<ClassComponent>(this->playerEntityId);
+    const ClassDefaults defaults = classDefaultsFor(playerClass.characterClass);
+    stats.baseAttackPower = defaults.baseAttackPower;
+    stats.baseArmor = defaults.baseArmor;
+    stats.strength = defaults.strength;
+    stats.dexterity = defaults.dexterity;
+    stats.intellect = defaults.intellect;
+    stats.luck = defaults.luck;
+    health.max = defaults.health;
+    health.current = defaults.health;
+    mana.max = defaults.mana;
+    mana.current = defaults.mana;
+    if (defaults.weaponId > 0) {
+      ItemInstance weaponInstance{defaults.weaponId};
+      if (inventory.addItem(weaponInstance)) {
+        equipItemByIndex(inventory, equipment, *this->itemDatabase, 0, 1,
+                         playerClass.characterClass);
+      }
+    }
+    if (defaults.offhandId > 0) {
+      ItemInstance offhandInstance{defaults.offhandId};
+      if (inventory.addItem(offhandInstance)) {
+        equipItemByIndex(inventory, equipment, *this->itemDatabase, 0, 1,
+                         playerClass.characterClass);
+      }
+    }
+  }
+  refreshPlayerDerivedStats();
+
+  { // Assign starter skills to the player
+    SkillBarComponent& skills =
+        this->registry->getComponent<SkillBarComponent>(this->playerEntityId);
+    skills.slots[0].skillId = 1;
+    skills.slots[1].skillId = 2;
+    skills.slots[2].skillId = 3;
+  }
+
+  {
+    QuestLogComponent& questLog =
+        this->registry->getComponent<QuestLogComponent>(this->playerEntityId);
+    const LevelComponent& level =
+        this->registry->getComponent<LevelComponent>(this->playerEntityId);
+    this->questSystem->addQuest(questLog, level, 1);
+  }
+
+  {
+    int npcTileX = start.x + 1;
+    int npcTileY = start.y;
+    if (!this->map->isWalkable(npcTileX, npcTileY)) {
+      npcTileX = start.x;
+      npcTileY = start.y + 1;
+    }
+    if (!this->map->isWalkable(npcTileX, npcTileY)) {
+      npcTileX = start.x;
+      npcTileY = start.y;
+    }
+    Position npcPosition(npcTileX * TILE_SIZE, npcTileY * TILE_SIZE);
+    createNpcEntity(*this->registry, npcPosition, "Town Guide",
+                    "Welcome! Explore the world and grow strong.", this->npcEntityIds);
+  }
+
+  {
+    int npcTileX = start.x + 2;
+    int npcTileY = start.y;
+    if (!this->map->isWalkable(npcTileX, npcTileY)) {
+      npcTileX = start.x + 1;
+      npcTileY = start.y + 1;
+    }
+    if (!this->map->isWalkable(npcTileX, npcTileY)) {
+      npcTileX = start.x;
+      npcTileY = start.y + 2;
+    }
+    if (this->map->isWalkable(npcTileX, npcTileY)) {
+      Position npcPosition(npcTileX * TILE_SIZE, npcTileY * TILE_SIZE);
+      createShopNpcEntity(*this->registry, npcPosition, "Shopkeeper", "Need supplies? Take a look.",
+                          {1, 5, 6, 7, 8, 2, 3, 4}, this->npcEntityIds, this->shopNpcIds);
+    }
+  }
+
+  { // Unlock the starter skill
+    SkillTreeComponent& skillTree =
+        this->registry->getComponent<SkillTreeComponent>(this->playerEntityId);
+    skillTree.unlockedSkills.insert(1);
+  }
+
+  { // Spawn loot items near the starting zone
+    const std::array<int, 7> lootItems = {1, 2, 3, 4, 5, 6, 7};
+    const std::array<std::pair<int, int>, 6> offsets = {
+        std::make_pair(-2, 0), std::make_pair(2, 0),   std::make_pair(0, -2),
+        std::make_pair(0, 2),  std::make_pair(-3, -1), std::make_pair(3, 1)};
+    int lootIndex = 0;
+    for (const auto& offset : offsets) {
+      int tileX = start.x + offset.first;
+      int tileY = start.y + offset.second;
+      if (!this->map->isWalkable(tileX, tileY)) {
+        continue;
+      }
+      Position lootPosition(tileX * TILE_SIZE, tileY * TILE_SIZE);
+      createLootEntity(*this->registry, *this->itemDatabase, lootPosition, lootItems[lootIndex],
+                       this->lootEntityIds, false);
+      lootIndex = (lootIndex + 1) % static_cast<int>(lootItems.size());
+    }
+  }
+
+  { // Spawn goblins inside spawn regions
+    this->respawnSystem->initialize(*this->map, *this->registry, this->mobEntityIds);
+    for (int mobEntityId : this->mobEntityIds) {
+      indexMob(mobEntityId);
+    }
+  }
+}
+
+Simulation::~Simulation() = default;
+
+std::uint64_t Simulation::computeStateHash() {
+  StateHasher hasher;
+  hasher.add(this->tick);
+  {
+    const TransformComponent& transform =
+        this->registry->getComponent<TransformComponent>(this->playerEntityId);
+    const HealthComponent& health =
+        this->registry->getComponent<HealthComponent>(this->playerEntityId);
+    const ManaComponent& mana = this->registry->getComponent<ManaComponent>(this->playerEntityId);
+    const LevelComponent& level =
+        this->registry->getComponent<LevelComponent>(this->playerEntityId);
+    const StatsComponent& stats =
+        this->registry->getComponent<StatsComponent>(this->playerEntityId);
+    const InventoryComponent& inventory =
+        this->registry->getComponent<InventoryComponent>(this->playerEntityId);
+    const EquipmentComponent& equipment =
+        this->registry->getComponent<EquipmentComponent>(this->playerEntityId);
+    const SkillTreeComponent& skillTree =
+        this->registry->getComponent<SkillTreeComponent>(this->playerEntityId);
+    hasher.addPosition(transform.position);
+    hasher.add(health.current);
+    hasher.add(mana.current);
+    hasher.add(level.level);
+    hasher.add(level.experience);
+    hasher.add(stats.gold);
+    // Panel commands show up here: stat points, what is carried and worn, and skill unlocks.
+    hasher.add(stats.unspentPoints);
+    hasher.add(stats.version);
+    hasher.add(inventory.items.size());
+    for (const ItemInstance& item : inventory.items) {
+      hasher.add(item.itemId);
+    }
+    hasher.add(equipment.version);
+    for (int slot = 0; slot <= static_cast<int>(ItemSlot::Cape); ++slot) {
+      auto equippedIt = equipment.equipped.find(static_cast<ItemSlot>(slot));
+      if (equippedIt != equipment.equipped.end()) {
+        hasher.add(slot);
+        hasher.add(equippedIt->second.itemId);
+      }
+    }
+    std::vector<int> unlockedSkills(skillTree.unlockedSkills.begin(),
+                                    skillTree.unlockedSkills.end());
+    std::sort(unlockedSkills.begin(), unlockedSkills.end());
+    hasher.add(unlockedSkills.size());
+    for (int skillId : unlockedSkills) {
+      hasher.add(skillId);
+    }
+    hasher.add(this->facingAngle);
+    hasher.add(this->attackCooldownRemaining);
+    hasher.add(this->playerGhost);
+  }
+  for (int mobEntityId : this->mobEntityIds) {
+    hasher.addPosition(this->registry->getComponent<TransformComponent>(mobEntityId).position);
+    hasher.add(this->registry->getComponent<HealthComponent>(mobEntityId).current);
+  }
+  hasher.add(this->lootEntityIds.size());
+  for (int lootEntityId : this->lootEntityIds) {
+    hasher.add(this->registry->getComponent<LootComponent>(lootEntityId).itemId);
+  }
+  for (int projectileEntityId : this->projectileEntityIds) {
+    hasher.addPosition(
+        this->registry->getComponent<TransformComponent>(projectileEntityId).position);
+  }
+  return hasher.value();
+}
+
+void Simulation::update(float dt, InputSource& inputSource) {
+  this->tick += 1;
+  this->registry->forEachComponent<TransformComponent>(
+      [](TransformComponent& transform) { transform.previousPosition = transform.position; });
+  if (this->attackCooldownRemaining > 0.0f) {
+    this->attackCooldownRemaining = std::max(0.0f, this->attackCooldownRemaining - dt);
+  }
+  if (this->playerKnockbackImmunityRemaining > 0.0f) {
+    this->playerKnockbackImmunityRemaining =
+        std::max(0.0f, this->playerKnockbackImmunityRemaining - dt);
+  }
+  this->playerHitFlashTimer = std::max(0.0f, this->playerHitFlashTimer - dt);
+  if (dt > 0.0f) {
+    this->tickSeconds = dt;
+  }
+  this->respawnSystem->update(dt, *this->map, *this->registry, this->mobEntityIds);
+  for (int mobEntityId : this->respawnSystem->getRespawnedEntityIds()) {
+    indexMob(mobEntityId);
+  }
+
+  const InputFrame frame = inputSource.nextFrame();
+  captureInput(frame);
+  for (const PanelCommand& command : frame.commands) {
+    applyPanelCommand(command);
+  }
+  processTimers();
+  updateSkillBarAndBuffs();
+  // Panel commands may have changed equipment or stats.
+  refreshPlayerDerivedStats();
+  updateLootPickup();
+  updateNpcInteraction();
+  updateAutoTargetAndFacing(dt);
+  updatePlayerAttack(dt);
+  updateStatusEffects();
+  updateSystems(std::make_pair(this->input.moveX, this->input.moveY), dt);
+  updateMobBehavior(dt);
+  updatePlayerDeathState();
+  updateRegionAndQuestState();
+  updateClassUnlockAndSelection();
+  this->itemSweeper.sweep(*this->itemDatabase, *this->registry, this->lootEntityIds,
+                          this->playerEntityId);
+}
+
+void Simulation::captureInput(const InputFrame& frame) {
+  InputState state;
+  state.moveX = frame.moveX;
+  state.moveY = frame.moveY;
+  state.pickupPressed = frame.isDown(InputButton::Pickup);
+  state.interactPressed = frame.isDown(InputButton::Interact);
+  state.debugPressed = frame.isDown(InputButton::Debug);
+  state.resurrectPressed = frame.isDown(InputButton::Resurrect);
+  state.questLogPressed = frame.isDown(InputButton::QuestLog);
+  state.acceptQuestPressed = frame.isDown(InputButton::AcceptQuest);
+  state.turnInQuestPressed = frame.isDown(InputButton::TurnInQuest);
+  state.questPrevPressed = frame.isDown(InputButton::QuestPrev);
+  state.questNextPressed = frame.isDown(InputButton::QuestNext);
+  state.classMenuPressed = frame.isDown(InputButton::ClassMenu);
+
+  for (std::size_t i = 0; i < state.skillPressed.size(); ++i) {
+    state.skillPressed[i] = frame.isDown(offsetButton(InputButton::Skill1, i));
+    state.skillJustPressed[i] = state.skillPressed[i] && !this->wasSkillPressed[i];
+    this->wasSkillPressed[i] = state.skillPressed[i];
+  }
+
+  for (std::size_t i = 0; i < state.classChoicePressed.size(); ++i) {
+    state.classChoicePressed[i] = frame.isDown(offsetButton(InputButton::ClassChoice1, i));
+    state.classChoiceJustPressed[i] =
+        state.classChoicePressed[i] && !this->wasClassChoicePressed[i];
+    this->wasClassChoicePressed[i] = state.classChoicePressed[i];
+  }
+
+  state.mouseX = frame.mouseX;
+  state.mouseY = frame.mouseY;
+  state.mousePressed = frame.mousePressed;
+  state.click = state.mousePressed && !this->wasMousePressed;
+  this->wasMousePressed = state.mousePressed;
+
+  state.pickupJustPressed = state.pickupPressed && !this->wasPickupPressed;
+  this->wasPickupPressed = state.pickupPressed;
+  state.interactJustPressed = state.interactPressed && !this->wasInteractPressed;
+  this->wasInteractPressed = state.interactPressed;
+  state.debugJustPressed = state.debugPressed && !this->wasDebugPressed;
+  this->wasDebugPressed = state.debugPressed;
+  state.resurrectJustPressed = state.resurrectPressed && !this->wasResurrectPressed;
+  this->wasResurrectPressed = state.resurrectPressed;
+  state.questLogJustPressed = state.questLogPressed && !this->wasQuestLogPressed;
+  this->wasQuestLogPressed = state.questLogPressed;
+  state.acceptQuestJustPressed = state.acceptQuestPressed && !this->wasAcceptQuestPressed;
+  this->wasAcceptQuestPressed = state.acceptQuestPressed;
+  state.turnInQuestJustPressed = state.turnInQuestPressed && !this->wasTurnInQuestPressed;
+  this->wasTurnInQuestPressed = state.turnInQuestPressed;
+  state.questPrevJustPressed = state.questPrevPressed && !this->wasQuestPrevPressed;
+  this->wasQuestPrevPressed = state.questPrevPressed;
+  state.questNextJustPressed = state.questNextPressed && !this->wasQuestNextPressed;
+  this->wasQuestNextPressed = state.questNextPressed;
+  state.classMenuJustPressed = state.classMenuPressed && !this->wasClassMenuPressed;
+  this->wasClassMenuPressed = state.classMenuPressed;
+
+  state.mouseWheelDelta = frame.mouseWheelDelta;
+  this->input = state;
+}
+
+// Commands were built from what the panels last showed, so each is checked against the state
+// now and dropped if it no longer applies.
+void Simulation::applyPanelCommand(const PanelCommand& command) {
+  InventoryComponent& inventory =
+      this->registry->getComponent<InventoryComponent>(this->playerEntityId);
+  EquipmentComponent& equipment =
+      this->registry->getComponent<EquipmentComponent>(this->playerEntityId);
+  StatsComponent& stats = this->registry->getComponent<StatsComponent>(this->playerEntityId);
+  switch (command.type) {
+  case PanelCommandType::EquipItem: {
+    if (command.value < 0) {
+      return;
+    }
+    const LevelComponent& level =
+        this->registry->getComponent<LevelComponent>(this->playerEntityId);
+    const ClassComponent& playerClass =
+        this->registry->getComponent<ClassComponent>(this->playerEntityId);
+    equipItemByIndex(inventory, equipment, *this->itemDatabase,
+                     static_cast<std::size_t>(command.value), level.level,
+                     playerClass.characterClass);
+    return;
+  }
+  case PanelCommandType::UnequipItem: {
+    auto it = equipment.equipped.find(static_cast<ItemSlot>(command.value));
+    if (it != equipment.equipped.end() && inventory.addItem(it->second)) {
+      equipment.equipped.erase(it);
+      equipment.version += 1;
+    }
+    return;
+  }
+  case PanelCommandType::BuyItem: {
+    if (!this->shopOpen || this->activeNpcId == -1) {
+      return;
+    }
+    const ShopComponent& shop = this->registry->getComponent<ShopComponent>(this->activeNpcId);
+    if (command.value < 0 || command.value >= static_cast<int>(shop.stock.size())) {
+      return;
+    }
+    const int itemId = shop.stock[static_cast<std::size_t>(command.value)];
+    const ItemDef* def = this->itemDatabase->getItem(itemId);
+    if (def && def->price > 0 && stats.gold >= def->price &&
+        inventory.addItem(ItemInstance{itemId})) {
+      stats.gold -= def->price;
+    }
+    return;
+  }
+  case PanelCommandType::SellItem: {
+    if (!this->shopOpen || command.value < 0 ||
+        command.value >= static_cast<int>(inventory.items.size())) {
+      return;
+    }
+    const std::size_t index = static_cast<std::size_t>(command.value);
+    const ItemDef* def = this->itemDatabase->getItem(inventory.items[index].itemId);
+    inventory.removeItemAt(index);
+    stats.gold += def ? sellPriceForItem(*def) : 0;
+    return;
+  }
+  case PanelCommandType::SpendStatPoint: {
+    if (stats.unspentPoints <= 0) {
+      return;
+    }
+    switch (command.value) {
+    case 0:
+      stats.strength += 1;
+      break;
+    case 1:
+      stats.dexterity += 1;
+      break;
+    case 2:
+      stats.intellect += 1;
+      break;
+    case 3:
+      stats.luck += 1;
+      break;
+    default:
+      return;
+    }
+    stats.unspentPoints -= 1;
+    stats.version += 1;
+    return;
+  }
+  case PanelCommandType::UnlockSkill: {
+    SkillTreeComponent& tree =
+        this->registry->getComponent<SkillTreeComponent>(this->playerEntityId);
+    const SkillNodeDef* node = this->skillTreeDefinition->getNode(command.value);
+    if (node && tree.unspentPoints > 0 && tree.unlockedSkills.count(node->id) == 0 &&
+        prerequisitesMet(tree.unlockedSkills, *node)) {
+      tree.unspentPoints -= 1;
+      tree.unlockedSkills.insert(node->id);
+    }
+    return;
+  }
+  }
+}
+
+void Simulation::updateNpcInteraction() {
+  const Position playerCenter = this->playerCenter();
+  const float rangeSquared = NPC_INTERACT_RANGE * NPC_INTERACT_RANGE;
+  int closestNpcId = -1;
+  float closestDist = rangeSquared;
+  for (int npcEntityId : this->npcEntityIds) {
+    const TransformComponent& npcTransform =
+        this->registry->getComponent<TransformComponent>(npcEntityId);
+    const CollisionComponent& npcCollision =
+        this->registry->getComponent<CollisionComponent>(npcEntityId);
+    const Position npcCenter = centerForEntity(npcTransform, npcCollision);
+    const float dist = squaredDistance(playerCenter, npcCenter);
+    if (dist <= closestDist) {
+      closestDist = dist;
+      closestNpcId = npcEntityId;
+    }
+  }
+  this->currentNpcId = closestNpcId;
+  if (this->activeNpcId != -1) {
+    const TransformComponent& activeTransform =
+        this->registry->getComponent<TransformComponent>(this->activeNpcId);
+    const CollisionComponent& activeCollision =
+        this->registry->getComponent<CollisionComponent>(this->activeNpcId);
+    const Position activeCenter = centerForEntity(activeTransform, activeCollision);
+    if (squaredDistance(playerCenter, activeCenter) > rangeSquared) {
+      this->activeNpcId = -1;
+      this->shopOpen = false;
+    }
+  }
+  if (this->input.interactJustPressed) {
+    if (this->activeNpcId != -1) {
+      this->activeNpcId = -1;
+      this->shopOpen = false;
+    } else if (this->currentNpcId != -1) {
+      this->activeNpcId = this->currentNpcId;
+      this->shopOpen = isShopNpc(this->activeNpcId, this->shopNpcIds);
+      this->activeNpcQuestSelection = 0;
+      QuestLogComponent& questLog =
+          this->registry->getComponent<QuestLogComponent>(this->playerEntityId);
+      StatsComponent& stats = this->registry->getComponent<StatsComponent>(this->playerEntityId);
+      LevelComponent& level = this->registry->getComponent<LevelComponent>(this->playerEntityId);
+      InventoryComponent& inventory =
+          this->registry->getComponent<InventoryComponent>(this->playerEntityId);
+      const NpcComponent& npc = this->registry->getComponent<NpcComponent>(this->activeNpcId);
+      const std::vector<std::string> turnedIn =
+          this->questSystem->tryTurnIn(npc.name, questLog, stats, level, inventory);
+      if (!turnedIn.empty()) {
+        const Position playerCenter = this->playerCenter();
+        for (const std::string& questName : turnedIn) {
+          this->eventBus->emitFloatingTextEvent(
+              FloatingTextEvent{"Completed: " + questName, playerCenter, FloatingTextKind::Info});
+        }
+      }
+    }
+  }
+  if (this->activeNpcId != -1 && !this->shopOpen && this->input.acceptQuestJustPressed) {
+    QuestLogComponent& questLog =
+        this->registry->getComponent<QuestLogComponent>(this->playerEntityId);
+    LevelComponent& level = this->registry->getComponent<LevelComponent>(this->playerEntityId);
+    const NpcComponent& npc = this->registry->getComponent<NpcComponent>(this->activeNpcId);
+    const std::vector<QuestEntry> entries =
+        buildNpcQuestEntries(npc.name, *this->questSystem, *this->questDatabase, questLog, level);
+    if (!entries.empty() && this->activeNpcQuestSelection >= 0 &&
+        this->activeNpcQuestSelection < static_cast<int>(entries.size()) &&
+        entries[this->activeNpcQuestSelection].type == QuestEntryType::Available) {
+      const QuestDef* def = entries[this->activeNpcQuestSelection].def;
+      if (def) {
+        this->questSystem->addQuest(questLog, level, def->id);
+        const Position playerCenter = this->playerCenter();
+        this->eventBus->emitFloatingTextEvent(
+            FloatingTextEvent{"Accepted: " + def->name, playerCenter, FloatingTextKind::Info});
+      }
+    }
+  }
+  if (this->activeNpcId != -1 && !this->shopOpen && this->input.turnInQuestJustPressed) {
+    QuestLogComponent& questLog =
+        this->registry->getComponent<QuestLogComponent>(this->playerEntityId);
+    StatsComponent& stats = this->registry->getComponent<StatsComponent>(this->playerEntityId);
+    LevelComponent& level = this->registry->getComponent<LevelComponent>(this->playerEntityId);
+    InventoryComponent& inventory =
+        this->registry->getComponent<InventoryComponent>(this->playerEntityId);
+    const NpcComponent& npc = this->registry->getComponent<NpcComponent>(this->activeNpcId);
+    const std::vector<QuestEntry> entries =
+        buildNpcQuestEntries(npc.name, *this->questSystem, *this->questDatabase, questLog, level);
+    if (!entries.empty() && this->activeNpcQuestSelection >= 0 &&
+        this->activeNpcQuestSelection < static_cast<int>(entries.size()) &&
+        entries[this->activeNpcQuestSelection].type == QuestEntryType::TurnIn) {
+      const QuestDef* def = entries[this->activeNpcQuestSelection].def;
+      if (def) {
+        const std::vector<std::string> turnedIn =
+            this->questSystem->tryTurnIn(npc.name, questLog, stats, level, inventory);
+        if (!turnedIn.empty()) {
+          const Position playerCenter = this->playerCenter();
+          for (const std::string& questName : turnedIn) {
+            this->eventBus->emitFloatingTextEvent(
+                FloatingTextEvent{"Completed: " + questName, playerCenter, FloatingTextKind::Info});
+          }
+        }
+      }
+    }
+  }
+  if (this->activeNpcId != -1 && !this->shopOpen &&
+      (this->input.questPrevJustPressed || this->input.questNextJustPressed)) {
+    QuestLogComponent& questLog =
+        this->registry->getComponent<QuestLogComponent>(this->playerEntityId);
+    LevelComponent& level = this->registry->getComponent<LevelComponent>(this->playerEntityId);
+    const NpcComponent& npc = this->registry->getComponent<NpcComponent>(this->activeNpcId);
+    const std::vector<QuestEntry> entries =
+        buildNpcQuestEntries(npc.name, *this->questSystem, *this->questDatabase, questLog, level);
+    if (!entries.empty()) {
+      const int count = static_cast<int>(entries.size());
+      if (this->input.questNextJustPressed) {
+        this->activeNpcQuestSelection = (this->activeNpcQuestSelection + 1) % count;
+      } else if (this->input.questPrevJustPressed) {
+        this->activeNpcQuestSelection = (this->activeNpcQuestSelection - 1 + count) % count;
+      }
+    } else {
+      this->activeNpcQuestSelection = 0;
+    }
+  }
+}
+
+void Simulation::updateAutoTargetAndFacing(float dt) {
+  if (this->playerGhost) {
+    this->currentAutoTargetId = -1;
+    return;
+  }
+
+  const AttackProfile& attackProfile =
+      this->registry->getComponent<DerivedStatsComponent>(this->playerEntityId).attackProfile;
+  const Position playerCenter = this->playerCenter();
+  const float range = attackProfile.range * AUTO_TARGET_RANGE_MULTIPLIER;
+  const float rangeSquared = range * range;
+  int closestMobId = -1;
+  float closestDist = rangeSquared;
+  Position closestCenter;
+  for (int mobEntityId : this->mobEntityIds) {
+    const HealthComponent& mobHealth = this->registry->getComponent<HealthComponent>(mobEntityId);
+    if (mobHealth.current <= 0) {
+      continue;
+    }
+    if (this->respawnSystem->isSpawning(mobEntityId)) {
+      continue;
+    }
+    const TransformComponent& mobTransform =
+        this->registry->getComponent<TransformComponent>(mobEntityId);
+    const Position mobCenter(mobTransform.position.x + (TILE_SIZE / 2.0f),
+                             mobTransform.position.y + (TILE_SIZE / 2.0f));
+    const float dist = squaredDistance(playerCenter, mobCenter);
+    if (dist <= closestDist) {
+      closestDist = dist;
+      closestMobId = mobEntityId;
+      closestCenter = mobCenter;
+    }
+  }
+
+  this->currentAutoTargetId = closestMobId;
+  float desiredAngle = this->facingAngle;
+  bool hasFacingTarget = false;
+  if (closestMobId != -1) {
+    desiredAngle = std::atan2(closestCenter.y - playerCenter.y, closestCenter.x - playerCenter.x);
+    hasFacingTarget = true;
+  } else if (this->input.moveX != 0 || this->input.moveY != 0) {
+    desiredAngle =
+        std::atan2(static_cast<float>(this->input.moveY), static_cast<float>(this->input.moveX));
+    hasFacingTarget = true;
+  }
+  if (hasFacingTarget) {
+    const float diff = shortestAngleDiff(this->facingAngle, desiredAngle);
+    const float maxStep = FACING_TURN_SPEED * dt;
+    if (std::abs(diff) <= maxStep) {
+      this->facingAngle = desiredAngle;
+    } else {
+      this->facingAngle += (diff > 0.0f ? maxStep : -maxStep);
+    }
+    this->facingX = std::cos(this->facingAngle);
+    this->facingY = std::sin(this->facingAngle);
+  }
+}
+
+void Simulation::updatePlayerAttack(float dt) {
+  auto applyPlayerDamageToMob = [&](int mobEntityId, int damage, bool isCrit,
+                                    const Position& hitPosition, const Position& fromPosition) {
+    if (damageMob(mobEntityId, damage, isCrit, hitPosition)) {
+      applyPushback(*this->registry, mobEntityId, fromPosition, PUSHBACK_DISTANCE,
+                    PUSHBACK_DURATION);
+    }
+  };
+
+  updateProjectiles(dt, *this->registry, *this->map, *this->respawnSystem,
+                    this->projectileEntityIds, this->playerEntityId,
+                    [&](int mobId, int damage, bool isCrit, int skillId,
+                        const Position& hitPosition, const Position& fromPosition) {
+                      const SkillDef* skill =
+                          skillId > 0 ? this->skillDatabase->getSkill(skillId) : nullptr;
+                      if (skill) {
+                        this->skillTargets.assign(1, mobId);
+                        applySkillEffects(*skill, this->skillTargets, fromPosition);
+                        return;
+                      }
+                      applyPlayerDamageToMob(mobId, damage, isCrit, hitPosition, fromPosition);
+                    });
+
+  if (this->playerGhost || this->attackCooldownRemaining > 0.0f) {
+    return;
+  }
+  if (this->currentAutoTargetId == -1) {
+    return;
+  }
+
+  const CollisionComponent& playerCollision =
+      this->registry->getComponent<CollisionComponent>(this->playerEntityId);
+  const StatsComponent& stats = this->registry->getComponent<StatsComponent>(this->playerEntityId);
+  const DerivedStatsComponent& derived =
+      this->registry->getComponent<DerivedStatsComponent>(this->playerEntityId);
+  const int attackPower = derived.attackPower;
+  const AttackProfile& attackProfile = derived.attackProfile;
+
+  const TransformComponent& mobTransform =
+      this->registry->getComponent<TransformComponent>(this->currentAutoTargetId);
+  const MobComponent& mob = this->registry->getComponent<MobComponent>(this->currentAutoTargetId);
+  const Position mobCenter(mobTransform.position.x + (TILE_SIZE / 2.0f),
+                           mobTransform.position.y + (TILE_SIZE / 2.0f));
+  const Position playerCenter = this->playerCenter();
+  const float rangeSquared = attackProfile.range * attackProfile.range;
+  if (squaredDistance(playerCenter, mobCenter) > rangeSquared) {
+    return;
+  }
+  const float hitChance = std::clamp(stats.accuracy - mobEvasionChance(mob), 0.2f, 0.99f);
+  if (this->rng.nextFloat() > hitChance) {
+    this->eventBus->emitFloatingTextEvent(
+        FloatingTextEvent{"Miss", mobCenter, FloatingTextKind::Info});
+    this->attackCooldownRemaining = attackProfile.cooldown;
+    return;
+  }
+  const bool isCrit = this->rng.nextFloat() <= derived.critChance;
+  const int attackDamage = isCrit ? static_cast<int>(std::round(static_cast<float>(attackPower) *
+                                                                derived.critMultiplier))
+                                  : attackPower;
+
+  if (attackProfile.isRanged) {
+    float dx = mobCenter.x - playerCenter.x;
+    float dy = mobCenter.y - playerCenter.y;
+    const float length = std::sqrt((dx * dx) + (dy * dy));
+    if (length > 0.001f) {
+      dx /= length;
+      dy /= length;
+      const float spawnOffset =
+          (playerCollision.width / 2.0f) + attackProfile.projectileRadius + 4.0f;
+      const Position spawnPosition(playerCenter.x + (dx * spawnOffset),
+                                   playerCenter.y + (dy * spawnOffset));
+      createProjectileEntity(*this->registry, spawnPosition, dx * attackProfile.projectileSpeed,
+                             dy * attackProfile.projectileSpeed, attackProfile.range,
+                             this->playerEntityId, this->currentAutoTargetId, attackDamage, isCrit,
+                             attackProfile.projectileRadius, attackProfile.projectileTrailLength,
+                             attackProfile.projectileColor, this->projectileEntityIds);
+      this->attackCooldownRemaining = attackProfile.cooldown;
+    }
+  } else {
+    applyPlayerDamageToMob(this->currentAutoTargetId, attackDamage, isCrit, mobCenter,
+                           playerCenter);
+    this->attackCooldownRemaining = attackProfile.cooldown;
+  }
+}
+
+// Returns false when the mob is already dead or still spawning in.
+bool Simulation::damageMob(int mobEntityId, int damage, bool isCrit, const Position& hitPosition) {
+  if (mobEntityId == -1) {
+    return false;
+  }
+  HealthComponent& mobHealth = this->registry->getComponent<HealthComponent>(mobEntityId);
+  if (mobHealth.current <= 0 || this->respawnSystem->isSpawning(mobEntityId)) {
+    return false;
+  }
+  mobHealth.current = std::max(0, mobHealth.current - damage);
+  this->eventBus->emitDamageEvent(
+      DamageEvent{this->playerEntityId, mobEntityId, damage, hitPosition});
+  this->eventBus->emitFloatingTextEvent(FloatingTextEvent{
+      {}, hitPosition, isCrit ? FloatingTextKind::CritDamage : FloatingTextKind::Damage, damage,
+      mobEntityId});
+  if (mobHealth.current == 0) {
+    handleMobKilled(mobEntityId, hitPosition);
+  }
+  return true;
+}
+
+// Credits the player with a mob that just reached zero health, whatever dealt the last hit.
+void Simulation::handleMobKilled(int mobEntityId, const Position& position) {
+  this->respawnSystem->onMobKilled(mobEntityId);
+  this->killedMobIds.push_back(mobEntityId);
+  LevelComponent& level = this->registry->getComponent<LevelComponent>(this->playerEntityId);
+  const ClassComponent& playerClass =
+      this->registry->getComponent<ClassComponent>(this->playerEntityId);
+  const MobComponent& mob = this->registry->getComponent<MobComponent>(mobEntityId);
+  this->eventBus->emitMobKilledEvent(MobKilledEvent{mob.type, mobEntityId});
+  level.experience += mob.stats->experience;
+  this->eventBus->emitFloatingTextEvent(
+      FloatingTextEvent{{}, position, FloatingTextKind::Info, mob.stats->experience, -1, "XP +"});
+  if (const EquipmentDropTable* dropTable =
+          this->mobDatabase->rollEquipmentDrop(mob.type, this->lootRng)) {
+    const int dropLevel = std::clamp(level.level, 1, PLAYER_LEVEL_CAP);
+    const int droppedItemId = this->itemDatabase->generateEquipmentDrop(
+        dropLevel, playerClass.characterClass, this->lootRng, *dropTable);
+    const TransformComponent& mobTransform =
+        this->registry->getComponent<TransformComponent>(mobEntityId);
+    scheduleLootDespawn(createLootEntity(*this->registry, *this->itemDatabase,
+                                         mobTransform.position, droppedItemId,
+                                         this->lootEntityIds));
+  }
+  GraphicComponent& mobGraphic = this->registry->getComponent<GraphicComponent>(mobEntityId);
+  mobGraphic.color = Color{80, 80, 80, 255};
+}
+
+void Simulation::updateStatusEffects() {
+  this->statusEffects.clear(std::move(this->killedMobIds));
+  this->killedMobIds.clear();
+  this->statusEffects.update();
+  // Every damage and heal pulse of the tick lands here, in one pass.
+  for (const StatusHealthChange& change : this->statusEffects.getHealthChanges()) {
+    HealthComponent& health = this->registry->getComponent<HealthComponent>(change.entityId);
+    if (health.current <= 0 || this->respawnSystem->isSpawning(change.entityId)) {
+      continue;
+    }
+    const Position center =
+        centerForEntity(this->registry->getComponent<TransformComponent>(change.entityId),
+                        this->registry->getComponent<CollisionComponent>(change.entityId));
+    if (change.amount < 0) {
+      const int damage = -change.amount;
+      health.current = std::max(0, health.current - damage);
+      this->eventBus->emitFloatingTextEvent(FloatingTextEvent{
+          {}, center, FloatingTextKind::Damage, damage, change.entityId});
+      if (health.current == 0 && change.entityId != this->playerEntityId) {
+        handleMobKilled(change.entityId, center);
+      }
+      continue;
+    }
+    const int healed = std::min(change.amount, health.max - health.current);
+    if (healed > 0) {
+      health.current += healed;
+      this->eventBus->emitFloatingTextEvent(FloatingTextEvent{
+          {}, center, FloatingTextKind::Heal, healed, change.entityId, "+"});
+    }
+  }
+}
+
+bool Simulation::castSkill(const SkillDef& skill) {
+  const Position origin = this->playerCenter();
+  this->skillTargets.clear();
+  switch (skill.targeting.shape) {
+  case SkillTargetShape::Self:
+    break;
+  case SkillTargetShape::Projectile: {
+    const int targetId = this->currentAutoTargetId;
+    if (targetId == -1) {
+      return false;
+    }
+    const Position targetCenter =
+        centerForEntity(this->registry->getComponent<TransformComponent>(targetId),
+                        this->registry->getComponent<CollisionComponent>(targetId));
+    float dx = targetCenter.x - origin.x;
+    float dy = targetCenter.y - origin.y;
+    const float length = std::sqrt((dx * dx) + (dy * dy));
+    if (length <= 0.001f) {
+      return false;
+    }
+    dx /= length;
+    dy /= length;
+    const float speed = skill.targeting.projectileSpeed;
+    // Damage stays zero: the skill's effects are resolved when the projectile lands.
+    const int projectileId = createProjectileEntity(
+        *this->registry, origin, dx * speed, dy * speed, skill.targeting.range,
+        this->playerEntityId, targetId, 0, false, SKILL_PROJECTILE_RADIUS,
+        SKILL_PROJECTILE_TRAIL_LENGTH, SKILL_PROJECTILE_COLOR, this->projectileEntityIds);
+    this->registry->getComponent<ProjectileComponent>(projectileId).skillId = skill.id;
+    return true;
+  }
+  case SkillTargetShape::Circle:
+  case SkillTargetShape::Cone:
+  case SkillTargetShape::Line: {
+    const SkillAreaBounds bounds =
+        skillAreaBounds(skill.targeting, origin, this->facingX, this->facingY);
+    this->skillCandidates.clear();
+    this->mobGrid.query(bounds.x, bounds.y, bounds.width, bounds.height, this->skillCandidates);
+    for (int mobEntityId : this->skillCandidates) {
+      if (this->registry->getComponent<HealthComponent>(mobEntityId).current <= 0 ||
+          this->respawnSystem->isSpawning(mobEntityId)) {
+        continue;
+      }
+      const Position mobCenter =
+          centerForEntity(this->registry->getComponent<TransformComponent>(mobEntityId),
+                          this->registry->getComponent<CollisionComponent>(mobEntityId));
+      if (isInSkillArea(skill.targeting, origin, this->facingX, this->facingY, mobCenter)) {
+        this->skillTargets.push_back(mobEntityId);
+      }
+    }
+    break;
+  }
+  }
+  applySkillEffects(skill, this->skillTargets, origin);
+  return true;
+}
+
+void Simulation::indexMob(int mobEntityId) {
+  const Position mobCenter =
+      centerForEntity(this->registry->getComponent<TransformComponent>(mobEntityId),
+                      this->registry->getComponent<CollisionComponent>(mobEntityId));
+  this->mobGrid.update(mobEntityId, mobCenter.x, mobCenter.y);
+}
+
+// Runs each effect over the whole hit list in turn, so a wide area is one pass per effect.
+void Simulation::applySkillEffects(const SkillDef& skill, const std::vector<int>& targets,
+                                   const Position& origin) {
+  const DerivedStatsComponent& derived =
+      this->registry->getComponent<DerivedStatsComponent>(this->playerEntityId);
+  const bool onCaster = skill.targeting.shape == SkillTargetShape::Self;
+  for (const SkillEffect& effect : skill.effects) {
+    const int amount = resolveSkillEffectAmount(effect, derived);
+    switch (effect.type) {
+    case SkillEffectType::Damage:
+      for (int mobEntityId : targets) {
+        const Position mobCenter =
+            centerForEntity(this->registry->getComponent<TransformComponent>(mobEntityId),
+                            this->registry->getComponent<CollisionComponent>(mobEntityId));
+        damageMob(mobEntityId, amount, false, mobCenter);
+      }
+      break;
+    case SkillEffectType::Knockback:
+      for (int mobEntityId : targets) {
+        if (this->registry->getComponent<HealthComponent>(mobEntityId).current > 0) {
+          applyPushback(*this->registry, mobEntityId, origin, static_cast<float>(amount),
+                        PUSHBACK_DURATION);
+        }
+      }
+      break;
+    case SkillEffectType::Status: {
+      const StatusEffectDef* status = this->statusEffectDatabase->getEffect(effect.statusEffectId);
+      if (!status) {
+        break;
+      }
+      const float power = static_cast<float>(derived.attackPower);
+      if (onCaster) {
+        this->statusEffects.apply(this->playerEntityId, *status, power, this->tickSeconds);
+        break;
+      }
+      for (int mobEntityId : targets) {
+        if (this->registry->getComponent<HealthComponent>(mobEntityId).current > 0) {
+          this->statusEffects.apply(mobEntityId, *status, power, this->tickSeconds);
+        }
+      }
+      break;
+    }
+    case SkillEffectType::Heal: {
+      HealthComponent& health =
+          this->registry->getComponent<HealthComponent>(this->playerEntityId);
+      const int healed = std::min(amount, health.max - health.current);
+      if (healed > 0) {
+        health.current += healed;
+        this->eventBus->emitFloatingTextEvent(FloatingTextEvent{
+            {}, this->playerCenter(), FloatingTextKind::Heal, healed, this->playerEntityId, "+"});
+      }
+      break;
+    }
+    }
+  }
+}
+
+void Simulation::updateMobBehavior(float dt) {
+  const Position playerCenter = this->playerCenter();
+  const HealthComponent& playerHealth =
+      this->registry->getComponent<HealthComponent>(this->playerEntityId);
+
+  MobThinkContext context;
+  context.playerPosition =
+      this->registry->getComponent<TransformComponent>(this->playerEntityId).position;
+  context.playerCenter = playerCenter;
+  context.playerTileX = static_cast<int>(playerCenter.x / TILE_SIZE);
+  context.playerTileY = static_cast<int>(playerCenter.y / TILE_SIZE);
+  context.playerAlive = !this->playerGhost && playerHealth.current > 0;
+  context.dt = dt;
+
+  // Component lookups go through the registry's maps, so they stay on this thread.
+  this->mobAiEntries.clear();
+  for (int mobEntityId : this->mobEntityIds) {
+    HealthComponent& mobHealth = this->registry->getComponent<HealthComponent>(mobEntityId);
+    if (mobHealth.current <= 0) {
+      // A corpse can still slide out its pushback, which updateSystems has applied by now.
+      indexMob(mobEntityId);
+      continue;
+    }
+    if (this->respawnSystem->isSpawning(mobEntityId)) {
+      continue;
+    }
+    this->mobAiEntries.push_back(
+        MobAiEntry{mobEntityId, &this->registry->getComponent<MobComponent>(mobEntityId),
+                   &this->registry->getComponent<TransformComponent>(mobEntityId),
+                   &this->registry->getComponent<CollisionComponent>(mobEntityId), &mobHealth});
+  }
+
+  // Think and move: each mob touches only its own components, so chunks run on any thread.
+  const std::size_t chunkCount =
+      (this->mobAiEntries.size() + MOB_AI_CHUNK_SIZE - 1) / MOB_AI_CHUNK_SIZE;
+  if (this->mobAiChunks.size() < chunkCount) {
+    this->mobAiChunks.resize(chunkCount);
+  }
+  const std::function<void(std::size_t)> thinkChunk = [this, &context](std::size_t chunk) {
+    MobAiChunk& output = this->mobAiChunks[chunk];
+    output.attacks.clear();
+    output.lodCounts = MobLodCounts{};
+    const std::size_t begin = chunk * MOB_AI_CHUNK_SIZE;
+    const std::size_t end = std::min(begin + MOB_AI_CHUNK_SIZE, this->mobAiEntries.size());
+    for (std::size_t i = begin; i < end; ++i) {
+      thinkMob(this->mobAiEntries[i], context, output);
+    }
+  };
+  if (this->aiWorkers && chunkCount > 1) {
+    this->aiWorkers->run(chunkCount, thinkChunk);
+  } else {
+    for (std::size_t chunk = 0; chunk < chunkCount; ++chunk) {
+      thinkChunk(chunk);
+    }
+  }
+
+  // Resolve: attacks land in mob order whatever thread queued them, and all combat rolls draw
+  // from the one combat stream here, so thread count never changes the outcome.
+  this->mobLodCounts = MobLodCounts{};
+  for (std::size_t chunk = 0; chunk < chunkCount; ++chunk) {
+    const MobAiChunk& output = this->mobAiChunks[chunk];
+    this->mobLodCounts.active += output.lodCounts.active;
+    this->mobLodCounts.reduced += output.lodCounts.reduced;
+    this->mobLodCounts.sleeping += output.lodCounts.sleeping;
+    for (const MobAttack& attack : output.attacks) {
+      resolveMobAttack(attack, playerCenter);
+    }
+  }
+
+  // Pushback and this tick's moves are final now; most mobs stay in their cell.
+  for (const MobAiEntry& entry : this->mobAiEntries) {
+    const Position mobCenter = centerForEntity(*entry.transform, *entry.collision);
+    this->mobGrid.update(entry.entityId, mobCenter.x, mobCenter.y);
+  }
+}
+
+void Simulation::thinkMob(const MobAiEntry& entry, const MobThinkContext& context,
+                          MobAiChunk& output) const {
+  MobComponent& mob = *entry.mob;
+  const MobResolvedStats& mobStats = *mob.stats;
+  TransformComponent& mobTransform = *entry.transform;
+  const CollisionComponent& mobCollision = *entry.collision;
+  const Position& playerCenter = context.playerCenter;
+  const Position mobCenter = centerForEntity(mobTransform, mobCollision);
+  const bool playerInRegion = context.playerTileX >= mob.regionX &&
+                              context.playerTileX < mob.regionX + mob.regionWidth &&
+                              context.playerTileY >= mob.regionY &&
+                              context.playerTileY < mob.regionY + mob.regionHeight;
+  const float distToPlayer = squaredDistance(mobCenter, playerCenter);
+
+  const float activeRadius =
+      std::max({MOB_ACTIVE_RADIUS, mobStats.aggroRange, mobStats.attackRange}) + TILE_SIZE;
+  // Stunned and slowed mobs stay at full rate: the catch-up walk below moves at base speed, so it
+  // only ever repays time the mob spent unaffected.
+  if (!playerInRegion && distToPlayer > activeRadius * activeRadius &&
+      !this->statusEffects.affectsMovement(entry.entityId)) {
+    mob.deferredSeconds += context.dt;
+    if (distToPlayer > MOB_REDUCED_RADIUS * MOB_REDUCED_RADIUS) {
+      output.lodCounts.sleeping += 1;
+    } else {
+      output.lodCounts.reduced += 1;
+      // Staggered by id so the reduced mobs spread over the interval instead of bunching.
+      if ((this->tick + static_cast<std::uint64_t>(entry.entityId)) % MOB_REDUCED_INTERVAL == 0) {
+        settleIdleMob(*this->map, mob, mobTransform, mobCollision, mob.deferredSeconds,
+                      context.dt);
+        mob.deferredSeconds = 0.0f;
+      }
+    }
+    return;
+  }
+  output.lodCounts.active += 1;
+  if (mob.deferredSeconds > 0.0f) {
+    settleIdleMob(*this->map, mob, mobTransform, mobCollision, mob.deferredSeconds,
+                  context.dt);
+    mob.deferredSeconds = 0.0f;
+  }
+  if (this->statusEffects.isStunned(entry.entityId)) {
+    return;
+  }
+
+  const Position homePosition = mobHomePosition(mob);
+  const Position homeCenter = mobHomeCenter(mob, mobCollision);
+  const float distToHome = squaredDistance(mobCenter, homeCenter);
+
+  const bool pursuingPlayer = context.playerAlive && playerInRegion &&
+                              distToPlayer <= (mobStats.aggroRange * mobStats.aggroRange);
+  std::optional<Position> target;
+  if (pursuingPlayer) {
+    const float preferredRange = std::max(16.0f, mobStats.preferredRange);
+    const float preferredRangeSquared = preferredRange * preferredRange;
+    const float retreatRangeSquared = (preferredRange * 0.65f) * (preferredRange * 0.65f);
+    switch (mobStats.behavior) {
+    case MobBehaviorType::Ranged:
+    case MobBehaviorType::Caster:
+    case MobBehaviorType::Skirmisher:
+      if (distToPlayer < retreatRangeSquared) {
+        target = retreatTarget(mobCenter, playerCenter, mobTransform.position.x,
+                               mobTransform.position.y);
+      } else if (distToPlayer > preferredRangeSquared) {
+        target = context.playerPosition;
+      }
+      break;
+    case MobBehaviorType::Melee:
+    case MobBehaviorType::Bruiser:
+      target = context.playerPosition;
+      break;
+    }
+  } else if (distToHome > MOB_HOME_RADIUS_SQUARED) {
+    target = homePosition;
+  }
+
+  if (target.has_value()) {
+    float movementSpeed = mobStats.speed * this->statusEffects.speedMultiplier(entry.entityId);
+    if (pursuingPlayer && mobStats.behavior == MobBehaviorType::Bruiser &&
+        distToPlayer > (mobStats.attackRange * mobStats.attackRange)) {
+      movementSpeed *= 1.08f;
+    }
+    moveEntityToward(*this->map, mobTransform, mobCollision, movementSpeed, *target, context.dt);
+  }
+
+  if (this->tick >= mob.attackReadyTick && context.playerAlive &&
+      distToPlayer <= mobStats.attackRange * mobStats.attackRange) {
+    output.attacks.push_back(
+        MobAttack{entry.entityId, entry.mob, entry.health, mobCenter, distToPlayer});
+  }
+}
+
+void Simulation::resolveMobAttack(const MobAttack& attack, const Position& playerCenter) {
+  HealthComponent& playerHealth =
+      this->registry->getComponent<HealthComponent>(this->playerEntityId);
+  // An earlier attacker this tick may already have killed the player.
+  if (playerHealth.current <= 0) {
+    return;
+  }
+  const LevelComponent& playerLevel =
+      this->registry->getComponent<LevelComponent>(this->playerEntityId);
+  const StatsComponent& playerStats =
+      this->registry->getComponent<StatsComponent>(this->playerEntityId);
+  const DerivedStatsComponent& playerDerived =
+      this->registry->getComponent<DerivedStatsComponent>(this->playerEntityId);
+  const int mobEntityId = attack.mobEntityId;
+  MobComponent& mob = *attack.mob;
+  const MobResolvedStats& mobStats = *mob.stats;
+  HealthComponent& mobHealth = *attack.health;
+  const Position& mobCenter = attack.mobCenter;
+  const float distToPlayer = attack.distToPlayer;
+
+  const float levelPenalty =
+      std::max(0.0f, static_cast<float>(mobStats.level - playerLevel.level) * 0.004f);
+  const float parryChance = std::clamp(playerStats.parry - levelPenalty, 0.0f, 0.30f);
+  const float dodgeChance =
+      std::clamp(playerStats.dodge - (levelPenalty * 1.25f), 0.0f, 0.45f);
+  const float avoidRoll = this->rng.nextFloat();
+  if (avoidRoll <= parryChance) {
+    this->eventBus->emitFloatingTextEvent(
+        FloatingTextEvent{"Parry", playerCenter, FloatingTextKind::Info});
+    mob.attackReadyTick = this->tick + ticksForSeconds(mobStats.attackCooldown, this->tickSeconds);
+    return;
+  }
+  if (avoidRoll <= parryChance + dodgeChance) {
+    this->eventBus->emitFloatingTextEvent(
+        FloatingTextEvent{"Dodge", playerCenter, FloatingTextKind::Info});
+    mob.attackReadyTick = this->tick + ticksForSeconds(mobStats.attackCooldown, this->tickSeconds);
+    return;
+  }
+
+  int rawDamage = mobStats.attackDamage;
+  const float damageMultiplier = this->statusEffects.damageMultiplier(mobEntityId);
+  if (damageMultiplier != 1.0f) {
+    rawDamage = std::max(1, static_cast<int>(std::round(rawDamage * damageMultiplier)));
+  }
+  float mitigationMultiplier = 1.0f;
+  float knockbackMultiplier = 1.0f;
+  int healOnHit = 0;
+  const char* abilityLabel = nullptr;
+  if (this->tick >= mob.abilityReadyTick) {
+    const std::uint64_t abilityReadyTick =
+        this->tick + ticksForSeconds(mobStats.abilityCooldown, this->tickSeconds);
+    switch (mobStats.abilityType) {
+    case MobAbilityType::GoblinRage:
+      if ((mobHealth.current * 10) <= (mobHealth.max * 6)) {
+        rawDamage = std::max(
+            1, static_cast<int>(std::round(rawDamage * (1.0f + mobStats.abilityValue))));
+        abilityLabel = "Rage";
+        mob.abilityReadyTick = abilityReadyTick;
+      }
+      break;
+    case MobAbilityType::UndeadDrain:
+      healOnHit = std::max(
+          1, static_cast<int>(std::round(rawDamage * std::max(0.12f, mobStats.abilityValue))));
+      abilityLabel = "Drain";
+      mob.abilityReadyTick = abilityReadyTick;
+      break;
+    case MobAbilityType::BeastPounce:
+      if (distToPlayer > (mobStats.attackRange * mobStats.attackRange * 1.2f)) {
+        rawDamage = std::max(
+            1, static_cast<int>(std::round(rawDamage * (1.0f + mobStats.abilityValue))));
+        knockbackMultiplier = 1.5f;
+        abilityLabel = "Pounce";
+        mob.abilityReadyTick = abilityReadyTick;
+      }
+      break;
+    case MobAbilityType::BanditTrick:
+      if (CounterRng(this->worldSeed, RngPurpose::MobAbility,
+                     static_cast<std::uint32_t>(mobEntityId), this->tick)
+              .nextFloat() <= mobStats.abilityValue) {
+        rawDamage = std::max(
+            1, static_cast<int>(std::round(rawDamage * (1.0f + mobStats.abilityValue))));
+        abilityLabel = "Trick";
+        mob.abilityReadyTick = abilityReadyTick;
+      }
+      break;
+    case MobAbilityType::ArcaneSurge:
+      mitigationMultiplier = std::clamp(1.0f - mobStats.abilityValue, 0.35f, 1.0f);
+      rawDamage += std::max(1, mobStats.level / 5);
+      abilityLabel = "Surge";
+      mob.abilityReadyTick = abilityReadyTick;
+      break;
+    case MobAbilityType::None:
+      break;
+    }
+  }
+
+  const int armor = playerDerived.armor;
+  const float mitigation =
+      std::clamp(static_cast<float>(armor) / (100.0f + static_cast<float>(armor)), 0.0f,
+                 0.60f) *
+      mitigationMultiplier;
+  const int damageTaken =
+      std::max(1, static_cast<int>(std::round(rawDamage * (1.0f - mitigation))));
+  playerHealth.current = std::max(0, playerHealth.current - damageTaken);
+  this->eventBus->emitDamageEvent(
+      DamageEvent{mobEntityId, this->playerEntityId, damageTaken, playerCenter});
+  this->eventBus->emitFloatingTextEvent(
+      FloatingTextEvent{{}, playerCenter, FloatingTextKind::Damage, damageTaken,
+                        this->playerEntityId, "-"});
+  if (abilityLabel) {
+    this->eventBus->emitFloatingTextEvent(
+        FloatingTextEvent{abilityLabel, mobCenter, FloatingTextKind::Info});
+  }
+  if (healOnHit > 0) {
+    const int healed = std::min(healOnHit, mobHealth.max - mobHealth.current);
+    if (healed > 0) {
+      mobHealth.current += healed;
+      this->eventBus->emitFloatingTextEvent(FloatingTextEvent{
+          {}, mobCenter, FloatingTextKind::Heal, healed, mobEntityId, "+"});
+    }
+  }
+  if (this->playerKnockbackImmunityRemaining <= 0.0f) {
+    applyPushback(*this->registry, this->playerEntityId, mobCenter,
+                  PUSHBACK_DISTANCE * knockbackMultiplier, PUSHBACK_DURATION);
+    this->playerKnockbackImmunityRemaining = PLAYER_KNOCKBACK_IMMUNITY_SECONDS;
+  }
+  this->playerHitFlashTimer = 0.2f;
+  mob.attackReadyTick = this->tick + ticksForSeconds(mobStats.attackCooldown, this->tickSeconds);
+}
+
+void Simulation::updatePlayerDeathState() {
+  TransformComponent& playerTransform =
+      this->registry->getComponent<TransformComponent>(this->playerEntityId);
+  const CollisionComponent& playerCollision =
+      this->registry->getComponent<CollisionComponent>(this->playerEntityId);
+  GraphicComponent& playerGraphic =
+      this->registry->getComponent<GraphicComponent>(this->playerEntityId);
+  HealthComponent& playerHealth =
+      this->registry->getComponent<HealthComponent>(this->playerEntityId);
+  const Position playerCenter = this->playerCenter();
+
+  if (!this->playerGhost && playerHealth.current <= 0) {
+    this->playerGhost = true;
+    this->hasCorpse = true;
+    this->corpsePosition = playerTransform.position;
+    playerGraphic.color = Color{160, 200, 255, 180};
+    this->eventBus->emitFloatingTextEvent(
+        FloatingTextEvent{"You died", playerCenter, FloatingTextKind::Info});
+  }
+
+  if (this->playerGhost && this->hasCorpse) {
+    const Position corpseCenter(this->corpsePosition.x + (playerCollision.width / 2.0f),
+                                this->corpsePosition.y + (playerCollision.height / 2.0f));
+    const float distToCorpse = squaredDistance(playerCenter, corpseCenter);
+    if (distToCorpse <= (RESURRECT_RANGE * RESURRECT_RANGE) && this->input.resurrectJustPressed) {
+      this->playerGhost = false;
+      this->hasCorpse = false;
+      playerHealth.current = playerHealth.max;
+      playerGraphic.color = Color{240, 240, 240, 255};
+      this->playerKnockbackImmunityRemaining = 0.0f;
+      this->eventBus->emitFloatingTextEvent(
+          FloatingTextEvent{"Resurrected", playerCenter, FloatingTextKind::Info});
+    }
+  }
+}
+
+void Simulation::updateRegionAndQuestState() {
+  const Position playerCenter = this->playerCenter();
+  const int playerTileX = static_cast<int>(playerCenter.x / TILE_SIZE);
+  const int playerTileY = static_cast<int>(playerCenter.y / TILE_SIZE);
+  const int currentRegionIndex = regionIndexAt(*this->map, playerTileX, playerTileY);
+  if (currentRegionIndex != this->lastRegionIndex) {
+    if (this->lastRegionIndex >= 0) {
+      const Region& previousRegion = this->map->getRegions()[this->lastRegionIndex];
+      this->eventBus->emitRegionEvent(
+          RegionEvent{RegionTransition::Leave, regionName(previousRegion.type), playerCenter});
+    }
+    if (currentRegionIndex >= 0) {
+      const Region& currentRegion = this->map->getRegions()[currentRegionIndex];
+      this->eventBus->emitRegionEvent(
+          RegionEvent{RegionTransition::Enter, regionName(currentRegion.type), playerCenter});
+    }
+    this->lastRegionIndex = currentRegionIndex;
+  }
+  QuestLogComponent& questLog =
+      this->registry->getComponent<QuestLogComponent>(this->playerEntityId);
+  StatsComponent& stats = this->registry->getComponent<StatsComponent>(this->playerEntityId);
+  LevelComponent& level = this->registry->getComponent<LevelComponent>(this->playerEntityId);
+  InventoryComponent& inventory =
+      this->registry->getComponent<InventoryComponent>(this->playerEntityId);
+  this->questSystem->update(*this->eventBus, questLog, stats, level, inventory);
+  SkillTreeComponent& skillTree =
+      this->registry->getComponent<SkillTreeComponent>(this->playerEntityId);
+  applyLevelUps(level, stats, skillTree);
+  refreshPlayerDerivedStats();
+}
+
+void Simulation::applyClassSelection(CharacterClass selectedClass) {
+  if (selectedClass == CharacterClass::Any) {
+    return;
+  }
+
+  InventoryComponent& inventory =
+      this->registry->getComponent<InventoryComponent>(this->playerEntityId);
+  EquipmentComponent& equipment =
+      this->registry->getComponent<EquipmentComponent>(this->playerEntityId);
+  StatsComponent& stats = this->registry->getComponent<StatsComponent>(this->playerEntityId);
+  HealthComponent& health = this->registry->getComponent<HealthComponent>(this->playerEntityId);
+  ManaComponent& mana = this->registry->getComponent<ManaComponent>(this->playerEntityId);
+  const LevelComponent& level = this->registry->getComponent<LevelComponent>(this->playerEntityId);
+  ClassComponent& playerClass = this->registry->getComponent<ClassComponent>(this->playerEntityId);
+  const ClassDefaults defaults = classDefaultsFor(selectedClass);
+  playerClass.characterClass = selectedClass;
+  stats.baseAttackPower = defaults.baseAttackPower;
+  stats.baseArmor = defaults.baseArmor;
+  stats.strength = std::max(stats.strength, defaults.strength);
+  stats.dexterity = std::max(stats.dexterity, defaults.dexterity);
+  stats.intellect = std::max(stats.intellect, defaults.intellect);
+  stats.luck = std::max(stats.luck, defaults.luck);
+  stats.version += 1;
+  health.max = std::max(health.max, defaults.health);
+  health.current = health.max;
+  mana.max = std::max(mana.max, defaults.mana);
+  mana.current = mana.max;
+
+  auto grantAndAutoEquip = [&](int itemId) {
+    if (itemId <= 0) {
+      return;
+    }
+    ItemInstance starter{itemId};
+    if (!inventory.addItem(starter)) {
+      return;
+    }
+    equipItemByIndex(inventory, equipment, *this->itemDatabase, inventory.items.size() - 1,
+                     level.level, selectedClass);
+  };
+  grantAndAutoEquip(defaults.weaponId);
+  grantAndAutoEquip(defaults.offhandId);
+  refreshPlayerDerivedStats();
+
+  this->eventBus->emitFloatingTextEvent(
+      FloatingTextEvent{"Class selected: " + std::string(className(selectedClass)),
+                        this->playerCenter(), FloatingTextKind::Info});
+}
+
+void Simulation::updateClassUnlockAndSelection() {
+  const LevelComponent& level = this->registry->getComponent<LevelComponent>(this->playerEntityId);
+  const ClassComponent& playerClass =
+      this->registry->getComponent<ClassComponent>(this->playerEntityId);
+  if (playerClass.characterClass != CharacterClass::Any) {
+    this->classSelectionVisible = false;
+    return;
+  }
+  if (level.level < 10) {
+    return;
+  }
+
+  if (!this->classUnlockAnnounced) {
+    this->classUnlockAnnounced = true;
+    this->classSelectionVisible = true;
+    this->eventBus->emitFloatingTextEvent(FloatingTextEvent{
+        "Class unlocked! Press K to choose.", this->playerCenter(), FloatingTextKind::Info});
+  }
+
+  if (this->input.classMenuJustPressed) {
+    this->classSelectionVisible = !this->classSelectionVisible;
+  }
+  if (!this->classSelectionVisible) {
+    return;
+  }
+
+  for (std::size_t i = 0; i < CLASS_UNLOCK_CHOICES.size(); ++i) {
+    if (this->input.classChoiceJustPressed[i]) {
+      applyClassSelection(CLASS_UNLOCK_CHOICES[i]);
+      this->classSelectionVisible = false;
+      return;
+    }
+  }
+}
+
+void Simulation::updateSystems(const std::pair<int, int>& movementInput, float dt) {
+  // TODO: Refactor system iteration based on whether update or render is needed.
+  for (auto it = this->registry->systemsBegin(); it != this->registry->systemsEnd(); ++it) {
+    MovementSystem* movementSystem = dynamic_cast<MovementSystem*>((*it).get());
+    if (movementSystem) {
+      movementSystem->update(movementInput, dt, *this->map);
+    }
+    PushbackSystem* pushbackSystem = dynamic_cast<PushbackSystem*>((*it).get());
+    if (pushbackSystem) {
+      pushbackSystem->update(dt, *this->map);
+    }
+  }
+}
+
+void Simulation::updateLootPickup() {
+  if (this->playerGhost || !this->input.pickupJustPressed) {
+    return;
+  }
+
+  InventoryComponent& inventory =
+      this->registry->getComponent<InventoryComponent>(this->playerEntityId);
+  const TransformComponent& playerTransform =
+      this->registry->getComponent<TransformComponent>(this->playerEntityId);
+  const CollisionComponent& playerCollision =
+      this->registry->getComponent<CollisionComponent>(this->playerEntityId);
+  const Position playerCenter = this->playerCenter();
+  const float pickupRangeSquared = LOOT_PICKUP_RANGE * LOOT_PICKUP_RANGE;
+
+  int closestLootId = -1;
+  float closestDist = pickupRangeSquared;
+  for (int lootId : this->lootEntityIds) {
+    const TransformComponent& lootTransform =
+        this->registry->getComponent<TransformComponent>(lootId);
+    const Position lootCenter(lootTransform.position.x + (TILE_SIZE / 2.0f),
+                              lootTransform.position.y + (TILE_SIZE / 2.0f));
+    const float dist = squaredDistance(playerCenter, lootCenter);
+    if (dist <= closestDist) {
+      closestDist = dist;
+      closestLootId = lootId;
+    }
+  }
+
+  if (closestLootId == -1) {
+    return;
+  }
+
+  LootComponent& loot = this->registry->getComponent<LootComponent>(closestLootId);
+  ItemInstance item{loot.itemId};
+  if (!inventory.addItem(item)) {
+    return;
+  }
+  const ItemDef* def = this->itemDatabase->getItem(item.itemId);
+  std::string name = def ? this->itemDatabase->itemName(*def) : "Item";
+  this->eventBus->emitItemPickupEvent(ItemPickupEvent{item.itemId, 1});
+  this->eventBus->emitFloatingTextEvent(
+      FloatingTextEvent{"Picked up " + name, playerCenter, FloatingTextKind::Info});
+  this->timers.cancel(loot.despawnTimer);
+  loot.despawnTimer = NO_TIMER;
+  GraphicComponent& graphic = this->registry->getComponent<GraphicComponent>(closestLootId);
+  graphic.color = Color{0, 0, 0, 0};
+  TransformComponent& transform = this->registry->getComponent<TransformComponent>(closestLootId);
+  transform.position = Position(-1000.0f, -1000.0f);
+  this->lootEntityIds.erase(
+      std::remove(this->lootEntityIds.begin(), this->lootEntityIds.end(), closestLootId),
+      this->lootEntityIds.end());
+}
+
+void Simulation::updateSkillBarAndBuffs() {
+  SkillBarComponent& skills = this->registry->getComponent<SkillBarComponent>(this->playerEntityId);
+  BuffComponent& buffs = this->registry->getComponent<BuffComponent>(this->playerEntityId);
+  SkillTreeComponent& skillTree =
+      this->registry->getComponent<SkillTreeComponent>(this->playerEntityId);
+  const TransformComponent& playerTransform =
+      this->registry->getComponent<TransformComponent>(this->playerEntityId);
+  const CollisionComponent& playerCollision =
+      this->registry->getComponent<CollisionComponent>(this->playerEntityId);
+  const Position playerCenter = this->playerCenter();
+  for (std::size_t i = 0; i < skills.slots.size(); ++i) {
+    SkillSlot& slot = skills.slots[i];
+    if (this->input.skillJustPressed[i]) {
+      const SkillDef* def =
+          (slot.skillId > 0) ? this->skillDatabase->getSkill(slot.skillId) : nullptr;
+      const bool unlocked = def && isSkillUnlocked(skillTree, def->id);
+      if (!this->playerGhost && unlocked && this->tick >= slot.readyTick && castSkill(*def)) {
+        slot.readyTick = this->tick + ticksForSeconds(def->cooldown, this->tickSeconds);
+        this->eventBus->emitFloatingTextEvent(
+            FloatingTextEvent{"Skill: " + def->name, playerCenter, FloatingTextKind::Info});
+        if (def->buffDuration > 0.0f) {
+          applyOrRefreshBuff(buffs, def->id, def->name, def->buffDuration);
+        }
+      }
+    }
+  }
+}
+
+Position Simulation::playerCenter() const {
+  const TransformComponent& playerTransform =
+      this->registry->getComponent<TransformComponent>(this->playerEntityId);
+  const CollisionComponent& playerCollision =
+      this->registry->getComponent<CollisionComponent>(this->playerEntityId);
+  return Position(playerTransform.position.x + (playerCollision.width / 2.0f),
+                  playerTransform.position.y + (playerCollision.height / 2.0f));
+}
+
+void Simulation::refreshPlayerDerivedStats() {
+  const LevelComponent& level = this->registry->getComponent<LevelComponent>(this->playerEntityId);
+  const ClassComponent& playerClass =
+      this->registry->getComponent<ClassComponent>(this->playerEntityId);
+  refreshDerivedStats(this->registry->getComponent<DerivedStatsComponent>(this->playerEntityId),
+                      this->registry->getComponent<StatsComponent>(this->playerEntityId),
+                      this->registry->getComponent<EquipmentComponent>(this->playerEntityId),
+                      this->registry->getComponent<BuffComponent>(this->playerEntityId),
+                      level.level, playerClass.characterClass, *this->itemDatabase);
+}
+
+void Simulation::applyOrRefreshBuff(BuffComponent& buffs, int buffId, const std::string& name,
+                                    float duration) {
+  const std::uint64_t expiresAtTick = this->tick + ticksForSeconds(duration, this->tickSeconds);
+  for (BuffInstance& buff : buffs.buffs) {
+    if (buff.id == buffId) {
+      this->timers.cancel(buff.expiryTimer);
+      buff.duration = duration;
+      buff.name = name;
+      buff.expiresAtTick = expiresAtTick;
+      buff.expiryTimer = this->timers.schedule(
+          expiresAtTick, ScheduledEvent{ScheduledEventKind::BuffExpiry, buffId});
+      return;
+    }
+  }
+  BuffInstance instance;
+  instance.id = buffId;
+  instance.name = name;
+  instance.duration = duration;
+  instance.expiresAtTick = expiresAtTick;
+  instance.expiryTimer =
+      this->timers.schedule(expiresAtTick, ScheduledEvent{ScheduledEventKind::BuffExpiry, buffId});
+  buffs.buffs.push_back(std::move(instance));
+  buffs.version += 1;
+}
+
+void Simulation::scheduleLootDespawn(int lootEntityId) {
+  LootComponent& loot = this->registry->getComponent<LootComponent>(lootEntityId);
+  if (loot.despawnSeconds <= 0.0f) {
+    return;
+  }
+  loot.despawnTimer = this->timers.schedule(
+      this->tick + ticksForSeconds(loot.despawnSeconds, this->tickSeconds),
+      ScheduledEvent{ScheduledEventKind::LootDespawn, lootEntityId});
+}
+
+// Fires whatever came due this tick. Only due timers are visited, however many are pending.
+void Simulation::processTimers() {
+  this->firedTimers.clear();
+  this->timers.advance(this->tick, this->firedTimers);
+  for (const ScheduledEvent& event : this->firedTimers) {
+    switch (event.kind) {
+    case ScheduledEventKind::BuffExpiry: {
+      BuffComponent& buffs = this->registry->getComponent<BuffComponent>(this->playerEntityId);
+      auto it = std::find_if(buffs.buffs.begin(), buffs.buffs.end(),
+                             [&event](const BuffInstance& buff) { return buff.id == event.id; });
+      if (it != buffs.buffs.end()) {
+        buffs.buffs.erase(it);
+        buffs.version += 1;
+      }
+      break;
+    }
+    case ScheduledEventKind::LootDespawn:
+      despawnLoot(event.id);
+      break;
+    }
+  }
+}
+
+void Simulation::despawnLoot(int lootEntityId) {
+  LootComponent& loot = this->registry->getComponent<LootComponent>(lootEntityId);
+  loot.despawnTimer = NO_TIMER;
+  TransformComponent& transform = this->registry->getComponent<TransformComponent>(lootEntityId);
+  const Position lootCenter(transform.position.x + (TILE_SIZE / 2.0f),
+                            transform.position.y + (TILE_SIZE / 2.0f));
+  // Never pull loot out from under the player; look again next tick.
+  if (squaredDistance(this->playerCenter(), lootCenter) <=
+      LOOT_PICKUP_RANGE * LOOT_PICKUP_RANGE) {
+    loot.despawnTimer = this->timers.schedule(
+        this->tick + 1, ScheduledEvent{ScheduledEventKind::LootDespawn, lootEntityId});
+    return;
+  }
+
+  GraphicComponent& graphic = this->registry->getComponent<GraphicComponent>(lootEntityId);
+  graphic.color = Color{0, 0, 0, 0};
+  transform.position = Position(-1000.0f, -1000.0f);
+  this->lootEntityIds.erase(
+      std::remove(this->lootEntityIds.begin(), this->lootEntityIds.end(), lootEntityId),
+      this->lootEntityIds.end());
+}
+
@@ -0,0 +1,90 @@
+#include "simulation/skill_effects.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "simulation/game_rules.h"
+
+namespace {
+// Unit facing, or +x when there is none yet.
+Position unitFacing(float facingX, float facingY) {
+  const float length = std::sqrt((facingX * facingX) + (facingY * facingY));
+  if (length <= 0.001f) {
+    return Position(1.0f, 0.0f);
+  }
+  return Position(facingX / length, facingY / length);
+}
+
+float scalingStatValue(SkillScalingStat stat, const DerivedStatsComponent& derived) {
+  switch (stat) {
+  case SkillScalingStat::AttackPower:
+    return static_cast<float>(derived.attackPower);
+  case SkillScalingStat::Strength:
+    return static_cast<float>(derived.primary.strength);
+  case SkillScalingStat::Dexterity:
+    return static_cast<float>(derived.primary.dexterity);
+  case SkillScalingStat::Intellect:
+    return static_cast<float>(derived.primary.intellect);
+  case SkillScalingStat::Luck:
+    return static_cast<float>(derived.primary.luck);
+  case SkillScalingStat::None:
+    break;
+  }
+  return 0.0f;
+}
+} // namespace
+
+SkillAreaBounds skillAreaBounds(const SkillTargeting& targeting, const Position& origin,
+                                float facingX, float facingY) {
+  switch (targeting.shape) {
+  case SkillTargetShape::Circle:
+  case SkillTargetShape::Cone:
+    return SkillAreaBounds{origin.x - targeting.range, origin.y - targeting.range,
+                           targeting.range * 2.0f, targeting.range * 2.0f};
+  case SkillTargetShape::Line: {
+    const Position facing = unitFacing(facingX, facingY);
+    const float endX = origin.x + (facing.x * targeting.range);
+    const float endY = origin.y + (facing.y * targeting.range);
+    const float pad = targeting.width / 2.0f;
+    const float left = std::min(origin.x, endX) - pad;
+    const float top = std::min(origin.y, endY) - pad;
+    return SkillAreaBounds{left, top, std::max(origin.x, endX) + pad - left,
+                           std::max(origin.y, endY) + pad - top};
+  }
+  case SkillTargetShape::Self:
+  case SkillTargetShape::Projectile:
+    break;
+  }
+  return SkillAreaBounds{origin.x, origin.y, 0.0f, 0.0f};
+}
+
+bool isInSkillArea(const SkillTargeting& targeting, const Position& origin, float facingX,
+                   float facingY, const Position& target) {
+  const float rangeSquared = targeting.range * targeting.range;
+  switch (targeting.shape) {
+  case SkillTargetShape::Circle:
+    return squaredDistance(origin, target) <= rangeSquared;
+  case SkillTargetShape::Cone:
+    return squaredDistance(origin, target) <= rangeSquared &&
+           isInFacingArc(origin, target, facingX, facingY, targeting.halfAngle);
+  case SkillTargetShape::Line: {
+    const Position facing = unitFacing(facingX, facingY);
+    const float dx = target.x - origin.x;
+    const float dy = target.y - origin.y;
+    const float along = (dx * facing.x) + (dy * facing.y);
+    const float across = (dx * facing.y) - (dy * facing.x);
+    const float halfWidth = targeting.width / 2.0f;
+    return along >= 0.0f && along <= targeting.range && std::abs(across) <= halfWidth;
+  }
+  case SkillTargetShape::Self:
+  case SkillTargetShape::Projectile:
+    break;
+  }
+  return false;
+}
+
+int resolveSkillEffectAmount(const SkillEffect& effect, const DerivedStatsComponent& derived) {
+  const float amount =
+      effect.amount + (effect.scaling * scalingStatValue(effect.scalingStat, derived));
+  return std::max(0, static_cast<int>(std::lround(amount)));
+}
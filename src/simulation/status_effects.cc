@@ -0,0 +1,224 @@
+#include "simulation/status_effects.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "ecs/timer_wheel.h"
+
+namespace {
+std::uint64_t effectKey(int entityId, int effectId) {
+  return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(entityId)) << 32) |
+         static_cast<std::uint32_t>(effectId);
+}
+
+std::int32_t ticksFor(float seconds, float tickSeconds) {
+  return static_cast<std::int32_t>(ticksForSeconds(seconds, tickSeconds));
+}
+
+template <typename T> void swapRemove(std::vector<T>& column, std::size_t index) {
+  column[index] = column.back();
+  column.pop_back();
+}
+} // namespace
+
+void StatusEffects::apply(int entityId, const StatusEffectDef& def, float power,
+                          float tickSeconds) {
+  const std::int32_t duration = ticksFor(def.duration, tickSeconds);
+  const std::uint64_t key = effectKey(entityId, def.id);
+  auto existing = this->indexByKey.find(key);
+
+  if (def.type == StatusEffectType::DamageOverTime || def.type == StatusEffectType::HealOverTime) {
+    PeriodicGroup& group =
+        def.type == StatusEffectType::DamageOverTime ? this->damageOverTime : this->healOverTime;
+    const int amount = std::max(1, static_cast<int>(std::lround(def.magnitude * power)));
+    if (existing != this->indexByKey.end()) {
+      // The pulse countdown carries on, so recasting cannot hold a DoT off its next pulse.
+      group.amounts[existing->second] = amount;
+      group.ticksRemaining[existing->second] = duration;
+      return;
+    }
+    const std::int32_t interval = std::max(1, ticksFor(def.tickInterval, tickSeconds));
+    this->indexByKey.emplace(key, static_cast<std::uint32_t>(group.entityIds.size()));
+    group.entityIds.push_back(entityId);
+    group.effectIds.push_back(def.id);
+    group.amounts.push_back(amount);
+    group.pulseIntervals.push_back(interval);
+    group.ticksToPulse.push_back(interval);
+    group.ticksRemaining.push_back(duration);
+    return;
+  }
+
+  ModifierGroup& group = def.type == StatusEffectType::Slow   ? this->slows
+                         : def.type == StatusEffectType::Stun ? this->stuns
+                                                              : this->statModifiers;
+  if (existing != this->indexByKey.end()) {
+    group.magnitudes[existing->second] = def.magnitude;
+    group.ticksRemaining[existing->second] = duration;
+    return;
+  }
+  this->indexByKey.emplace(key, static_cast<std::uint32_t>(group.entityIds.size()));
+  group.entityIds.push_back(entityId);
+  group.effectIds.push_back(def.id);
+  group.magnitudes.push_back(def.magnitude);
+  group.ticksRemaining.push_back(duration);
+}
+
+void StatusEffects::clear(std::vector<int> entityIds) {
+  if (entityIds.empty() || this->indexByKey.empty()) {
+    return;
+  }
+  std::sort(entityIds.begin(), entityIds.end());
+  auto listed = [&entityIds](int entityId) {
+    return std::binary_search(entityIds.begin(), entityIds.end(), entityId);
+  };
+  for (PeriodicGroup* group : {&this->damageOverTime, &this->healOverTime}) {
+    for (std::size_t i = group->entityIds.size(); i-- > 0;) {
+      if (listed(group->entityIds[i])) {
+        removePeriodic(*group, i);
+      }
+    }
+  }
+  for (ModifierGroup* group : {&this->slows, &this->stuns, &this->statModifiers}) {
+    for (std::size_t i = group->entityIds.size(); i-- > 0;) {
+      if (listed(group->entityIds[i])) {
+        removeModifier(*group, i);
+      }
+    }
+  }
+}
+
+void StatusEffects::update() {
+  this->healthChanges.clear();
+  tickPeriodic(this->damageOverTime, -1);
+  tickPeriodic(this->healOverTime, 1);
+  tickModifiers(this->slows);
+  tickModifiers(this->stuns);
+  tickModifiers(this->statModifiers);
+  rebuildModifiers();
+}
+
+float StatusEffects::speedMultiplier(int entityId) const {
+  const auto index = static_cast<std::size_t>(entityId);
+  return index < this->speedMultipliers.size() ? this->speedMultipliers[index] : 1.0f;
+}
+
+float StatusEffects::damageMultiplier(int entityId) const {
+  const auto index = static_cast<std::size_t>(entityId);
+  return index < this->damageMultipliers.size() ? std::max(0.0f, this->damageMultipliers[index])
+                                                : 1.0f;
+}
+
+bool StatusEffects::isStunned(int entityId) const {
+  const auto index = static_cast<std::size_t>(entityId);
+  return index < this->stunned.size() && this->stunned[index] != 0;
+}
+
+bool StatusEffects::affectsMovement(int entityId) const {
+  return isStunned(entityId) || speedMultiplier(entityId) != 1.0f;
+}
+
+std::size_t StatusEffects::activeCount() const {
+  return this->damageOverTime.entityIds.size() + this->healOverTime.entityIds.size() +
+         this->slows.entityIds.size() + this->stuns.entityIds.size() +
+         this->statModifiers.entityIds.size();
+}
+
+void StatusEffects::tickPeriodic(PeriodicGroup& group, int sign) {
+  const std::size_t count = group.entityIds.size();
+  std::int32_t* ticksRemaining = group.ticksRemaining.data();
+  std::int32_t* ticksToPulse = group.ticksToPulse.data();
+  // Branch-free countdown over packed columns; the compiler vectorises this.
+  for (std::size_t i = 0; i < count; ++i) {
+    ticksRemaining[i] -= 1;
+    ticksToPulse[i] -= 1;
+  }
+  for (std::size_t i = 0; i < count; ++i) {
+    if (ticksToPulse[i] <= 0) {
+      this->healthChanges.push_back(
+          StatusHealthChange{group.entityIds[i], sign * group.amounts[i]});
+      ticksToPulse[i] += group.pulseIntervals[i];
+    }
+  }
+  // Backwards, so the entry swapped into a hole has already been checked.
+  for (std::size_t i = count; i-- > 0;) {
+    if (ticksRemaining[i] <= 0) {
+      removePeriodic(group, i);
+    }
+  }
+}
+
+void StatusEffects::tickModifiers(ModifierGroup& group) {
+  const std::size_t count = group.entityIds.size();
+  std::int32_t* ticksRemaining = group.ticksRemaining.data();
+  for (std::size_t i = 0; i < count; ++i) {
+    ticksRemaining[i] -= 1;
+  }
+  for (std::size_t i = count; i-- > 0;) {
+    if (ticksRemaining[i] <= 0) {
+      removeModifier(group, i);
+    }
+  }
+}
+
+void StatusEffects::removePeriodic(PeriodicGroup& group, std::size_t index) {
+  this->indexByKey.erase(effectKey(group.entityIds[index], group.effectIds[index]));
+  const std::size_t last = group.entityIds.size() - 1;
+  if (index != last) {
+    this->indexByKey[effectKey(group.entityIds[last], group.effectIds[last])] =
+        static_cast<std::uint32_t>(index);
+  }
+  swapRemove(group.entityIds, index);
+  swapRemove(group.effectIds, index);
+  swapRemove(group.amounts, index);
+  swapRemove(group.pulseIntervals, index);
+  swapRemove(group.ticksToPulse, index);
+  swapRemove(group.ticksRemaining, index);
+}
+
+void StatusEffects::removeModifier(ModifierGroup& group, std::size_t index) {
+  this->indexByKey.erase(effectKey(group.entityIds[index], group.effectIds[index]));
+  const std::size_t last = group.entityIds.size() - 1;
+  if (index != last) {
+    this->indexByKey[effectKey(group.entityIds[last], group.effectIds[last])] =
+        static_cast<std::uint32_t>(index);
+  }
+  swapRemove(group.entityIds, index);
+  swapRemove(group.effectIds, index);
+  swapRemove(group.magnitudes, index);
+  swapRemove(group.ticksRemaining, index);
+}
+
+void StatusEffects::rebuildModifiers() {
+  for (int entityId : this->modifiedEntities) {
+    this->speedMultipliers[entityId] = 1.0f;
+    this->damageMultipliers[entityId] = 1.0f;
+    this->stunned[entityId] = 0;
+  }
+  this->modifiedEntities.clear();
+  // The strongest slow wins; stat modifiers from different effects add up.
+  for (std::size_t i = 0; i < this->slows.entityIds.size(); ++i) {
+    const int entityId = this->slows.entityIds[i];
+    trackEntity(entityId);
+    this->speedMultipliers[entityId] = std::min(
+        this->speedMultipliers[entityId], std::clamp(1.0f - this->slows.magnitudes[i], 0.0f, 1.0f));
+  }
+  for (int entityId : this->stuns.entityIds) {
+    trackEntity(entityId);
+    this->stunned[entityId] = 1;
+  }
+  for (std::size_t i = 0; i < this->statModifiers.entityIds.size(); ++i) {
+    const int entityId = this->statModifiers.entityIds[i];
+    trackEntity(entityId);
+    this->damageMultipliers[entityId] += this->statModifiers.magnitudes[i];
+  }
+}
+
+void StatusEffects::trackEntity(int entityId) {
+  const auto index = static_cast<std::size_t>(entityId);
+  if (index >= this->speedMultipliers.size()) {
+    this->speedMultipliers.resize(index + 1, 1.0f);
+    this->damageMultipliers.resize(index + 1, 1.0f);
+    this->stunned.resize(index + 1, 0);
+  }
+  this->modifiedEntities.push_back(entityId);
+}
@@ -0,0 +1,76 @@
+#include "simulation/worker_pool.h"
+
+WorkerPool::WorkerPool(unsigned int workerCount) {
+  this->workers.reserve(workerCount);
+  for (unsigned int i = 0; i < workerCount; ++i) {
+    this->workers.emplace_back(&WorkerPool::workerLoop, this);
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->stopping = true;
+  }
+  this->workReady.notify_all();
+  for (std::thread& worker : this->workers) {
+    worker.join();
+  }
+}
+
+void WorkerPool::run(std::size_t taskCount, const std::function<void(std::size_t)>& task) {
+  if (taskCount == 0) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->task = &task;
+    this->taskCount = taskCount;
+    this->nextTask = 0;
+    this->pendingTasks = taskCount;
+    this->generation += 1;
+  }
+  this->workReady.notify_all();
+  drainTasks();
+  std::unique_lock<std::mutex> lock(this->mutex);
+  this->workDone.wait(lock, [this]() { return this->pendingTasks == 0; });
+  this->task = nullptr;
+}
+
+void WorkerPool::workerLoop() {
+  std::size_t seenGeneration = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      this->workReady.wait(lock, [this, seenGeneration]() {
+        return this->stopping || this->generation != seenGeneration;
+      });
+      if (this->stopping) {
+        return;
+      }
+      seenGeneration = this->generation;
+    }
+    drainTasks();
+  }
+}
+
+void WorkerPool::drainTasks() {
+  while (true) {
+    const std::function<void(std::size_t)>* current = nullptr;
+    std::size_t index = 0;
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      if (!this->task || this->nextTask >= this->taskCount) {
+        return;
+      }
+      current = this->task;
+      index = this->nextTask++;
+    }
+    (*current)(index);
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->pendingTasks -= 1;
+    if (this->pendingTasks == 0) {
+      this->workDone.notify_all();
+    }
+  }
+}
@@ -5,6 +5,13 @@ SkillDatabase::SkillDatabase() {
   slash.id = 1;
   slash.name = "Slash";
   slash.cooldown = 0.5f;
+  slash.targeting.shape = SkillTargetShape::Cone;
+  slash.targeting.range = 72.0f;
+  slash.targeting.halfAngle = 1.0f;
+  slash.effects = {
+      {SkillEffectType::Damage, 0.0f, SkillScalingStat::AttackPower, 1.3f, 0},
+      {SkillEffectType::Knockback, 16.0f, SkillScalingStat::None, 0.0f, 0},
+  };
   addSkill(slash);
 
   SkillDef haste;
@@ -25,6 +32,13 @@ SkillDatabase::SkillDatabase() {
   whirlwind.id = 4;
   whirlwind.name = "Whirlwind";
   whirlwind.cooldown = 6.0f;
+  whirlwind.targeting.shape = SkillTargetShape::Circle;
+  whirlwind.targeting.range = 96.0f;
+  whirlwind.effects = {
+      {SkillEffectType::Damage, 0.0f, SkillScalingStat::AttackPower, 0.6f, 0},
+      {SkillEffectType::Status, 0.0f, SkillScalingStat::None, 0.0f, 1},
+      {SkillEffectType::Knockback, 24.0f, SkillScalingStat::None, 0.0f, 0},
+  };
   addSkill(whirlwind);
 
   SkillDef guard;
@@ -32,6 +46,9 @@ SkillDatabase::SkillDatabase() {
   guard.name = "Guard";
   guard.cooldown = 8.0f;
   guard.buffDuration = 4.0f;
+  guard.effects = {
+      {SkillEffectType::Heal, 5.0f, SkillScalingStat::Strength, 1.0f, 0},
+  };
   addSkill(guard);
 
   SkillDef focus;
@@ -39,6 +56,13 @@ SkillDatabase::SkillDatabase() {
   focus.name = "Focus";
   focus.cooldown = 10.0f;
   focus.buffDuration = 5.0f;
+  focus.targeting.shape = SkillTargetShape::Projectile;
+  focus.targeting.range = 320.0f;
+  focus.targeting.projectileSpeed = 420.0f;
+  focus.effects = {
+      {SkillEffectType::Damage, 4.0f, SkillScalingStat::Intellect, 1.5f, 0},
+      {SkillEffectType::Status, 0.0f, SkillScalingStat::None, 0.0f, 4},
+  };
   addSkill(focus);
 }
 
@@ -0,0 +1,65 @@
+#include "skills/status_effect_database.h"
+
+StatusEffectDatabase::StatusEffectDatabase() {
+  StatusEffectDef bleed;
+  bleed.id = 1;
+  bleed.name = "Bleed";
+  bleed.type = StatusEffectType::DamageOverTime;
+  bleed.duration = 4.0f;
+  bleed.tickInterval = 0.5f;
+  bleed.magnitude = 0.2f;
+  addEffect(bleed);
+
+  StatusEffectDef poison;
+  poison.id = 2;
+  poison.name = "Poison";
+  poison.type = StatusEffectType::DamageOverTime;
+  poison.duration = 8.0f;
+  poison.tickInterval = 1.0f;
+  poison.magnitude = 0.25f;
+  addEffect(poison);
+
+  StatusEffectDef regeneration;
+  regeneration.id = 3;
+  regeneration.name = "Regeneration";
+  regeneration.type = StatusEffectType::HealOverTime;
+  regeneration.duration = 6.0f;
+  regeneration.tickInterval = 1.0f;
+  regeneration.magnitude = 0.3f;
+  addEffect(regeneration);
+
+  StatusEffectDef chill;
+  chill.id = 4;
+  chill.name = "Chill";
+  chill.type = StatusEffectType::Slow;
+  chill.duration = 3.0f;
+  chill.magnitude = 0.4f;
+  addEffect(chill);
+
+  StatusEffectDef stun;
+  stun.id = 5;
+  stun.name = "Stun";
+  stun.type = StatusEffectType::Stun;
+  stun.duration = 1.5f;
+  addEffect(stun);
+
+  StatusEffectDef weakness;
+  weakness.id = 6;
+  weakness.name = "Weakness";
+  weakness.type = StatusEffectType::StatModifier;
+  weakness.duration = 5.0f;
+  weakness.magnitude = -0.3f;
+  addEffect(weakness);
+}
+
+const StatusEffectDef* StatusEffectDatabase::getEffect(int id) const {
+  auto it = effects.find(id);
+  if (it == effects.end()) {
+    return nullptr;
+  }
+  return &it->second;
+}
+
+void StatusEffectDatabase::addEffect(StatusEffectDef def) {
+  effects.emplace(def.id, std::move(def));
+}
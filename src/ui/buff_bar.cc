@@ -2,7 +2,6 @@
 
 #include <algorithm>
 #include <cmath>
-#include <cstring>
 #include <string>
 
 namespace {
@@ -10,42 +9,61 @@ constexpr float SLOT_SIZE = 28.0f;
 constexpr float SLOT_PADDING = 6.0f;
 constexpr float BAR_X = 12.0f;
 constexpr float BAR_Y = 44.0f;
+
+// Whole pixels of the cooldown shade, so the bar only changes when the shade visibly moves.
+int shadeHeight(const BuffInstance& buff, float remaining) {
+  if (buff.duration <= 0.0f || remaining <= 0.0f) {
+    return 0;
+  }
+  const float ratio = std::clamp(remaining / buff.duration, 0.0f, 1.0f);
+  return static_cast<int>(std::lround(SLOT_SIZE * ratio));
+}
 } // namespace
 
-void BuffBar::render(SDL_Renderer* renderer, TTF_Font* font, const BuffComponent& buffs) {
+void BuffBar::render(SDL_Renderer* renderer, TextRenderer& text, const BuffComponent& buffs,
+                     std::uint64_t tick, float tickSeconds) {
   if (buffs.buffs.empty()) {
     return;
   }
 
-  SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-  SDL_Color textColor = {240, 240, 240, 255};
-  float x = BAR_X;
-  const float y = BAR_Y;
+  PanelKey key;
   for (const BuffInstance& buff : buffs.buffs) {
-    SDL_FRect rect = {x, y, SLOT_SIZE, SLOT_SIZE};
-    SDL_SetRenderDrawColor(renderer, 60, 120, 60, 220);
-    SDL_RenderFillRect(renderer, &rect);
-    SDL_SetRenderDrawColor(renderer, 200, 220, 200, 255);
-    SDL_RenderRect(renderer, &rect);
-
-    if (buff.duration > 0.0f && buff.remaining > 0.0f) {
-      const float ratio = std::clamp(buff.remaining / buff.duration, 0.0f, 1.0f);
-      SDL_SetRenderDrawColor(renderer, 0, 0, 0, 140);
-      SDL_FRect cooldownRect = {rect.x, rect.y + (rect.h * (1.0f - ratio)), rect.w, rect.h * ratio};
-      SDL_RenderFillRect(renderer, &cooldownRect);
-    }
+    const float remaining = buff.remainingSeconds(tick, tickSeconds);
+    key.add(buff.id);
+    key.add(static_cast<int>(std::ceil(remaining)));
+    key.add(shadeHeight(buff, remaining));
+  }
+  const float width = static_cast<float>(buffs.buffs.size()) * (SLOT_SIZE + SLOT_PADDING);
+  const SDL_FRect bounds = {BAR_X, BAR_Y, width, SLOT_SIZE};
+  if (this->cache.begin(renderer, bounds, key.value())) {
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_Color textColor = {240, 240, 240, 255};
+    float x = BAR_X;
+    const float y = BAR_Y;
+    for (const BuffInstance& buff : buffs.buffs) {
+      SDL_FRect rect = {x, y, SLOT_SIZE, SLOT_SIZE};
+      SDL_SetRenderDrawColor(renderer, 60, 120, 60, 220);
+      SDL_RenderFillRect(renderer, &rect);
+      SDL_SetRenderDrawColor(renderer, 200, 220, 200, 255);
+      SDL_RenderRect(renderer, &rect);
+
+      const float remaining = buff.remainingSeconds(tick, tickSeconds);
+      const float shade = static_cast<float>(shadeHeight(buff, remaining));
+      if (shade > 0.0f) {
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 140);
+        SDL_FRect cooldownRect = {rect.x, rect.y + rect.h - shade, rect.w, shade};
+        SDL_RenderFillRect(renderer, &cooldownRect);
+      }
 
-    const int seconds = static_cast<int>(std::ceil(buff.remaining));
-    const std::string cdText = std::to_string(seconds);
-    SDL_Surface* surface = TTF_RenderText_Solid(font, cdText.c_str(), cdText.length(), textColor);
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_FRect textRect = {rect.x + (rect.w - surface->w) / 2.0f,
-                          rect.y + (rect.h - surface->h) / 2.0f, static_cast<float>(surface->w),
-                          static_cast<float>(surface->h)};
-    SDL_RenderTexture(renderer, texture, nullptr, &textRect);
-    SDL_DestroySurface(surface);
-    SDL_DestroyTexture(texture);
-
-    x += SLOT_SIZE + SLOT_PADDING;
+      const int seconds = static_cast<int>(std::ceil(remaining));
+      const std::string cdText = std::to_string(seconds);
+      const SDL_FPoint textSize = text.measure(cdText);
+      text.draw(cdText, rect.x + (rect.w - textSize.x) / 2.0f,
+                rect.y + (rect.h - textSize.y) / 2.0f, textColor);
+
+      x += SLOT_SIZE + SLOT_PADDING;
+    }
+    this->cache.end(renderer);
   }
+  this->cache.present(renderer);
 }
@@ -1,7 +1,7 @@
 #include "ui/floating_text_system.h"
 
-#include <SDL3_ttf/SDL_ttf.h>
 #include <algorithm>
+#include <charconv>
 
 namespace {
 constexpr float FLOATING_TEXT_LIFETIME = 0.8f;
@@ -9,6 +9,9 @@ constexpr float FLOATING_TEXT_SPEED = 24.0f;
 constexpr float CRIT_BASE_SCALE = 1.15f;
 constexpr float CRIT_POP_EXTRA_SCALE = 0.2f;
 constexpr float CRIT_POP_DURATION = 0.1f;
+constexpr float COALESCE_WINDOW = 0.35f;
+
+using FloatingText = FloatingTextSystem::FloatingText;
 
 struct FloatingTextStyle {
   SDL_Color color;
@@ -29,35 +32,132 @@ FloatingTextStyle styleForKind(FloatingTextKind kind) {
   }
   return FloatingTextStyle{SDL_Color{235, 235, 235, 255}, 1.0f, true};
 }
+
+bool isDamage(FloatingTextKind kind) {
+  return kind == FloatingTextKind::Damage || kind == FloatingTextKind::CritDamage;
+}
+
+// Appends as much of value as fits, never splitting a UTF-8 sequence.
+void append(FloatingText& text, std::string_view value) {
+  std::size_t room = FloatingTextSystem::MAX_TEXT_LENGTH - text.length;
+  if (value.size() > room) {
+    while (room > 0 && (static_cast<unsigned char>(value[room]) & 0xC0) == 0x80) {
+      --room;
+    }
+    value = value.substr(0, room);
+  }
+  std::copy(value.begin(), value.end(), text.text.begin() + text.length);
+  text.length = static_cast<std::uint8_t>(text.length + value.size());
+}
+
+void formatAmount(FloatingText& text) {
+  text.length = 0;
+  append(text, text.prefix);
+  char digits[16];
+  const std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), text.amount);
+  append(text, std::string_view(digits, static_cast<std::size_t>(result.ptr - digits)));
+}
 } // namespace
 
-FloatingTextSystem::FloatingTextSystem(EventBus& eventBus) : eventBus(eventBus) {}
+FloatingTextSystem::FloatingTextSystem(EventBus& eventBus, std::size_t maxVisible)
+    : eventBus(eventBus), maxVisible(std::clamp<std::size_t>(maxVisible, 1, CAPACITY)) {}
+
+void FloatingTextSystem::setMaxVisible(std::size_t maxVisible) {
+  this->maxVisible = std::clamp<std::size_t>(maxVisible, 1, CAPACITY);
+  if (this->count > this->maxVisible) {
+    const std::size_t excess = this->count - this->maxVisible;
+    std::move(this->floatingTexts.begin() + excess, this->floatingTexts.begin() + this->count,
+              this->floatingTexts.begin());
+    this->count = this->maxVisible;
+  }
+}
 
 void FloatingTextSystem::update(float dt) {
-  for (auto& text : floatingTexts) {
+  // Compacts in place so labels keep their spawn order, which is also their draw order.
+  std::size_t kept = 0;
+  for (std::size_t i = 0; i < this->count; ++i) {
+    FloatingText& text = this->floatingTexts[i];
     text.lifetime -= dt;
     text.position.y -= FLOATING_TEXT_SPEED * dt;
+    if (text.lifetime > 0.0f) {
+      if (kept != i) {
+        this->floatingTexts[kept] = text;
+      }
+      ++kept;
+    }
   }
-  floatingTexts.erase(
-      std::remove_if(floatingTexts.begin(), floatingTexts.end(),
-                     [](const FloatingText& text) { return text.lifetime <= 0.0f; }),
-      floatingTexts.end());
-
-  for (const FloatingTextEvent& event : eventBus.consumeFloatingTextEvents()) {
-    floatingTexts.push_back(
-        FloatingText{event.text, event.position, FLOATING_TEXT_LIFETIME, event.kind});
+  this->count = kept;
+
+  for (const FloatingTextEvent& event : this->eventBus.consumeFloatingTextEvents()) {
+    if (!mergeIntoExisting(event)) {
+      spawn(event);
+    }
   }
 
-  for (const RegionEvent& event : eventBus.consumeRegionEvents()) {
-    const char* action = event.transition == RegionTransition::Enter ? "Entered " : "Left ";
-    floatingTexts.push_back(FloatingText{std::string(action) + event.regionName, event.position,
-                                         FLOATING_TEXT_LIFETIME, FloatingTextKind::Info});
+  for (const RegionEvent& event : this->eventBus.consumeRegionEvents()) {
+    FloatingText& text = allocate();
+    text.position = event.position;
+    text.kind = FloatingTextKind::Info;
+    append(text, event.transition == RegionTransition::Enter ? "Entered " : "Left ");
+    append(text, event.regionName);
   }
 }
 
-void FloatingTextSystem::render(SDL_Renderer* renderer, const Position& cameraPosition,
-                                TTF_Font* font) {
-  for (const FloatingText& text : floatingTexts) {
+void FloatingTextSystem::spawn(const FloatingTextEvent& event) {
+  FloatingText& text = allocate();
+  text.position = event.position;
+  text.kind = event.kind;
+  text.targetId = event.targetId;
+  text.amount = event.amount;
+  text.prefix = event.prefix ? event.prefix : "";
+  if (event.text.empty()) {
+    formatAmount(text);
+  } else {
+    append(text, event.text);
+  }
+}
+
+bool FloatingTextSystem::mergeIntoExisting(const FloatingTextEvent& event) {
+  if (!event.text.empty() || event.targetId < 0 || event.kind == FloatingTextKind::Info) {
+    return false;
+  }
+  const std::string_view prefix = event.prefix ? event.prefix : "";
+  for (std::size_t i = this->count; i > 0; --i) {
+    FloatingText& text = this->floatingTexts[i - 1];
+    const bool sameKind =
+        text.kind == event.kind || (isDamage(text.kind) && isDamage(event.kind));
+    if (text.targetId != event.targetId || !sameKind || prefix != text.prefix ||
+        FLOATING_TEXT_LIFETIME - text.lifetime > COALESCE_WINDOW) {
+      continue;
+    }
+    // The merged label restarts its life at the target, so it ticks in place while hits land.
+    text.amount += event.amount;
+    text.lifetime = FLOATING_TEXT_LIFETIME;
+    text.position = event.position;
+    if (event.kind == FloatingTextKind::CritDamage) {
+      text.kind = FloatingTextKind::CritDamage;
+    }
+    formatAmount(text);
+    return true;
+  }
+  return false;
+}
+
+FloatingText& FloatingTextSystem::allocate() {
+  if (this->count >= this->maxVisible) {
+    std::move(this->floatingTexts.begin() + 1, this->floatingTexts.begin() + this->count,
+              this->floatingTexts.begin());
+    this->count -= 1;
+  }
+  FloatingText& text = this->floatingTexts[this->count++];
+  text = FloatingText{};
+  text.lifetime = FLOATING_TEXT_LIFETIME;
+  return text;
+}
+
+void FloatingTextSystem::render(std::span<const FloatingText> texts,
+                                const Position& cameraPosition, TextRenderer& textRenderer) {
+  for (const FloatingText& text : texts) {
     const float lifeRatio = std::clamp(text.lifetime / FLOATING_TEXT_LIFETIME, 0.0f, 1.0f);
     const Uint8 alpha = static_cast<Uint8>(255.0f * lifeRatio);
     FloatingTextStyle style = styleForKind(text.kind);
@@ -71,38 +171,16 @@ void FloatingTextSystem::render(SDL_Renderer* renderer, const Position& cameraPo
     }
 
     SDL_Color textColor = style.color;
-    textColor.a = 255;
-    SDL_Surface* surface =
-        TTF_RenderText_Solid(font, text.text.c_str(), text.text.length(), textColor);
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
-    SDL_SetTextureAlphaMod(texture, alpha);
+    textColor.a = alpha;
     const float baseX = text.position.x - cameraPosition.x;
     const float baseY = text.position.y - cameraPosition.y;
-    SDL_FRect textRect = {baseX, baseY, static_cast<float>(surface->w) * scale,
-                          static_cast<float>(surface->h) * scale};
-
+    // Labels change too often for the shaped string cache, so they go straight to the glyphs.
     if (style.outline) {
-      SDL_Color outlineColor = {0, 0, 0, 255};
-      SDL_Surface* outlineSurface =
-          TTF_RenderText_Solid(font, text.text.c_str(), text.text.length(), outlineColor);
-      SDL_Texture* outlineTexture = SDL_CreateTextureFromSurface(renderer, outlineSurface);
-      SDL_SetTextureBlendMode(outlineTexture, SDL_BLENDMODE_BLEND);
-      SDL_SetTextureAlphaMod(outlineTexture, alpha);
-      const float offset = 1.0f;
-      const SDL_FPoint offsets[] = {{-offset, 0.0f}, {offset, 0.0f}, {0.0f, -offset},
-                                    {0.0f, offset}};
-      for (const SDL_FPoint& delta : offsets) {
-        SDL_FRect outlineRect = {textRect.x + delta.x, textRect.y + delta.y, textRect.w,
-                                 textRect.h};
-        SDL_RenderTexture(renderer, outlineTexture, nullptr, &outlineRect);
-      }
-      SDL_DestroySurface(outlineSurface);
-      SDL_DestroyTexture(outlineTexture);
+      textRenderer.queueTransientOutlined(text.view(), baseX, baseY, textColor,
+                                          SDL_Color{0, 0, 0, alpha}, scale);
+    } else {
+      textRenderer.queueTransient(text.view(), baseX, baseY, textColor, scale);
     }
-
-    SDL_RenderTexture(renderer, texture, nullptr, &textRect);
-    SDL_DestroySurface(surface);
-    SDL_DestroyTexture(texture);
   }
+  textRenderer.flush();
 }
@@ -1,5 +1,6 @@
 #include "ui/inventory.h"
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -214,11 +215,15 @@ const char* className(CharacterClass characterClass) {
 }
 
 std::string allowedClassesLabel(const ItemDef& def) {
-  if (def.allowedClasses.empty() || def.allowedClasses.count(CharacterClass::Any) > 0) {
+  if ((def.allowedClasses & classBit(CharacterClass::Any)) != 0) {
     return "All";
   }
   std::string label;
-  for (CharacterClass entry : def.allowedClasses) {
+  for (CharacterClass entry : {CharacterClass::Warrior, CharacterClass::Mage,
+                               CharacterClass::Archer, CharacterClass::Rogue}) {
+    if ((def.allowedClasses & classBit(entry)) == 0) {
+      continue;
+    }
     if (!label.empty()) {
       label += "/";
     }
@@ -227,10 +232,10 @@ std::string allowedClassesLabel(const ItemDef& def) {
   return label.empty() ? "All" : label;
 }
 
-std::vector<std::string> buildTooltipLines(const ItemDef& def) {
+std::vector<std::string> buildTooltipLines(const ItemDef& def, const ItemDatabase& database) {
   std::vector<std::string> lines;
   const PrimaryStatBonuses& primary = primaryStatsForItem(def);
-  lines.push_back(def.name);
+  lines.push_back(database.itemName(def));
   lines.push_back(std::string("Rarity: ") + itemRarityName(def.rarity));
   lines.push_back(std::string("Req L") + std::to_string(def.requiredLevel) + "  " +
                   allowedClassesLabel(def));
@@ -251,8 +256,8 @@ std::vector<std::string> buildTooltipLines(const ItemDef& def) {
   return lines;
 }
 
-void renderTooltip(SDL_Renderer* renderer, TTF_Font* font, const std::vector<std::string>& lines,
-                   float tooltipX, float tooltipY) {
+void renderTooltip(SDL_Renderer* renderer, TextRenderer& text,
+                   const std::vector<std::string>& lines, float tooltipX, float tooltipY) {
   if (lines.empty()) {
     return;
   }
@@ -269,16 +274,10 @@ void renderTooltip(SDL_Renderer* renderer, TTF_Font* font, const std::vector<std
 
   float textY = tooltipY + 6.0f;
   for (const std::string& line : lines) {
-    SDL_Surface* surface =
-        TTF_RenderText_Solid(font, line.c_str(), static_cast<int>(line.size()), textColor);
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_FRect textRect = {tooltipX + 6.0f, textY, static_cast<float>(surface->w),
-                          static_cast<float>(surface->h)};
-    SDL_RenderTexture(renderer, texture, nullptr, &textRect);
-    SDL_DestroySurface(surface);
-    SDL_DestroyTexture(texture);
+    text.queue(line, tooltipX + 6.0f, textY, textColor);
     textY += LINE_HEIGHT;
   }
+  text.flush();
 }
 
 bool pointInRect(int x, int y, const SDL_FRect& rect) {
@@ -350,9 +349,10 @@ std::vector<SlotBox> equipmentSlotBoxes(const SDL_FRect& panel) {
 } // namespace
 
 void Inventory::handleInput(const bool* keyboardState, int mouseX, int mouseY, bool mousePressed,
-                            InventoryComponent& inventory, EquipmentComponent& equipment,
-                            const ItemDatabase& database, const LevelComponent& level,
-                            const ClassComponent& characterClass) {
+                            const InventoryComponent& inventory,
+                            const EquipmentComponent& equipment, const ItemDatabase& database,
+                            const LevelComponent& level, const ClassComponent& characterClass,
+                            std::vector<PanelCommand>& commands) {
   lastMouseX = mouseX;
   lastMouseY = mouseY;
 
@@ -385,25 +385,9 @@ void Inventory::handleInput(const bool* keyboardState, int mouseX, int mouseY, b
   if (isInventoryOpen && pointInRect(mouseX, mouseY, panel)) {
     std::optional<std::size_t> index = slotIndexFromPoint(mouseX, mouseY, panel);
     if (index.has_value() && *index < inventory.items.size()) {
-      const ItemInstance item = inventory.items[*index];
-      const ItemDef* def = database.getItem(item.itemId);
-      if (def) {
-        if (!meetsEquipRequirements(*def, level.level, characterClass.characterClass)) {
-          return;
-        }
-        std::optional<ItemInstance> removed = inventory.takeItemAt(*index);
-        if (!removed.has_value()) {
-          return;
-        }
-        auto equippedIt = equipment.equipped.find(def->slot);
-        if (equippedIt != equipment.equipped.end()) {
-          if (!inventory.addItem(equippedIt->second)) {
-            inventory.addItem(*removed);
-            return;
-          }
-          equipment.equipped.erase(equippedIt);
-        }
-        equipment.equipped[def->slot] = *removed;
+      const ItemDef* def = database.getItem(inventory.items[*index].itemId);
+      if (def && meetsEquipRequirements(*def, level.level, characterClass.characterClass)) {
+        commands.push_back(PanelCommand{PanelCommandType::EquipItem, static_cast<int>(*index)});
       }
     }
     return;
@@ -414,18 +398,18 @@ void Inventory::handleInput(const bool* keyboardState, int mouseX, int mouseY, b
       if (!pointInRect(mouseX, mouseY, box.rect)) {
         continue;
       }
-      auto it = equipment.equipped.find(box.slot);
-      if (it != equipment.equipped.end()) {
-        if (inventory.addItem(it->second)) {
-          equipment.equipped.erase(it);
-        }
+      if (equipment.equipped.count(box.slot) > 0 &&
+          inventory.items.size() < InventoryComponent::kMaxSlots) {
+        commands.push_back(
+            PanelCommand{PanelCommandType::UnequipItem, static_cast<int>(box.slot)});
       }
       break;
     }
   }
 }
 
-void Inventory::render(SDL_Renderer* renderer, TTF_Font* font, const InventoryComponent& inventory,
+void Inventory::render(SDL_Renderer* renderer, TextRenderer& text,
+                       const InventoryComponent& inventory,
                        const EquipmentComponent& equipment, const ItemDatabase& database) {
   SDL_Color titleColor = {255, 255, 255, 255};
   SDL_FRect panel = inventoryPanelRect();
@@ -448,77 +432,84 @@ void Inventory::render(SDL_Renderer* renderer, TTF_Font* font, const InventoryCo
   }
 
   if (isInventoryOpen) {
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 200);
-    SDL_RenderFillRect(renderer, &panel);
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 180);
-    SDL_RenderRect(renderer, &panel);
-
-    SDL_Surface* titleSurface = TTF_RenderText_Solid(font, "Inventory", 9, titleColor);
-    SDL_Texture* titleTexture = SDL_CreateTextureFromSurface(renderer, titleSurface);
-    SDL_FRect titleRect = {panel.x + 8.0f, panel.y + TITLE_Y_OFFSET,
-                           static_cast<float>(titleSurface->w),
-                           static_cast<float>(titleSurface->h)};
-    SDL_RenderTexture(renderer, titleTexture, nullptr, &titleRect);
-    SDL_DestroySurface(titleSurface);
-    SDL_DestroyTexture(titleTexture);
-
-    for (std::size_t i = 0; i < InventoryComponent::kMaxSlots; ++i) {
-      SDL_FRect slot = slotRect(i, panel);
-      SDL_SetRenderDrawColor(renderer, 30, 30, 30, 220);
-      SDL_RenderFillRect(renderer, &slot);
-      SDL_SetRenderDrawColor(renderer, 80, 80, 80, 220);
-      SDL_RenderRect(renderer, &slot);
-
-      if (i < inventory.items.size()) {
-        const ItemDef* def = database.getItem(inventory.items[i].itemId);
-        if (def) {
-          renderItemIcon(renderer, slot, *def, hoverIndex.has_value() && *hoverIndex == i);
+    PanelKey key;
+    key.add(hoverIndex.has_value() ? static_cast<int>(*hoverIndex) : -1);
+    key.add(static_cast<std::uint64_t>(inventory.items.size()));
+    for (const ItemInstance& item : inventory.items) {
+      key.add(item.itemId);
+    }
+    if (this->inventoryCache.begin(renderer, panel, key.value())) {
+      SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+      SDL_SetRenderDrawColor(renderer, 0, 0, 0, 200);
+      SDL_RenderFillRect(renderer, &panel);
+      SDL_SetRenderDrawColor(renderer, 255, 255, 255, 180);
+      SDL_RenderRect(renderer, &panel);
+
+      text.draw("Inventory", panel.x + 8.0f, panel.y + TITLE_Y_OFFSET, titleColor);
+
+      for (std::size_t i = 0; i < InventoryComponent::kMaxSlots; ++i) {
+        SDL_FRect slot = slotRect(i, panel);
+        SDL_SetRenderDrawColor(renderer, 30, 30, 30, 220);
+        SDL_RenderFillRect(renderer, &slot);
+        SDL_SetRenderDrawColor(renderer, 80, 80, 80, 220);
+        SDL_RenderRect(renderer, &slot);
+
+        if (i < inventory.items.size()) {
+          const ItemDef* def = database.getItem(inventory.items[i].itemId);
+          if (def) {
+            renderItemIcon(renderer, slot, *def, hoverIndex.has_value() && *hoverIndex == i);
+          }
         }
       }
+      this->inventoryCache.end(renderer);
     }
+    this->inventoryCache.present(renderer);
   }
 
   if (isEquipmentOpen) {
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 200);
-    SDL_RenderFillRect(renderer, &equipPanel);
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 180);
-    SDL_RenderRect(renderer, &equipPanel);
-
-    SDL_Surface* equipTitleSurface = TTF_RenderText_Solid(font, "Equipment", 9, titleColor);
-    SDL_Texture* equipTitleTexture = SDL_CreateTextureFromSurface(renderer, equipTitleSurface);
-    SDL_FRect equipTitleRect = {equipPanel.x + 8.0f, equipPanel.y + TITLE_Y_OFFSET,
-                                static_cast<float>(equipTitleSurface->w),
-                                static_cast<float>(equipTitleSurface->h)};
-    SDL_RenderTexture(renderer, equipTitleTexture, nullptr, &equipTitleRect);
-    SDL_DestroySurface(equipTitleSurface);
-    SDL_DestroyTexture(equipTitleTexture);
-
+    PanelKey key;
+    key.add(hoverEquip ? static_cast<int>(hoverEquip->slot) : -1);
     for (const SlotBox& box : equipmentSlotBoxes(equipPanel)) {
-      SDL_SetRenderDrawColor(renderer, 30, 30, 30, 220);
-      SDL_RenderFillRect(renderer, &box.rect);
-      SDL_SetRenderDrawColor(renderer, 80, 80, 80, 220);
-      SDL_RenderRect(renderer, &box.rect);
-
       auto it = equipment.equipped.find(box.slot);
-      if (it != equipment.equipped.end()) {
-        const ItemDef* def = database.getItem(it->second.itemId);
-        if (def) {
-          renderItemIcon(renderer, box.rect, *def, hoverEquip && hoverEquip->slot == box.slot);
+      key.add(it != equipment.equipped.end() ? it->second.itemId : -1);
+    }
+    if (this->equipmentCache.begin(renderer, equipPanel, key.value())) {
+      SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+      SDL_SetRenderDrawColor(renderer, 0, 0, 0, 200);
+      SDL_RenderFillRect(renderer, &equipPanel);
+      SDL_SetRenderDrawColor(renderer, 255, 255, 255, 180);
+      SDL_RenderRect(renderer, &equipPanel);
+
+      text.draw("Equipment", equipPanel.x + 8.0f, equipPanel.y + TITLE_Y_OFFSET, titleColor);
+
+      for (const SlotBox& box : equipmentSlotBoxes(equipPanel)) {
+        SDL_SetRenderDrawColor(renderer, 30, 30, 30, 220);
+        SDL_RenderFillRect(renderer, &box.rect);
+        SDL_SetRenderDrawColor(renderer, 80, 80, 80, 220);
+        SDL_RenderRect(renderer, &box.rect);
+
+        auto it = equipment.equipped.find(box.slot);
+        if (it != equipment.equipped.end()) {
+          const ItemDef* def = database.getItem(it->second.itemId);
+          if (def) {
+            renderItemIcon(renderer, box.rect, *def, hoverEquip && hoverEquip->slot == box.slot);
+          }
+        } else {
+          renderEmptySlotHint(renderer, box.rect, box.slot);
         }
-      } else {
-        renderEmptySlotHint(renderer, box.rect, box.slot);
       }
+      this->equipmentCache.end(renderer);
     }
+    this->equipmentCache.present(renderer);
   }
 
+  // Tooltips hang outside the panels and only exist while hovering, so they stay immediate.
   if (hoverIndex.has_value() && *hoverIndex < inventory.items.size()) {
     const ItemDef* def = database.getItem(inventory.items[*hoverIndex].itemId);
     if (def) {
       const float tooltipX = grid.x + grid.w + 12.0f;
       const float tooltipY = grid.y;
-      renderTooltip(renderer, font, buildTooltipLines(*def), tooltipX, tooltipY);
+      renderTooltip(renderer, text, buildTooltipLines(*def, database), tooltipX, tooltipY);
     }
   }
 
@@ -529,8 +520,13 @@ void Inventory::render(SDL_Renderer* renderer, TTF_Font* font, const InventoryCo
       if (def) {
         const float tooltipX = equipGrid.x + equipGrid.w + 12.0f;
         const float tooltipY = equipGrid.y + 84.0f;
-        renderTooltip(renderer, font, buildTooltipLines(*def), tooltipX, tooltipY);
+        renderTooltip(renderer, text, buildTooltipLines(*def, database), tooltipX, tooltipY);
       }
     }
   }
 }
+
+void Inventory::invalidate() {
+  this->inventoryCache.invalidate();
+  this->equipmentCache.invalidate();
+}
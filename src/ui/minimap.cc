@@ -1,9 +1,60 @@
 #include "ui/minimap.h"
-#include <algorithm>
+#include "ui/render_utils.h"
+#include <cstdint>
+
+namespace {
+constexpr std::uint8_t TERRAIN_ALPHA = 220;
+} // namespace
 
 Minimap::Minimap(int width, int height, int margin)
     : width(width), height(height), margin(margin) {}
 
+Minimap::~Minimap() {
+  invalidate();
+}
+
+void Minimap::invalidate() {
+  if (this->terrainTexture) {
+    SDL_DestroyTexture(this->terrainTexture);
+  }
+  this->terrainTexture = nullptr;
+  this->terrainMap = nullptr;
+}
+
+void Minimap::rebuildTerrain(SDL_Renderer* renderer, const Map& map) {
+  invalidate();
+  if (map.getWidth() <= 0 || map.getHeight() <= 0) {
+    return;
+  }
+  this->terrainTexture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32,
+                                           SDL_TEXTUREACCESS_STREAMING, width, height);
+  if (!this->terrainTexture) {
+    return;
+  }
+  SDL_SetTextureBlendMode(this->terrainTexture, SDL_BLENDMODE_BLEND);
+  SDL_SetTextureScaleMode(this->terrainTexture, SDL_SCALEMODE_NEAREST);
+
+  void* pixels = nullptr;
+  int pitch = 0;
+  if (!SDL_LockTexture(this->terrainTexture, nullptr, &pixels, &pitch)) {
+    invalidate();
+    return;
+  }
+  for (int y = 0; y < height; ++y) {
+    std::uint8_t* row = static_cast<std::uint8_t*>(pixels) + (y * pitch);
+    const int tileY = (y * map.getHeight()) / height;
+    for (int x = 0; x < width; ++x) {
+      const SDL_Color color = tileColor(map.getTile((x * map.getWidth()) / width, tileY));
+      row[(x * 4) + 0] = color.r;
+      row[(x * 4) + 1] = color.g;
+      row[(x * 4) + 2] = color.b;
+      row[(x * 4) + 3] = TERRAIN_ALPHA;
+    }
+  }
+  SDL_UnlockTexture(this->terrainTexture);
+  this->terrainMap = &map;
+}
+
 void Minimap::render(SDL_Renderer* renderer, const Map& map, const Position& playerPosition,
                      int windowWidth, int windowHeight, const std::vector<MinimapMarker>& markers) {
   SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
@@ -21,31 +72,13 @@ void Minimap::render(SDL_Renderer* renderer, const Map& map, const Position& pla
                       static_cast<float>(height + 8)};
   SDL_RenderFillRect(renderer, &bgRect);
 
-  for (int y = 0; y < map.getHeight(); ++y) {
-    for (int x = 0; x < map.getWidth(); ++x) {
-      SDL_Color color = {40, 120, 40, 255};
-      switch (map.getTile(x, y)) {
-      case Tile::Grass:
-        color = {40, 120, 40, 255};
-        break;
-      case Tile::Water:
-        color = {30, 60, 160, 255};
-        break;
-      case Tile::Mountain:
-        color = {120, 120, 120, 255};
-        break;
-      case Tile::Town:
-        color = {180, 150, 60, 255};
-        break;
-      case Tile::DungeonEntrance:
-        color = {180, 80, 40, 255};
-        break;
-      }
-      SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, 220);
-      SDL_FRect pixel = {originX + (x * scaleX), originY + (y * scaleY), std::max(1.0f, scaleX),
-                         std::max(1.0f, scaleY)};
-      SDL_RenderFillRect(renderer, &pixel);
-    }
+  if (!this->terrainTexture || this->terrainMap != &map) {
+    rebuildTerrain(renderer, map);
+  }
+  if (this->terrainTexture) {
+    SDL_FRect terrainRect = {originX, originY, static_cast<float>(width),
+                             static_cast<float>(height)};
+    SDL_RenderTexture(renderer, this->terrainTexture, nullptr, &terrainRect);
   }
 
   const float playerTileX = playerPosition.x / TILE_SIZE;
@@ -1,11 +1,10 @@
 #include "ui/npc_dialog.h"
 
-#include "ui/text_utils.h"
 #include <algorithm>
 #include <cmath>
 #include <vector>
 
-void renderNpcDialog(SDL_Renderer* renderer, TTF_Font* font, const std::string& title,
+void renderNpcDialog(SDL_Renderer* renderer, TextRenderer& textRenderer, const std::string& title,
                      const std::string& text, int windowWidth, int windowHeight,
                      float& scroll) {
   SDL_Color titleColor = {255, 240, 210, 255};
@@ -18,7 +17,7 @@ void renderNpcDialog(SDL_Renderer* renderer, TTF_Font* font, const std::string&
   constexpr float lineHeight = 16.0f;
   const float textAreaHeight = panelHeight - textOffsetY - panelPadding;
   const int maxWidth = static_cast<int>(panelWidth - (panelPadding * 2.0f));
-  const std::vector<std::string> lines = wrapText(font, text, maxWidth);
+  const std::vector<std::string>& lines = textRenderer.wrap(text, maxWidth);
   const int totalLines = static_cast<int>(lines.size());
   const int maxVisibleLines =
       std::max(1, static_cast<int>(std::floor(textAreaHeight / lineHeight)));
@@ -30,8 +29,6 @@ void renderNpcDialog(SDL_Renderer* renderer, TTF_Font* font, const std::string&
   const float lineOffset = std::fmod(scroll, lineHeight);
   const int endLine = std::min(totalLines, startLine + maxVisibleLines + 1);
 
-  SDL_Surface* titleSurface =
-      TTF_RenderText_Solid(font, title.c_str(), title.length(), titleColor);
   SDL_FRect panel = {12.0f, windowHeight - panelHeight - 92.0f, panelWidth, panelHeight};
   SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
   SDL_SetRenderDrawColor(renderer, 10, 10, 10, 210);
@@ -39,28 +36,17 @@ void renderNpcDialog(SDL_Renderer* renderer, TTF_Font* font, const std::string&
   SDL_SetRenderDrawColor(renderer, 255, 255, 255, 140);
   SDL_RenderRect(renderer, &panel);
 
-  SDL_Texture* titleTexture = SDL_CreateTextureFromSurface(renderer, titleSurface);
-  SDL_FRect titleRect = {panel.x + panelPadding, panel.y + titleOffsetY,
-                         static_cast<float>(titleSurface->w),
-                         static_cast<float>(titleSurface->h)};
-  SDL_RenderTexture(renderer, titleTexture, nullptr, &titleRect);
+  textRenderer.draw(title, panel.x + panelPadding, panel.y + titleOffsetY, titleColor);
 
   float textY = panel.y + textOffsetY - lineOffset;
   for (int i = startLine; i < endLine; ++i) {
-    SDL_Surface* lineSurface =
-        TTF_RenderText_Solid(font, lines[i].c_str(), lines[i].length(), textColor);
-    SDL_Texture* lineTexture = SDL_CreateTextureFromSurface(renderer, lineSurface);
-    SDL_FRect lineRect = {panel.x + panelPadding, textY,
-                          static_cast<float>(lineSurface->w),
-                          static_cast<float>(lineSurface->h)};
-    if (lineRect.y + lineRect.h >= panel.y + textOffsetY - 2.0f &&
-        lineRect.y <= panel.y + panelHeight - panelPadding) {
-      SDL_RenderTexture(renderer, lineTexture, nullptr, &lineRect);
+    if (textY + textRenderer.lineHeight() >= panel.y + textOffsetY - 2.0f &&
+        textY <= panel.y + panelHeight - panelPadding) {
+      textRenderer.queue(lines[i], panel.x + panelPadding, textY, textColor);
     }
-    SDL_DestroyTexture(lineTexture);
-    SDL_DestroySurface(lineSurface);
     textY += lineHeight;
   }
+  textRenderer.flush();
 
   if (maxScroll > 0.0f) {
     const float trackX = panel.x + panel.w - 8.0f;
@@ -76,7 +62,4 @@ void renderNpcDialog(SDL_Renderer* renderer, TTF_Font* font, const std::string&
     SDL_FRect thumbRect = {trackX, thumbY, 4.0f, thumbH};
     SDL_RenderFillRect(renderer, &thumbRect);
   }
-
-  SDL_DestroyTexture(titleTexture);
-  SDL_DestroySurface(titleSurface);
 }
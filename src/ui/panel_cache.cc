@@ -0,0 +1,116 @@
+#include "ui/panel_cache.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace {
+constexpr std::uint64_t FNV_PRIME = 1099511628211ull;
+} // namespace
+
+PanelKey& PanelKey::add(std::uint64_t value) {
+  for (int byte = 0; byte < 8; ++byte) {
+    this->hash ^= (value >> (byte * 8)) & 0xffu;
+    this->hash *= FNV_PRIME;
+  }
+  return *this;
+}
+
+PanelKey& PanelKey::add(int value) {
+  return add(static_cast<std::uint64_t>(static_cast<std::int64_t>(value)));
+}
+
+PanelKey& PanelKey::add(float value) {
+  std::uint32_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return add(static_cast<std::uint64_t>(bits));
+}
+
+PanelKey& PanelKey::add(const std::string& value) {
+  for (unsigned char character : value) {
+    this->hash ^= character;
+    this->hash *= FNV_PRIME;
+  }
+  // Length terminates the string so adjacent strings cannot trade characters.
+  return add(static_cast<std::uint64_t>(value.size()));
+}
+
+PanelCache::~PanelCache() {
+  invalidate();
+}
+
+bool PanelCache::begin(SDL_Renderer* renderer, const SDL_FRect& bounds, std::uint64_t key) {
+  const bool boundsChanged = bounds.x != this->bounds.x || bounds.y != this->bounds.y ||
+                             bounds.w != this->bounds.w || bounds.h != this->bounds.h;
+  if (key != this->key || boundsChanged || this->version == 0) {
+    this->key = key;
+    this->bounds = bounds;
+    this->version += 1;
+  }
+  if (this->valid && this->drawnVersion == this->version) {
+    return false;
+  }
+
+  const int width = static_cast<int>(std::ceil(bounds.x + bounds.w));
+  const int height = static_cast<int>(std::ceil(bounds.y + bounds.h));
+  this->redrawCount += 1;
+  if (!ensureTexture(renderer, width, height)) {
+    this->drawingDirect = true;
+    return true;
+  }
+  this->drawingDirect = false;
+  this->previousTarget = SDL_GetRenderTarget(renderer);
+  SDL_SetRenderTarget(renderer, this->texture);
+  SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+  SDL_RenderClear(renderer);
+  return true;
+}
+
+void PanelCache::end(SDL_Renderer* renderer) {
+  if (this->drawingDirect) {
+    // Nothing was retained, so the next frame draws again.
+    this->drawingDirect = false;
+    return;
+  }
+  SDL_SetRenderTarget(renderer, this->previousTarget);
+  this->previousTarget = nullptr;
+  this->drawnVersion = this->version;
+  this->valid = true;
+}
+
+void PanelCache::present(SDL_Renderer* renderer) const {
+  if (!this->valid || !this->texture) {
+    return;
+  }
+  SDL_RenderTexture(renderer, this->texture, &this->bounds, &this->bounds);
+}
+
+void PanelCache::invalidate() {
+  if (this->texture) {
+    SDL_DestroyTexture(this->texture);
+  }
+  this->texture = nullptr;
+  this->textureWidth = 0;
+  this->textureHeight = 0;
+  this->valid = false;
+}
+
+bool PanelCache::ensureTexture(SDL_Renderer* renderer, int width, int height) {
+  if (width <= 0 || height <= 0) {
+    return false;
+  }
+  if (this->texture && this->textureWidth >= width && this->textureHeight >= height) {
+    return true;
+  }
+  invalidate();
+  this->texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                    width, height);
+  if (!this->texture) {
+    return false;
+  }
+  // Blended draws into a cleared target leave premultiplied color behind.
+  SDL_SetTextureBlendMode(this->texture, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+  SDL_SetTextureScaleMode(this->texture, SDL_SCALEMODE_NEAREST);
+  this->textureWidth = width;
+  this->textureHeight = height;
+  return true;
+}
@@ -27,7 +27,7 @@ std::string objectiveText(const QuestObjectiveProgress& objective, const ItemDat
   }
   case QuestObjectiveType::CollectItem: {
     const ItemDef* def = items.getItem(objective.def.itemId);
-    const std::string name = def ? def->name : "Item";
+    const std::string name = def ? items.itemName(*def) : "Item";
     return "Collect " + name + " (" + std::to_string(objective.currentCount) + "/" +
            std::to_string(objective.def.requiredCount) + ")";
   }
@@ -37,20 +37,63 @@ std::string objectiveText(const QuestObjectiveProgress& objective, const ItemDat
   }
   return "Objective";
 }
+
+// Mirrors the line layout built in render() so the scroll can be clamped without building it.
+int countLines(const QuestLogComponent& questLog, const QuestDatabase& questDatabase) {
+  const QuestCategory categories[] = {QuestCategory::Main, QuestCategory::Side,
+                                      QuestCategory::Bounty};
+  int count = 0;
+  bool endsBlank = false;
+  for (QuestCategory category : categories) {
+    count += 1;
+    endsBlank = false;
+    for (const QuestProgress& progress : questLog.activeQuests) {
+      const QuestDef* def = questDatabase.getQuest(progress.questId);
+      if (!def || def->category != category) {
+        continue;
+      }
+      count += 2 + static_cast<int>(progress.objectives.size());
+      endsBlank = true;
+    }
+  }
+  return endsBlank ? count - 1 : count;
+}
 } // namespace
 
 SDL_FRect QuestLog::panelRect(int windowWidth, int windowHeight) const {
   return ::panelRect(windowWidth, windowHeight);
 }
 
-void QuestLog::render(SDL_Renderer* renderer, TTF_Font* font, const QuestLogComponent& questLog,
+void QuestLog::render(SDL_Renderer* renderer, TextRenderer& text, const QuestLogComponent& questLog,
                       const QuestDatabase& questDatabase, const ItemDatabase& itemDatabase,
-                      int windowWidth, int windowHeight, bool isVisible, float& scroll) const {
+                      int windowWidth, int windowHeight, bool isVisible, float& scroll) {
   if (!isVisible) {
     return;
   }
 
   SDL_FRect panel = panelRect(windowWidth, windowHeight);
+  const float viewHeight = panel.h - 40.0f;
+  float contentHeight = 0.0f;
+  float maxScroll = 0.0f;
+  if (!questLog.activeQuests.empty()) {
+    contentHeight = static_cast<float>(countLines(questLog, questDatabase)) * LINE_HEIGHT;
+    maxScroll = std::max(0.0f, contentHeight - viewHeight);
+    scroll = std::clamp(scroll, 0.0f, maxScroll);
+  }
+
+  PanelKey key;
+  key.add(questLog.activeQuests.empty() ? 0.0f : scroll);
+  for (const QuestProgress& progress : questLog.activeQuests) {
+    key.add(progress.questId).add(progress.completed);
+    for (const QuestObjectiveProgress& objective : progress.objectives) {
+      key.add(objective.currentCount);
+    }
+  }
+  if (!this->cache.begin(renderer, panel, key.value())) {
+    this->cache.present(renderer);
+    return;
+  }
+
   SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
   SDL_SetRenderDrawColor(renderer, 10, 10, 10, 200);
   SDL_RenderFillRect(renderer, &panel);
@@ -58,13 +101,7 @@ void QuestLog::render(SDL_Renderer* renderer, TTF_Font* font, const QuestLogComp
   SDL_RenderRect(renderer, &panel);
 
   SDL_Color titleColor = {255, 240, 210, 255};
-  SDL_Surface* titleSurface = TTF_RenderText_Solid(font, "Quest Log", 9, titleColor);
-  SDL_Texture* titleTexture = SDL_CreateTextureFromSurface(renderer, titleSurface);
-  SDL_FRect titleRect = {panel.x + PANEL_PADDING, panel.y + TITLE_OFFSET,
-                         static_cast<float>(titleSurface->w), static_cast<float>(titleSurface->h)};
-  SDL_RenderTexture(renderer, titleTexture, nullptr, &titleRect);
-  SDL_DestroySurface(titleSurface);
-  SDL_DestroyTexture(titleTexture);
+  text.draw("Quest Log", panel.x + PANEL_PADDING, panel.y + TITLE_OFFSET, titleColor);
 
   float textY = panel.y + 28.0f;
   SDL_Color textColor = {235, 235, 235, 255};
@@ -79,13 +116,9 @@ void QuestLog::render(SDL_Renderer* renderer, TTF_Font* font, const QuestLogComp
   std::vector<LineEntry> lines;
 
   if (questLog.activeQuests.empty()) {
-    SDL_Surface* emptySurface = TTF_RenderText_Solid(font, "No active quests.", 17, mutedColor);
-    SDL_Texture* emptyTexture = SDL_CreateTextureFromSurface(renderer, emptySurface);
-    SDL_FRect emptyRect = {panel.x + PANEL_PADDING, textY, static_cast<float>(emptySurface->w),
-                           static_cast<float>(emptySurface->h)};
-    SDL_RenderTexture(renderer, emptyTexture, nullptr, &emptyRect);
-    SDL_DestroySurface(emptySurface);
-    SDL_DestroyTexture(emptyTexture);
+    text.draw("No active quests.", panel.x + PANEL_PADDING, textY, mutedColor);
+    this->cache.end(renderer);
+    this->cache.present(renderer);
     return;
   }
 
@@ -114,10 +147,6 @@ void QuestLog::render(SDL_Renderer* renderer, TTF_Font* font, const QuestLogComp
     lines.pop_back();
   }
 
-  const float contentHeight = static_cast<float>(lines.size()) * LINE_HEIGHT;
-  const float viewHeight = panel.h - 40.0f;
-  const float maxScroll = std::max(0.0f, contentHeight - viewHeight);
-  scroll = std::clamp(scroll, 0.0f, maxScroll);
   const int startLine = static_cast<int>(std::floor(scroll / LINE_HEIGHT));
   const float lineOffset = std::fmod(scroll, LINE_HEIGHT);
   const int maxVisible = static_cast<int>(std::ceil(viewHeight / LINE_HEIGHT)) + 1;
@@ -127,17 +156,11 @@ void QuestLog::render(SDL_Renderer* renderer, TTF_Font* font, const QuestLogComp
   for (int i = startLine; i < endLine; ++i) {
     const LineEntry& entry = lines[i];
     if (!entry.text.empty()) {
-      SDL_Surface* lineSurface =
-          TTF_RenderText_Solid(font, entry.text.c_str(), entry.text.length(), entry.color);
-      SDL_Texture* lineTexture = SDL_CreateTextureFromSurface(renderer, lineSurface);
-      SDL_FRect lineRect = {panel.x + PANEL_PADDING + entry.indent, textY,
-                            static_cast<float>(lineSurface->w), static_cast<float>(lineSurface->h)};
-      SDL_RenderTexture(renderer, lineTexture, nullptr, &lineRect);
-      SDL_DestroySurface(lineSurface);
-      SDL_DestroyTexture(lineTexture);
+      text.queue(entry.text, panel.x + PANEL_PADDING + entry.indent, textY, entry.color);
     }
     textY += LINE_HEIGHT;
   }
+  text.flush();
 
   if (maxScroll > 0.0f) {
     const float trackX = panel.x + panel.w - 8.0f;
@@ -153,4 +176,10 @@ void QuestLog::render(SDL_Renderer* renderer, TTF_Font* font, const QuestLogComp
     SDL_FRect thumbRect = {trackX, thumbY, 4.0f, thumbH};
     SDL_RenderFillRect(renderer, &thumbRect);
   }
+  this->cache.end(renderer);
+  this->cache.present(renderer);
+}
+
+void QuestLog::invalidate() {
+  this->cache.invalidate();
 }
@@ -0,0 +1,137 @@
+#include "ui/render_batch.h"
+
+#include <cmath>
+#include <utility>
+
+namespace {
+constexpr float PI = 3.14159265f;
+constexpr SDL_FPoint NO_UVS[4] = {{0.0f, 0.0f}, {0.0f, 0.0f}, {0.0f, 0.0f}, {0.0f, 0.0f}};
+
+SDL_FColor toFColor(SDL_Color color) {
+  return SDL_FColor{color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f};
+}
+} // namespace
+
+RenderBatch::RenderBatch(SDL_Renderer* renderer) : renderer(renderer) {}
+
+void RenderBatch::fillRect(const SDL_FRect& rect, SDL_Color color, SDL_BlendMode blendMode) {
+  const SDL_FPoint corners[4] = {{rect.x, rect.y},
+                                 {rect.x + rect.w, rect.y},
+                                 {rect.x + rect.w, rect.y + rect.h},
+                                 {rect.x, rect.y + rect.h}};
+  appendQuad(groupFor(nullptr, blendMode), corners, toFColor(color), NO_UVS);
+}
+
+void RenderBatch::outlineRect(const SDL_FRect& rect, SDL_Color color, SDL_BlendMode blendMode) {
+  // Matches SDL_RenderRect: one-pixel edges drawn inside the rect bounds.
+  if (rect.w <= 2.0f || rect.h <= 2.0f) {
+    fillRect(rect, color, blendMode);
+    return;
+  }
+  fillRect(SDL_FRect{rect.x, rect.y, rect.w, 1.0f}, color, blendMode);
+  fillRect(SDL_FRect{rect.x, rect.y + rect.h - 1.0f, rect.w, 1.0f}, color, blendMode);
+  fillRect(SDL_FRect{rect.x, rect.y + 1.0f, 1.0f, rect.h - 2.0f}, color, blendMode);
+  fillRect(SDL_FRect{rect.x + rect.w - 1.0f, rect.y + 1.0f, 1.0f, rect.h - 2.0f}, color,
+           blendMode);
+}
+
+void RenderBatch::line(float x0, float y0, float x1, float y1, SDL_Color color,
+                       SDL_BlendMode blendMode) {
+  const float dx = x1 - x0;
+  const float dy = y1 - y0;
+  const float length = std::sqrt((dx * dx) + (dy * dy));
+  if (length < 0.001f) {
+    fillRect(SDL_FRect{x0 - 0.5f, y0 - 0.5f, 1.0f, 1.0f}, color, blendMode);
+    return;
+  }
+  const float nx = (-dy / length) * 0.5f;
+  const float ny = (dx / length) * 0.5f;
+  const SDL_FPoint corners[4] = {
+      {x0 + nx, y0 + ny}, {x1 + nx, y1 + ny}, {x1 - nx, y1 - ny}, {x0 - nx, y0 - ny}};
+  appendQuad(groupFor(nullptr, blendMode), corners, toFColor(color), NO_UVS);
+}
+
+void RenderBatch::circle(float centerX, float centerY, float radius, SDL_Color color,
+                         int segments, SDL_BlendMode blendMode) {
+  float prevX = centerX + radius;
+  float prevY = centerY;
+  for (int i = 1; i <= segments; ++i) {
+    const float angle = static_cast<float>(i) * (2.0f * PI) / static_cast<float>(segments);
+    const float nextX = centerX + radius * std::cos(angle);
+    const float nextY = centerY + radius * std::sin(angle);
+    line(prevX, prevY, nextX, nextY, color, blendMode);
+    prevX = nextX;
+    prevY = nextY;
+  }
+}
+
+void RenderBatch::texturedRect(SDL_Texture* texture, const SDL_FRect* source,
+                               const SDL_FRect& destination, SDL_Color tint,
+                               SDL_BlendMode blendMode) {
+  float textureWidth = 0.0f;
+  float textureHeight = 0.0f;
+  if (!texture || !SDL_GetTextureSize(texture, &textureWidth, &textureHeight) ||
+      textureWidth <= 0.0f || textureHeight <= 0.0f) {
+    return;
+  }
+  const SDL_FRect region = source ? *source : SDL_FRect{0.0f, 0.0f, textureWidth, textureHeight};
+  const float u0 = region.x / textureWidth;
+  const float v0 = region.y / textureHeight;
+  const float u1 = (region.x + region.w) / textureWidth;
+  const float v1 = (region.y + region.h) / textureHeight;
+  const SDL_FPoint corners[4] = {{destination.x, destination.y},
+                                 {destination.x + destination.w, destination.y},
+                                 {destination.x + destination.w, destination.y + destination.h},
+                                 {destination.x, destination.y + destination.h}};
+  const SDL_FPoint uvs[4] = {{u0, v0}, {u1, v0}, {u1, v1}, {u0, v1}};
+  appendQuad(groupFor(texture, blendMode), corners, toFColor(tint), uvs);
+}
+
+void RenderBatch::flush() {
+  this->lastDrawCalls = 0;
+  this->lastQuadCount = 0;
+  for (std::size_t groupIndex : this->pendingOrder) {
+    Group& group = this->groups[groupIndex];
+    if (group.texture) {
+      SDL_SetTextureBlendMode(group.texture, group.blendMode);
+    } else {
+      SDL_SetRenderDrawBlendMode(this->renderer, group.blendMode);
+    }
+    SDL_RenderGeometry(this->renderer, group.texture, group.vertices.data(),
+                       static_cast<int>(group.vertices.size()), group.indices.data(),
+                       static_cast<int>(group.indices.size()));
+    this->lastDrawCalls += 1;
+    this->lastQuadCount += static_cast<int>(group.indices.size() / 6);
+    group.vertices.clear();
+    group.indices.clear();
+  }
+  this->pendingOrder.clear();
+}
+
+RenderBatch::Group& RenderBatch::groupFor(SDL_Texture* texture, SDL_BlendMode blendMode) {
+  std::size_t index = 0;
+  while (index < this->groups.size() &&
+         (this->groups[index].texture != texture || this->groups[index].blendMode != blendMode)) {
+    ++index;
+  }
+  if (index == this->groups.size()) {
+    Group group;
+    group.texture = texture;
+    group.blendMode = blendMode;
+    this->groups.push_back(std::move(group));
+  }
+  if (this->groups[index].indices.empty()) {
+    this->pendingOrder.push_back(index);
+  }
+  return this->groups[index];
+}
+
+void RenderBatch::appendQuad(Group& group, const SDL_FPoint (&corners)[4], SDL_FColor color,
+                             const SDL_FPoint (&uvs)[4]) {
+  const int first = static_cast<int>(group.vertices.size());
+  for (int corner = 0; corner < 4; ++corner) {
+    group.vertices.push_back(SDL_Vertex{corners[corner], color, uvs[corner]});
+  }
+  group.indices.insert(group.indices.end(),
+                       {first, first + 1, first + 2, first + 2, first + 3, first});
+}
@@ -2,6 +2,22 @@
 
 #include <cmath>
 
+SDL_Color tileColor(Tile tile) {
+  switch (tile) {
+  case Tile::Grass:
+    return SDL_Color{40, 120, 40, 255};
+  case Tile::Water:
+    return SDL_Color{30, 60, 160, 255};
+  case Tile::Mountain:
+    return SDL_Color{120, 120, 120, 255};
+  case Tile::Town:
+    return SDL_Color{180, 150, 60, 255};
+  case Tile::DungeonEntrance:
+    return SDL_Color{180, 80, 40, 255};
+  }
+  return SDL_Color{0, 0, 0, 255};
+}
+
 void drawCircle(SDL_Renderer* renderer, const Position& center, float radius,
                 const Position& cameraPosition, SDL_Color color) {
   constexpr int kSegments = 32;
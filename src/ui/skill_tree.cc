@@ -1,7 +1,5 @@
 #include "ui/skill_tree.h"
 
-#include <algorithm>
-#include <cstring>
 #include <string>
 
 namespace {
@@ -26,20 +24,12 @@ SDL_FRect nodeRect(const SkillNodeDef& node, const SDL_FRect& panel) {
 bool pointInRect(int x, int y, const SDL_FRect& rect) {
   return x >= rect.x && x <= rect.x + rect.w && y >= rect.y && y <= rect.y + rect.h;
 }
-
-bool prerequisitesMet(const SkillTreeComponent& tree, const SkillNodeDef& node) {
-  for (int prereq : node.prerequisites) {
-    if (tree.unlockedSkills.count(prereq) == 0) {
-      return false;
-    }
-  }
-  return true;
-}
 } // namespace
 
 void SkillTree::handleInput(const bool* keyboardState, int mouseX, int mouseY, bool mousePressed,
-                            SkillTreeComponent& tree, const SkillTreeDefinition& definition,
-                            int windowWidth) {
+                            const SkillTreeComponent& tree,
+                            const SkillTreeDefinition& definition, int windowWidth,
+                            std::vector<PanelCommand>& commands) {
   lastMouseX = mouseX;
   lastMouseY = mouseY;
 
@@ -66,16 +56,15 @@ void SkillTree::handleInput(const bool* keyboardState, int mouseX, int mouseY, b
       continue;
     }
     const bool unlocked = tree.unlockedSkills.count(node.id) > 0;
-    const bool available = prerequisitesMet(tree, node) && tree.unspentPoints > 0;
+    const bool available = prerequisitesMet(tree.unlockedSkills, node) && tree.unspentPoints > 0;
     if (!unlocked && available) {
-      tree.unspentPoints = std::max(0, tree.unspentPoints - 1);
-      tree.unlockedSkills.insert(node.id);
+      commands.push_back(PanelCommand{PanelCommandType::UnlockSkill, node.id});
     }
     break;
   }
 }
 
-void SkillTree::render(SDL_Renderer* renderer, TTF_Font* font, const SkillTreeComponent& tree,
+void SkillTree::render(SDL_Renderer* renderer, TextRenderer& text, const SkillTreeComponent& tree,
                        const SkillTreeDefinition& definition, const SkillDatabase& database,
                        int windowWidth, int windowHeight) {
   if (!isOpenFlag) {
@@ -83,72 +72,67 @@ void SkillTree::render(SDL_Renderer* renderer, TTF_Font* font, const SkillTreeCo
   }
 
   SDL_FRect panel = panelRect(windowWidth);
-  SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-  SDL_SetRenderDrawColor(renderer, 15, 15, 15, 210);
-  SDL_RenderFillRect(renderer, &panel);
-  SDL_SetRenderDrawColor(renderer, 180, 180, 180, 220);
-  SDL_RenderRect(renderer, &panel);
-
   SDL_Color textColor = {235, 235, 235, 255};
-  SDL_Surface* titleSurface = TTF_RenderText_Solid(font, "Skill Tree", 10, textColor);
-  SDL_Texture* titleTexture = SDL_CreateTextureFromSurface(renderer, titleSurface);
-  SDL_FRect titleRect = {panel.x + PANEL_PADDING, panel.y + 8.0f,
-                         static_cast<float>(titleSurface->w),
-                         static_cast<float>(titleSurface->h)};
-  SDL_RenderTexture(renderer, titleTexture, nullptr, &titleRect);
-  SDL_DestroySurface(titleSurface);
-  SDL_DestroyTexture(titleTexture);
-
-  std::string pointsText = "SP: " + std::to_string(tree.unspentPoints);
-  SDL_Surface* pointsSurface =
-      TTF_RenderText_Solid(font, pointsText.c_str(), pointsText.length(), textColor);
-  SDL_Texture* pointsTexture = SDL_CreateTextureFromSurface(renderer, pointsSurface);
-  SDL_FRect pointsRect = {panel.x + PANEL_PADDING, panel.y + 28.0f,
-                          static_cast<float>(pointsSurface->w),
-                          static_cast<float>(pointsSurface->h)};
-  SDL_RenderTexture(renderer, pointsTexture, nullptr, &pointsRect);
-  SDL_DestroySurface(pointsSurface);
-  SDL_DestroyTexture(pointsTexture);
-
-  for (const SkillNodeDef& node : definition.nodes()) {
-    SDL_FRect nodeBox = nodeRect(node, panel);
-    const float centerX = nodeBox.x + (nodeBox.w / 2.0f);
-    const float centerY = nodeBox.y + (nodeBox.h / 2.0f);
-    for (int prereq : node.prerequisites) {
-      const SkillNodeDef* prereqNode = definition.getNode(prereq);
-      if (!prereqNode) {
-        continue;
-      }
-      SDL_FRect prereqBox = nodeRect(*prereqNode, panel);
-      const float prereqX = prereqBox.x + (prereqBox.w / 2.0f);
-      const float prereqY = prereqBox.y + (prereqBox.h / 2.0f);
-      const bool prereqUnlocked = tree.unlockedSkills.count(prereq) > 0;
-      SDL_SetRenderDrawColor(renderer, prereqUnlocked ? 120 : 60, prereqUnlocked ? 200 : 60,
-                             prereqUnlocked ? 120 : 60, 220);
-      SDL_RenderLine(renderer, prereqX, prereqY, centerX, centerY);
-    }
-  }
-
   const SkillNodeDef* hovered = nullptr;
+  PanelKey key;
+  key.add(tree.unspentPoints);
   for (const SkillNodeDef& node : definition.nodes()) {
     SDL_FRect rect = nodeRect(node, panel);
     if (pointInRect(lastMouseX, lastMouseY, rect)) {
       hovered = &node;
     }
+    key.add(tree.unlockedSkills.count(node.id) > 0);
+  }
+  // Hover only moves the tooltip, which is drawn on top of the cached panel every frame.
+  if (this->cache.begin(renderer, panel, key.value())) {
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 15, 15, 15, 210);
+    SDL_RenderFillRect(renderer, &panel);
+    SDL_SetRenderDrawColor(renderer, 180, 180, 180, 220);
+    SDL_RenderRect(renderer, &panel);
+
+    std::string pointsText = "SP: " + std::to_string(tree.unspentPoints);
+    text.queue("Skill Tree", panel.x + PANEL_PADDING, panel.y + 8.0f, textColor);
+    text.queue(pointsText, panel.x + PANEL_PADDING, panel.y + 28.0f, textColor);
+    text.flush();
+
+    for (const SkillNodeDef& node : definition.nodes()) {
+      SDL_FRect nodeBox = nodeRect(node, panel);
+      const float centerX = nodeBox.x + (nodeBox.w / 2.0f);
+      const float centerY = nodeBox.y + (nodeBox.h / 2.0f);
+      for (int prereq : node.prerequisites) {
+        const SkillNodeDef* prereqNode = definition.getNode(prereq);
+        if (!prereqNode) {
+          continue;
+        }
+        SDL_FRect prereqBox = nodeRect(*prereqNode, panel);
+        const float prereqX = prereqBox.x + (prereqBox.w / 2.0f);
+        const float prereqY = prereqBox.y + (prereqBox.h / 2.0f);
+        const bool prereqUnlocked = tree.unlockedSkills.count(prereq) > 0;
+        SDL_SetRenderDrawColor(renderer, prereqUnlocked ? 120 : 60, prereqUnlocked ? 200 : 60,
+                               prereqUnlocked ? 120 : 60, 220);
+        SDL_RenderLine(renderer, prereqX, prereqY, centerX, centerY);
+      }
+    }
 
-    const bool unlocked = tree.unlockedSkills.count(node.id) > 0;
-    const bool available = prerequisitesMet(tree, node) && tree.unspentPoints > 0;
-    if (unlocked) {
-      SDL_SetRenderDrawColor(renderer, 70, 160, 90, 240);
-    } else if (available) {
-      SDL_SetRenderDrawColor(renderer, 200, 160, 60, 240);
-    } else {
-      SDL_SetRenderDrawColor(renderer, 80, 80, 80, 220);
+    for (const SkillNodeDef& node : definition.nodes()) {
+      SDL_FRect rect = nodeRect(node, panel);
+      const bool unlocked = tree.unlockedSkills.count(node.id) > 0;
+      const bool available = prerequisitesMet(tree.unlockedSkills, node) && tree.unspentPoints > 0;
+      if (unlocked) {
+        SDL_SetRenderDrawColor(renderer, 70, 160, 90, 240);
+      } else if (available) {
+        SDL_SetRenderDrawColor(renderer, 200, 160, 60, 240);
+      } else {
+        SDL_SetRenderDrawColor(renderer, 80, 80, 80, 220);
+      }
+      SDL_RenderFillRect(renderer, &rect);
+      SDL_SetRenderDrawColor(renderer, 210, 210, 210, 220);
+      SDL_RenderRect(renderer, &rect);
     }
-    SDL_RenderFillRect(renderer, &rect);
-    SDL_SetRenderDrawColor(renderer, 210, 210, 210, 220);
-    SDL_RenderRect(renderer, &rect);
+    this->cache.end(renderer);
   }
+  this->cache.present(renderer);
 
   if (hovered) {
     const SkillDef* def = database.getSkill(hovered->id);
@@ -156,26 +140,26 @@ void SkillTree::render(SDL_Renderer* renderer, TTF_Font* font, const SkillTreeCo
     std::string status;
     if (tree.unlockedSkills.count(hovered->id) > 0) {
       status = "Unlocked";
-    } else if (prerequisitesMet(tree, *hovered)) {
+    } else if (prerequisitesMet(tree.unlockedSkills, *hovered)) {
       status = tree.unspentPoints > 0 ? "Click to learn" : "Needs skill point";
     } else {
       status = "Locked";
     }
     std::string tooltipText = name + " - " + status;
-    SDL_Surface* tooltipSurface =
-        TTF_RenderText_Solid(font, tooltipText.c_str(), tooltipText.length(), textColor);
-    SDL_Texture* tooltipTexture = SDL_CreateTextureFromSurface(renderer, tooltipSurface);
+    const SDL_FPoint tooltipSize = text.measure(tooltipText);
     SDL_FRect tooltipRect = {static_cast<float>(lastMouseX + 12), static_cast<float>(lastMouseY + 12),
-                             static_cast<float>(tooltipSurface->w),
-                             static_cast<float>(tooltipSurface->h)};
+                             tooltipSize.x, tooltipSize.y};
     SDL_FRect tooltipBg = {tooltipRect.x - 6.0f, tooltipRect.y - 4.0f, tooltipRect.w + 12.0f,
                            tooltipRect.h + 8.0f};
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
     SDL_SetRenderDrawColor(renderer, 10, 10, 10, 220);
     SDL_RenderFillRect(renderer, &tooltipBg);
     SDL_SetRenderDrawColor(renderer, 180, 180, 180, 220);
     SDL_RenderRect(renderer, &tooltipBg);
-    SDL_RenderTexture(renderer, tooltipTexture, nullptr, &tooltipRect);
-    SDL_DestroySurface(tooltipSurface);
-    SDL_DestroyTexture(tooltipTexture);
+    text.draw(tooltipText, tooltipRect.x, tooltipRect.y, textColor);
   }
 }
+
+void SkillTree::invalidate() {
+  this->cache.invalidate();
+}
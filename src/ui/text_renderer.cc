@@ -0,0 +1,271 @@
+#include "ui/text_renderer.h"
+
+#include <algorithm>
+
+namespace {
+constexpr int ATLAS_SIZE = 512;
+constexpr int GLYPH_PADDING = 1;
+constexpr std::size_t MAX_SHAPED_STRINGS = 512;
+constexpr std::uint32_t FIRST_PRELOADED_GLYPH = 32;
+constexpr std::uint32_t LAST_PRELOADED_GLYPH = 126;
+
+SDL_FColor toFColor(SDL_Color color) {
+  return SDL_FColor{color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f};
+}
+} // namespace
+
+TextRenderer::TextRenderer(SDL_Renderer* renderer, TTF_Font* font)
+    : renderer(renderer), font(font), fontHeight(font ? TTF_GetFontHeight(font) : 0) {}
+
+TextRenderer::~TextRenderer() {
+  invalidate();
+}
+
+SDL_FPoint TextRenderer::measure(const std::string& text) {
+  const ShapedText* shaped = shape(text);
+  return SDL_FPoint{shaped ? shaped->width : 0.0f, static_cast<float>(this->fontHeight)};
+}
+
+const std::vector<std::string>& TextRenderer::wrap(const std::string& text, int maxWidth) {
+  return this->layoutCache.wrap(this->font, text, maxWidth);
+}
+
+SDL_FPoint TextRenderer::draw(const std::string& text, float x, float y, SDL_Color color,
+                              float scale) {
+  const SDL_FPoint size = queue(text, x, y, color, scale);
+  flush();
+  return size;
+}
+
+SDL_FPoint TextRenderer::drawOutlined(const std::string& text, float x, float y, SDL_Color color,
+                                      SDL_Color outlineColor, float scale) {
+  const SDL_FPoint size = queueOutlined(text, x, y, color, outlineColor, scale);
+  flush();
+  return size;
+}
+
+SDL_FPoint TextRenderer::queue(const std::string& text, float x, float y, SDL_Color color,
+                               float scale) {
+  const ShapedText* shaped = shape(text);
+  if (!shaped) {
+    return SDL_FPoint{0.0f, 0.0f};
+  }
+  appendQuads(*shaped, x, y, color, scale);
+  return SDL_FPoint{shaped->width * scale, this->fontHeight * scale};
+}
+
+SDL_FPoint TextRenderer::queueOutlined(const std::string& text, float x, float y, SDL_Color color,
+                                       SDL_Color outlineColor, float scale) {
+  const ShapedText* shaped = shape(text);
+  if (!shaped) {
+    return SDL_FPoint{0.0f, 0.0f};
+  }
+  appendOutlined(*shaped, x, y, color, outlineColor, scale);
+  return SDL_FPoint{shaped->width * scale, this->fontHeight * scale};
+}
+
+SDL_FPoint TextRenderer::queueTransient(std::string_view text, float x, float y, SDL_Color color,
+                                        float scale) {
+  if (!shapeWithRepack(text, this->transientShape)) {
+    return SDL_FPoint{0.0f, 0.0f};
+  }
+  appendQuads(this->transientShape, x, y, color, scale);
+  return SDL_FPoint{this->transientShape.width * scale, this->fontHeight * scale};
+}
+
+SDL_FPoint TextRenderer::queueTransientOutlined(std::string_view text, float x, float y,
+                                                SDL_Color color, SDL_Color outlineColor,
+                                                float scale) {
+  if (!shapeWithRepack(text, this->transientShape)) {
+    return SDL_FPoint{0.0f, 0.0f};
+  }
+  appendOutlined(this->transientShape, x, y, color, outlineColor, scale);
+  return SDL_FPoint{this->transientShape.width * scale, this->fontHeight * scale};
+}
+
+void TextRenderer::flush() {
+  if (this->indices.empty() || !this->atlas) {
+    this->vertices.clear();
+    this->indices.clear();
+    return;
+  }
+  SDL_RenderGeometry(this->renderer, this->atlas, this->vertices.data(),
+                     static_cast<int>(this->vertices.size()), this->indices.data(),
+                     static_cast<int>(this->indices.size()));
+  this->vertices.clear();
+  this->indices.clear();
+}
+
+void TextRenderer::invalidate() {
+  this->vertices.clear();
+  this->indices.clear();
+  resetAtlas();
+  if (this->atlas) {
+    SDL_DestroyTexture(this->atlas);
+    this->atlas = nullptr;
+  }
+}
+
+const TextRenderer::ShapedText* TextRenderer::shape(const std::string& text) {
+  auto it = this->shapedCache.find(text);
+  if (it != this->shapedCache.end()) {
+    return &it->second;
+  }
+  if (this->shapedCache.size() >= MAX_SHAPED_STRINGS) {
+    this->shapedCache.clear();
+  }
+  ShapedText shaped;
+  if (!shapeWithRepack(text, shaped)) {
+    return nullptr;
+  }
+  return &this->shapedCache.emplace(text, std::move(shaped)).first->second;
+}
+
+bool TextRenderer::shapeWithRepack(std::string_view text, ShapedText& shaped) {
+  if (!ensureAtlas()) {
+    return false;
+  }
+  shaped.quads.clear();
+  shaped.width = 0.0f;
+  if (shapeInto(text, shaped)) {
+    return true;
+  }
+  // The atlas is full. Queued quads still point at the old packing, so submit them before
+  // repacking from scratch with only the glyphs this string needs.
+  flush();
+  resetAtlas();
+  shaped.quads.clear();
+  shaped.width = 0.0f;
+  return shapeInto(text, shaped);
+}
+
+bool TextRenderer::shapeInto(std::string_view text, ShapedText& shaped) {
+  float penX = 0.0f;
+  std::uint32_t previous = 0;
+  std::size_t index = 0;
+  while (index < text.size()) {
+    const std::uint32_t codepoint = decodeUtf8(text, index);
+    const Glyph* glyph = glyphFor(codepoint);
+    if (!glyph) {
+      return false;
+    }
+    int kerning = 0;
+    if (previous != 0 && TTF_GetGlyphKerning(this->font, previous, codepoint, &kerning)) {
+      penX += static_cast<float>(kerning);
+    }
+    if (glyph->source.w > 0.0f) {
+      shaped.quads.push_back(GlyphQuad{glyph->source, penX});
+      shaped.width = std::max(shaped.width, penX + glyph->source.w);
+    }
+    penX += static_cast<float>(glyph->advance);
+    shaped.width = std::max(shaped.width, penX);
+    previous = codepoint;
+  }
+  return true;
+}
+
+const TextRenderer::Glyph* TextRenderer::glyphFor(std::uint32_t codepoint) {
+  auto it = this->glyphs.find(codepoint);
+  if (it != this->glyphs.end()) {
+    return &it->second;
+  }
+
+  Glyph glyph{SDL_FRect{0.0f, 0.0f, 0.0f, 0.0f}, 0};
+  int minX = 0;
+  int maxX = 0;
+  int minY = 0;
+  int maxY = 0;
+  TTF_GetGlyphMetrics(this->font, codepoint, &minX, &maxX, &minY, &maxY, &glyph.advance);
+  // Glyphs are baked white and tinted per vertex, so one atlas serves every text color.
+  SDL_Surface* converted = nullptr;
+  if (codepoint != ' ') {
+    SDL_Surface* rendered =
+        TTF_RenderGlyph_Blended(this->font, codepoint, SDL_Color{255, 255, 255, 255});
+    if (rendered) {
+      converted = SDL_ConvertSurface(rendered, SDL_PIXELFORMAT_ARGB8888);
+      SDL_DestroySurface(rendered);
+    }
+  }
+  if (converted && converted->w <= ATLAS_SIZE && converted->h <= ATLAS_SIZE) {
+    if (this->shelfX + converted->w > ATLAS_SIZE) {
+      this->shelfX = 0;
+      this->shelfY += this->shelfHeight + GLYPH_PADDING;
+      this->shelfHeight = 0;
+    }
+    if (this->shelfY + converted->h > ATLAS_SIZE) {
+      SDL_DestroySurface(converted);
+      return nullptr;
+    }
+    const SDL_Rect destination = {this->shelfX, this->shelfY, converted->w, converted->h};
+    SDL_UpdateTexture(this->atlas, &destination, converted->pixels, converted->pitch);
+    glyph.source = SDL_FRect{static_cast<float>(destination.x), static_cast<float>(destination.y),
+                             static_cast<float>(destination.w), static_cast<float>(destination.h)};
+    this->shelfX += converted->w + GLYPH_PADDING;
+    this->shelfHeight = std::max(this->shelfHeight, converted->h);
+  }
+  if (converted) {
+    SDL_DestroySurface(converted);
+  }
+  return &this->glyphs.emplace(codepoint, glyph).first->second;
+}
+
+bool TextRenderer::ensureAtlas() {
+  if (this->atlas) {
+    return true;
+  }
+  if (!this->font) {
+    return false;
+  }
+  this->atlas = SDL_CreateTexture(this->renderer, SDL_PIXELFORMAT_ARGB8888,
+                                  SDL_TEXTUREACCESS_STATIC, ATLAS_SIZE, ATLAS_SIZE);
+  if (!this->atlas) {
+    return false;
+  }
+  SDL_SetTextureBlendMode(this->atlas, SDL_BLENDMODE_BLEND);
+  resetAtlas();
+  for (std::uint32_t codepoint = FIRST_PRELOADED_GLYPH; codepoint <= LAST_PRELOADED_GLYPH;
+       ++codepoint) {
+    glyphFor(codepoint);
+  }
+  return true;
+}
+
+void TextRenderer::resetAtlas() {
+  this->glyphs.clear();
+  this->shapedCache.clear();
+  this->shelfX = 0;
+  this->shelfY = 0;
+  this->shelfHeight = 0;
+}
+
+void TextRenderer::appendQuads(const ShapedText& shaped, float x, float y, SDL_Color color,
+                               float scale) {
+  const SDL_FColor tint = toFColor(color);
+  const float inverseSize = 1.0f / static_cast<float>(ATLAS_SIZE);
+  for (const GlyphQuad& quad : shaped.quads) {
+    const float left = x + (quad.offsetX * scale);
+    const float top = y;
+    const float right = left + (quad.source.w * scale);
+    const float bottom = top + (quad.source.h * scale);
+    const float u0 = quad.source.x * inverseSize;
+    const float v0 = quad.source.y * inverseSize;
+    const float u1 = (quad.source.x + quad.source.w) * inverseSize;
+    const float v1 = (quad.source.y + quad.source.h) * inverseSize;
+    const int first = static_cast<int>(this->vertices.size());
+    this->vertices.push_back(SDL_Vertex{{left, top}, tint, {u0, v0}});
+    this->vertices.push_back(SDL_Vertex{{right, top}, tint, {u1, v0}});
+    this->vertices.push_back(SDL_Vertex{{right, bottom}, tint, {u1, v1}});
+    this->vertices.push_back(SDL_Vertex{{left, bottom}, tint, {u0, v1}});
+    this->indices.insert(this->indices.end(),
+                         {first, first + 1, first + 2, first + 2, first + 3, first});
+  }
+}
+
+void TextRenderer::appendOutlined(const ShapedText& shaped, float x, float y, SDL_Color color,
+                                  SDL_Color outlineColor, float scale) {
+  const SDL_FPoint offsets[] = {{-1.0f, 0.0f}, {1.0f, 0.0f}, {0.0f, -1.0f}, {0.0f, 1.0f}};
+  for (const SDL_FPoint& offset : offsets) {
+    appendQuads(shaped, x + offset.x, y + offset.y, outlineColor, scale);
+  }
+  appendQuads(shaped, x, y, color, scale);
+}
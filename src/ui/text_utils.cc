@@ -1,71 +1,222 @@
 #include "ui/text_utils.h"
 
-std::vector<std::string> wrapText(TTF_Font* font, const std::string& text, int maxWidth) {
-  std::vector<std::string> lines;
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace {
+constexpr std::uint32_t REPLACEMENT_GLYPH = '?';
+constexpr std::size_t MAX_CACHED_LAYOUTS = 256;
+
+// Running width of a line built one codepoint at a time.
+struct LineWidth {
+  int width = 0;
+  std::uint32_t last = 0;
+};
+
+class GlyphMetrics {
+public:
+  GlyphMetrics(TTF_Font* font, std::unordered_map<std::uint32_t, int>& advances)
+      : font(font), advances(advances) {}
+
+  // Width of line with codepoint appended, including kerning against the previous glyph.
+  int widthWith(const LineWidth& line, std::uint32_t codepoint) {
+    int width = line.width + advance(codepoint);
+    int kerning = 0;
+    if (line.last != 0 && TTF_GetGlyphKerning(this->font, line.last, codepoint, &kerning)) {
+      width += kerning;
+    }
+    return width;
+  }
+
+  void append(LineWidth& line, std::uint32_t codepoint) {
+    line.width = widthWith(line, codepoint);
+    line.last = codepoint;
+  }
+
+  // line followed by a space and word.
+  LineWidth joined(const LineWidth& line, const std::string& word) {
+    LineWidth joined = line;
+    append(joined, ' ');
+    std::size_t index = 0;
+    while (index < word.size()) {
+      append(joined, decodeUtf8(word, index));
+    }
+    return joined;
+  }
+
+private:
+  int advance(std::uint32_t codepoint) {
+    auto it = this->advances.find(codepoint);
+    if (it != this->advances.end()) {
+      return it->second;
+    }
+    int minX = 0;
+    int maxX = 0;
+    int minY = 0;
+    int maxY = 0;
+    int advance = 0;
+    TTF_GetGlyphMetrics(this->font, codepoint, &minX, &maxX, &minY, &maxY, &advance);
+    this->advances.emplace(codepoint, advance);
+    return advance;
+  }
+
+  TTF_Font* font;
+  std::unordered_map<std::uint32_t, int>& advances;
+};
+
+void layoutText(GlyphMetrics& metrics, const std::string& text, int maxWidth,
+                std::vector<std::string>& lines) {
   std::string current;
+  LineWidth currentWidth;
   std::string word;
+  LineWidth wordWidth;
   auto flushWord = [&]() {
     if (word.empty()) {
       return;
     }
-    std::string candidate = current.empty() ? word : current + " " + word;
-    int width = 0;
-    int height = 0;
-    TTF_GetStringSize(font, candidate.c_str(), candidate.size(), &width, &height);
-    if (width <= maxWidth) {
-      current = std::move(candidate);
-      word.clear();
-      return;
-    }
     if (!current.empty()) {
-      lines.push_back(current);
+      const LineWidth joinedWidth = metrics.joined(currentWidth, word);
+      if (joinedWidth.width <= maxWidth) {
+        current += ' ';
+        current += word;
+        currentWidth = joinedWidth;
+        word.clear();
+        wordWidth = LineWidth{};
+        return;
+      }
+      lines.push_back(std::move(current));
       current.clear();
+      currentWidth = LineWidth{};
     }
-    TTF_GetStringSize(font, word.c_str(), word.size(), &width, &height);
-    if (width <= maxWidth) {
-      current = word;
+    if (wordWidth.width <= maxWidth) {
+      current = std::move(word);
+      currentWidth = wordWidth;
       word.clear();
+      wordWidth = LineWidth{};
       return;
     }
-    std::string chunk;
-    for (char ch : word) {
-      std::string next = chunk + ch;
-      TTF_GetStringSize(font, next.c_str(), next.size(), &width, &height);
-      if (width > maxWidth && !chunk.empty()) {
-        lines.push_back(chunk);
-        chunk.clear();
+    // The word alone is too wide: break it between codepoints.
+    std::size_t index = 0;
+    while (index < word.size()) {
+      const std::size_t start = index;
+      const std::uint32_t codepoint = decodeUtf8(word, index);
+      if (!current.empty() && metrics.widthWith(currentWidth, codepoint) > maxWidth) {
+        lines.push_back(std::move(current));
+        current.clear();
+        currentWidth = LineWidth{};
       }
-      chunk += ch;
-    }
-    if (!chunk.empty()) {
-      current = chunk;
+      current.append(word, start, index - start);
+      metrics.append(currentWidth, codepoint);
     }
     word.clear();
+    wordWidth = LineWidth{};
   };
 
-  for (char ch : text) {
-    if (ch == '\n') {
+  std::size_t index = 0;
+  while (index < text.size()) {
+    const std::size_t start = index;
+    const std::uint32_t codepoint = decodeUtf8(text, index);
+    if (codepoint == '\n') {
       flushWord();
-      if (!current.empty()) {
-        lines.push_back(current);
-        current.clear();
-      } else {
-        lines.push_back("");
-      }
+      lines.push_back(std::move(current));
+      current.clear();
+      currentWidth = LineWidth{};
       continue;
     }
-    if (ch == ' ') {
+    if (codepoint == ' ') {
       flushWord();
     } else {
-      word += ch;
+      word.append(text, start, index - start);
+      metrics.append(wordWidth, codepoint);
     }
   }
   flushWord();
   if (!current.empty()) {
-    lines.push_back(current);
+    lines.push_back(std::move(current));
   }
   if (lines.empty()) {
     lines.push_back("");
   }
+}
+} // namespace
+
+std::uint32_t decodeUtf8(std::string_view text, std::size_t& index) {
+  const auto lead = static_cast<unsigned char>(text[index++]);
+  int continuation = 0;
+  std::uint32_t codepoint = 0;
+  if (lead < 0x80) {
+    return lead;
+  } else if ((lead & 0xE0) == 0xC0) {
+    continuation = 1;
+    codepoint = lead & 0x1F;
+  } else if ((lead & 0xF0) == 0xE0) {
+    continuation = 2;
+    codepoint = lead & 0x0F;
+  } else if ((lead & 0xF8) == 0xF0) {
+    continuation = 3;
+    codepoint = lead & 0x07;
+  } else {
+    return REPLACEMENT_GLYPH;
+  }
+  for (int i = 0; i < continuation; ++i) {
+    if (index >= text.size() || (static_cast<unsigned char>(text[index]) & 0xC0) != 0x80) {
+      return REPLACEMENT_GLYPH;
+    }
+    codepoint = (codepoint << 6) | (static_cast<unsigned char>(text[index++]) & 0x3F);
+  }
+  return codepoint;
+}
+
+std::vector<std::string> wrapText(TTF_Font* font, const std::string& text, int maxWidth) {
+  std::unordered_map<std::uint32_t, int> advances;
+  GlyphMetrics metrics(font, advances);
+  std::vector<std::string> lines;
+  layoutText(metrics, text, maxWidth, lines);
   return lines;
 }
+
+const std::vector<std::string>& TextLayoutCache::wrap(TTF_Font* font, const std::string& text,
+                                                      int maxWidth) {
+  auto it = this->layouts.find(text);
+  if (it != this->layouts.end()) {
+    for (const std::list<Layout>::iterator& layout : it->second) {
+      if (layout->font == font && layout->maxWidth == maxWidth) {
+        this->recency.splice(this->recency.begin(), this->recency, layout);
+        return layout->lines;
+      }
+    }
+  }
+  if (this->recency.size() >= MAX_CACHED_LAYOUTS) {
+    evictLeastRecent();
+    it = this->layouts.find(text);
+  }
+  if (it == this->layouts.end()) {
+    it = this->layouts.emplace(text, std::vector<std::list<Layout>::iterator>()).first;
+  }
+  Layout& layout = this->recency.emplace_front();
+  layout.text = &it->first;
+  layout.font = font;
+  layout.maxWidth = maxWidth;
+  it->second.push_back(this->recency.begin());
+  GlyphMetrics metrics(font, this->advances[font]);
+  layoutText(metrics, text, maxWidth, layout.lines);
+  return layout.lines;
+}
+
+void TextLayoutCache::clear() {
+  this->layouts.clear();
+  this->recency.clear();
+  this->advances.clear();
+}
+
+void TextLayoutCache::evictLeastRecent() {
+  const std::list<Layout>::iterator oldest = std::prev(this->recency.end());
+  auto it = this->layouts.find(*oldest->text);
+  std::vector<std::list<Layout>::iterator>& entries = it->second;
+  entries.erase(std::find(entries.begin(), entries.end(), oldest));
+  if (entries.empty()) {
+    this->layouts.erase(it);
+  }
+  this->recency.erase(oldest);
+}
@@ -0,0 +1,148 @@
+#include "ui/tile_chunk_cache.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "ui/render_utils.h"
+
+TileChunkCache::TileChunkCache(int chunkTiles, std::size_t maxChunks)
+    : chunkTiles(std::max(1, chunkTiles)), maxChunks(std::max<std::size_t>(1, maxChunks)) {}
+
+TileChunkCache::~TileChunkCache() {
+  invalidate();
+}
+
+void TileChunkCache::render(SDL_Renderer* renderer, const Map& map, const Position& cameraPosition,
+                            int viewWidth, int viewHeight) {
+  if (this->cachedMap != &map) {
+    invalidate();
+    this->cachedMap = &map;
+  }
+  this->frame += 1;
+  this->lastDrawCalls = 0;
+
+  const int chunkPixels = this->chunkTiles * TILE_SIZE;
+  const int chunksPerRow = (map.getWidth() + this->chunkTiles - 1) / this->chunkTiles;
+  const int chunksPerColumn = (map.getHeight() + this->chunkTiles - 1) / this->chunkTiles;
+  const int startChunkX =
+      std::max(0, static_cast<int>(std::floor(cameraPosition.x / chunkPixels)));
+  const int startChunkY =
+      std::max(0, static_cast<int>(std::floor(cameraPosition.y / chunkPixels)));
+  const int endChunkX = std::min(
+      chunksPerRow - 1, static_cast<int>(std::floor((cameraPosition.x + viewWidth) / chunkPixels)));
+  const int endChunkY =
+      std::min(chunksPerColumn - 1,
+               static_cast<int>(std::floor((cameraPosition.y + viewHeight) / chunkPixels)));
+
+  for (int chunkY = startChunkY; chunkY <= endChunkY; ++chunkY) {
+    for (int chunkX = startChunkX; chunkX <= endChunkX; ++chunkX) {
+      Chunk& chunk = this->chunks[(chunkY * chunksPerRow) + chunkX];
+      chunk.lastUsedFrame = this->frame;
+      if (chunk.dirty || !chunk.texture) {
+        bakeChunk(renderer, map, chunkX, chunkY, chunk);
+      }
+      if (!chunk.texture) {
+        continue;
+      }
+      float textureWidth = 0.0f;
+      float textureHeight = 0.0f;
+      SDL_GetTextureSize(chunk.texture, &textureWidth, &textureHeight);
+      const SDL_FRect destination = {static_cast<float>(chunkX * chunkPixels) - cameraPosition.x,
+                                     static_cast<float>(chunkY * chunkPixels) - cameraPosition.y,
+                                     textureWidth, textureHeight};
+      SDL_RenderTexture(renderer, chunk.texture, nullptr, &destination);
+      this->lastDrawCalls += 1;
+    }
+  }
+
+  evictLeastRecentlyUsed();
+}
+
+void TileChunkCache::invalidateTile(int tileX, int tileY) {
+  if (!this->cachedMap || !this->cachedMap->isInside(tileX, tileY)) {
+    return;
+  }
+  const int chunksPerRow = (this->cachedMap->getWidth() + this->chunkTiles - 1) / this->chunkTiles;
+  auto it = this->chunks.find(((tileY / this->chunkTiles) * chunksPerRow) +
+                              (tileX / this->chunkTiles));
+  if (it != this->chunks.end()) {
+    it->second.dirty = true;
+  }
+}
+
+void TileChunkCache::invalidate() {
+  for (auto& entry : this->chunks) {
+    if (entry.second.texture) {
+      SDL_DestroyTexture(entry.second.texture);
+    }
+  }
+  this->chunks.clear();
+}
+
+void TileChunkCache::bakeChunk(SDL_Renderer* renderer, const Map& map, int chunkX, int chunkY,
+                               Chunk& chunk) {
+  const int firstTileX = chunkX * this->chunkTiles;
+  const int firstTileY = chunkY * this->chunkTiles;
+  const int tilesWide = std::min(this->chunkTiles, map.getWidth() - firstTileX);
+  const int tilesHigh = std::min(this->chunkTiles, map.getHeight() - firstTileY);
+  if (tilesWide <= 0 || tilesHigh <= 0) {
+    return;
+  }
+
+  if (!chunk.texture) {
+    chunk.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888,
+                                      SDL_TEXTUREACCESS_TARGET, tilesWide * TILE_SIZE,
+                                      tilesHigh * TILE_SIZE);
+    if (!chunk.texture) {
+      return;
+    }
+    SDL_SetTextureBlendMode(chunk.texture, SDL_BLENDMODE_NONE);
+    SDL_SetTextureScaleMode(chunk.texture, SDL_SCALEMODE_NEAREST);
+  }
+
+  SDL_Texture* previousTarget = SDL_GetRenderTarget(renderer);
+  SDL_SetRenderTarget(renderer, chunk.texture);
+  // Runs of identical tiles in a row are filled with a single rect.
+  for (int y = 0; y < tilesHigh; ++y) {
+    int runStart = 0;
+    while (runStart < tilesWide) {
+      const Tile tile = map.getTile(firstTileX + runStart, firstTileY + y);
+      int runEnd = runStart + 1;
+      while (runEnd < tilesWide && map.getTile(firstTileX + runEnd, firstTileY + y) == tile) {
+        ++runEnd;
+      }
+      const SDL_Color color = tileColor(tile);
+      SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+      const SDL_FRect run = {static_cast<float>(runStart * TILE_SIZE),
+                             static_cast<float>(y * TILE_SIZE),
+                             static_cast<float>((runEnd - runStart) * TILE_SIZE),
+                             static_cast<float>(TILE_SIZE)};
+      SDL_RenderFillRect(renderer, &run);
+      runStart = runEnd;
+    }
+  }
+  SDL_SetRenderTarget(renderer, previousTarget);
+  chunk.dirty = false;
+}
+
+void TileChunkCache::evictLeastRecentlyUsed() {
+  while (this->chunks.size() > this->maxChunks) {
+    auto oldest = this->chunks.end();
+    for (auto it = this->chunks.begin(); it != this->chunks.end(); ++it) {
+      if (it->second.lastUsedFrame >= this->frame) {
+        continue;
+      }
+      if (oldest == this->chunks.end() ||
+          it->second.lastUsedFrame < oldest->second.lastUsedFrame) {
+        oldest = it;
+      }
+    }
+    if (oldest == this->chunks.end()) {
+      return;
+    }
+    if (oldest->second.texture) {
+      SDL_DestroyTexture(oldest->second.texture);
+    }
+    this->chunks.erase(oldest);
+  }
+}
@@ -0,0 +1,264 @@
+#include "world/connectivity.h"
+
+#include <algorithm>
+#include <climits>
+#include <thread>
+
+namespace {
+constexpr int PARALLEL_TILE_THRESHOLD = 512 * 512;
+constexpr int MIN_ROWS_PER_STRIP = 64;
+
+int findRoot(std::vector<int>& parent, int index) {
+  while (parent[index] != index) {
+    parent[index] = parent[parent[index]];
+    index = parent[index];
+  }
+  return index;
+}
+
+// Roots always keep the smaller index, so parent[i] <= i holds for every tile. The final
+// relabelling pass relies on that to resolve each tile from already-labelled predecessors.
+void unite(std::vector<int>& parent, int a, int b) {
+  const int rootA = findRoot(parent, a);
+  const int rootB = findRoot(parent, b);
+  if (rootA == rootB) {
+    return;
+  }
+  if (rootA < rootB) {
+    parent[rootB] = rootA;
+  } else {
+    parent[rootA] = rootB;
+  }
+}
+
+void labelStrip(const std::vector<Tile>& tiles, int width, int rowBegin, int rowEnd,
+                std::vector<int>& parent) {
+  for (int y = rowBegin; y < rowEnd; ++y) {
+    for (int x = 0; x < width; ++x) {
+      const int index = (y * width) + x;
+      if (!isWalkableTile(tiles[index])) {
+        parent[index] = NO_COMPONENT;
+        continue;
+      }
+      parent[index] = index;
+      if (x > 0 && parent[index - 1] != NO_COMPONENT) {
+        unite(parent, index, index - 1);
+      }
+      if (y > rowBegin && parent[index - width] != NO_COMPONENT) {
+        unite(parent, index, index - width);
+      }
+    }
+  }
+}
+
+int stripCountFor(int width, int height) {
+  if (static_cast<long long>(width) * height < PARALLEL_TILE_THRESHOLD) {
+    return 1;
+  }
+  const int hardwareThreads = static_cast<int>(std::max(1U, std::thread::hardware_concurrency()));
+  return std::clamp(height / MIN_ROWS_PER_STRIP, 1, hardwareThreads);
+}
+
+bool regionConnected(const std::vector<Tile>& tiles, const std::vector<int>& components,
+                     std::vector<int>& componentParent, int width, int height,
+                     const Region& region, int hubRoot) {
+  const int minX = std::max(0, region.x);
+  const int minY = std::max(0, region.y);
+  const int maxX = std::min(width, region.x + region.width);
+  const int maxY = std::min(height, region.y + region.height);
+  for (int y = minY; y < maxY; ++y) {
+    for (int x = minX; x < maxX; ++x) {
+      const int index = (y * width) + x;
+      if (isWalkableTile(tiles[index]) &&
+          findRoot(componentParent, components[index]) == hubRoot) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+} // namespace
+
+std::vector<int> labelWalkableComponents(const std::vector<Tile>& tiles, int width, int height) {
+  const int tileCount = width * height;
+  std::vector<int> parent(tileCount, NO_COMPONENT);
+  std::vector<int> components(tileCount, NO_COMPONENT);
+  if (tileCount <= 0) {
+    return components;
+  }
+
+  const int stripCount = stripCountFor(width, height);
+  const int rowsPerStrip = (height + stripCount - 1) / stripCount;
+  if (stripCount == 1) {
+    labelStrip(tiles, width, 0, height, parent);
+  } else {
+    std::vector<std::thread> workers;
+    workers.reserve(stripCount);
+    for (int strip = 0; strip < stripCount; ++strip) {
+      const int rowBegin = strip * rowsPerStrip;
+      const int rowEnd = std::min(height, rowBegin + rowsPerStrip);
+      if (rowBegin >= rowEnd) {
+        break;
+      }
+      workers.emplace_back(labelStrip, std::cref(tiles), width, rowBegin, rowEnd,
+                           std::ref(parent));
+    }
+    for (std::thread& worker : workers) {
+      worker.join();
+    }
+    for (int seam = rowsPerStrip; seam < height; seam += rowsPerStrip) {
+      for (int x = 0; x < width; ++x) {
+        const int index = (seam * width) + x;
+        if (parent[index] != NO_COMPONENT && parent[index - width] != NO_COMPONENT) {
+          unite(parent, index, index - width);
+        }
+      }
+    }
+  }
+
+  int nextComponent = 0;
+  for (int index = 0; index < tileCount; ++index) {
+    const int link = parent[index];
+    if (link == NO_COMPONENT) {
+      continue;
+    }
+    components[index] = link == index ? nextComponent++ : components[link];
+  }
+  return components;
+}
+
+int carveRegionConnections(std::vector<Tile>& tiles, std::vector<int>& components, int width,
+                           int height, const std::vector<Region>& regions, const Coordinate& hub) {
+  if (hub.x < 0 || hub.x >= width || hub.y < 0 || hub.y >= height) {
+    return 0;
+  }
+  const int tileCount = width * height;
+  int componentCount = 0;
+  for (int component : components) {
+    componentCount = std::max(componentCount, component + 1);
+  }
+  std::vector<int> componentParent(componentCount);
+  for (int component = 0; component < componentCount; ++component) {
+    componentParent[component] = component;
+  }
+
+  int carved = 0;
+  auto carveTile = [&](int index, int hubComponent) {
+    tiles[index] = Tile::Grass;
+    components[index] = hubComponent;
+    carved += 1;
+    const int x = index % width;
+    const int y = index / width;
+    const int neighbors[4] = {x > 0 ? index - 1 : -1, x + 1 < width ? index + 1 : -1,
+                              y > 0 ? index - width : -1, y + 1 < height ? index + width : -1};
+    for (int neighbor : neighbors) {
+      if (neighbor >= 0 && components[neighbor] != NO_COMPONENT) {
+        unite(componentParent, hubComponent, components[neighbor]);
+      }
+    }
+  };
+
+  const int hubIndex = (hub.y * width) + hub.x;
+  if (components[hubIndex] == NO_COMPONENT) {
+    componentParent.push_back(componentCount);
+    carveTile(hubIndex, componentCount);
+    componentCount += 1;
+  }
+  const int hubComponent = components[hubIndex];
+  const int initialHubRoot = findRoot(componentParent, hubComponent);
+
+  std::vector<const Region*> disconnected;
+  for (const Region& region : regions) {
+    if (region.type == RegionType::StartingZone) {
+      continue;
+    }
+    if (!regionConnected(tiles, components, componentParent, width, height, region,
+                         initialHubRoot)) {
+      disconnected.push_back(&region);
+    }
+  }
+  if (disconnected.empty()) {
+    return carved;
+  }
+
+  // One 0-1 BFS grown from the hub component, where stepping onto a blocked tile costs one carve.
+  // Every disconnected region is then joined along the shortest-path tree, so corridors to
+  // neighbouring regions share their common prefix.
+  std::vector<int> cost(tileCount, INT_MAX);
+  std::vector<int> previous(tileCount, -1);
+  std::vector<int> currentBucket;
+  std::vector<int> nextBucket;
+  for (int index = 0; index < tileCount; ++index) {
+    if (components[index] != NO_COMPONENT &&
+        findRoot(componentParent, components[index]) == initialHubRoot) {
+      cost[index] = 0;
+      currentBucket.push_back(index);
+    }
+  }
+  for (int level = 0; !currentBucket.empty(); ++level) {
+    for (std::size_t next = 0; next < currentBucket.size(); ++next) {
+      const int index = currentBucket[next];
+      if (cost[index] != level) {
+        continue;
+      }
+      const int x = index % width;
+      const int y = index / width;
+      const int neighbors[4] = {x > 0 ? index - 1 : -1, x + 1 < width ? index + 1 : -1,
+                                y > 0 ? index - width : -1, y + 1 < height ? index + width : -1};
+      for (int neighbor : neighbors) {
+        if (neighbor < 0) {
+          continue;
+        }
+        const int step = isWalkableTile(tiles[neighbor]) ? 0 : 1;
+        if (cost[neighbor] <= level + step) {
+          continue;
+        }
+        cost[neighbor] = level + step;
+        previous[neighbor] = index;
+        (step == 0 ? currentBucket : nextBucket).push_back(neighbor);
+      }
+    }
+    currentBucket.clear();
+    std::swap(currentBucket, nextBucket);
+  }
+
+  for (const Region* region : disconnected) {
+    const int hubRoot = findRoot(componentParent, hubComponent);
+    if (regionConnected(tiles, components, componentParent, width, height, *region, hubRoot)) {
+      continue;
+    }
+    int target = -1;
+    for (int y = std::max(0, region->y); y < std::min(height, region->y + region->height); ++y) {
+      for (int x = std::max(0, region->x); x < std::min(width, region->x + region->width); ++x) {
+        const int index = (y * width) + x;
+        if (target < 0 || cost[index] < cost[target]) {
+          target = index;
+        }
+      }
+    }
+    for (int index = target; index >= 0; index = previous[index]) {
+      if (!isWalkableTile(tiles[index])) {
+        carveTile(index, hubComponent);
+      } else {
+        unite(componentParent, hubComponent, components[index]);
+      }
+    }
+  }
+
+  if (carved == 0) {
+    return 0;
+  }
+  std::vector<int> denseIds(componentCount, NO_COMPONENT);
+  int nextComponent = 0;
+  for (int& component : components) {
+    if (component == NO_COMPONENT) {
+      continue;
+    }
+    const int root = findRoot(componentParent, component);
+    if (denseIds[root] == NO_COMPONENT) {
+      denseIds[root] = nextComponent++;
+    }
+    component = denseIds[root];
+  }
+  return carved;
+}
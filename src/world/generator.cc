@@ -5,7 +5,7 @@
 std::unique_ptr<Map> Generator::generate() {
   int width = 128;
   int height = 128;
-  std::unordered_map<Coordinate, Tile> tiles;
+  std::vector<Tile> tiles(static_cast<std::size_t>(width) * height, Tile::Grass);
   std::vector<Region> regions;
   int startZoneSize = 20;
   int startZoneX = (width - startZoneSize) / 2;
@@ -33,20 +33,23 @@ std::unique_ptr<Map> Generator::generate() {
     for (int x = 0; x < width; ++x) {
       if (x >= startZoneX && x < startZoneX + startZoneSize && y >= startZoneY &&
           y < startZoneY + startZoneSize) {
-        tiles[Coordinate(x, y)] = Tile::Town;
+        tiles[(y * width) + x] = Tile::Town;
       } else if (x % 5 == 0 && y % 5 == 0) {
-        tiles[Coordinate(x, y)] = Tile::Water;
+        tiles[(y * width) + x] = Tile::Water;
       } else if (x % 7 == 0 && y % 7 == 0) {
-        tiles[Coordinate(x, y)] = Tile::Mountain;
+        tiles[(y * width) + x] = Tile::Mountain;
       } else {
-        tiles[Coordinate(x, y)] = Tile::Grass;
+        tiles[(y * width) + x] = Tile::Grass;
       }
     }
   }
   for (const auto& region : regions) {
     if (region.type == RegionType::DungeonEntrance) {
-      tiles[Coordinate(region.x, region.y)] = Tile::DungeonEntrance;
+      tiles[(region.y * width) + region.x] = Tile::DungeonEntrance;
     }
   }
-  return std::make_unique<Map>(width, height, tiles, std::move(regions), startingPosition);
+  auto map =
+      std::make_unique<Map>(width, height, std::move(tiles), std::move(regions), startingPosition);
+  map->connectRegions();
+  return map;
 }
@@ -5,10 +5,36 @@
 
 #include "world/map.h"
 
-Map::Map(int width, int height, std::unordered_map<Coordinate, Tile> tiles,
+namespace {
+std::vector<Tile> flattenTiles(int width, int height,
+                               const std::unordered_map<Coordinate, Tile>& tiles) {
+  std::vector<Tile> flat(static_cast<std::size_t>(width) * height, Tile::Grass);
+  for (const auto& tile : tiles) {
+    if (tile.first.x >= 0 && tile.first.x < width && tile.first.y >= 0 &&
+        tile.first.y < height) {
+      flat[(tile.first.y * width) + tile.first.x] = tile.second;
+    }
+  }
+  return flat;
+}
+} // namespace
+
+Map::Map(int width, int height, std::vector<Tile> tiles, std::vector<Region> regions,
+         Coordinate startingPosition)
+    : tiles(std::move(tiles)), regions(std::move(regions)), startingPosition(startingPosition),
+      width(width), height(height) {
+  this->components = labelWalkableComponents(this->tiles, width, height);
+}
+
+Map::Map(int width, int height, const std::unordered_map<Coordinate, Tile>& tiles,
          std::vector<Region> regions, Coordinate startingPosition)
-    : width(width), height(height), tiles(std::move(tiles)), regions(std::move(regions)),
-      startingPosition(startingPosition) {}
+    : Map(width, height, flattenTiles(width, height, tiles), std::move(regions),
+          startingPosition) {}
+
+int Map::connectRegions() {
+  return carveRegionConnections(this->tiles, this->components, this->width, this->height,
+                                this->regions, this->startingPosition);
+}
 
 void Map::print() {
   /*
@@ -40,9 +66,11 @@ void Map::print() {
   cv::Scalar goblinOverlay(80, 200, 120);
   cv::Scalar dungeonOverlay(255, 120, 60);
   cv::Mat mapImage(height, width, CV_8UC3, cv::Scalar(0, 0, 0));
-  for (const auto& tile : tiles) {
+  for (int index = 0; index < width * height; ++index) {
+    const int tileX = index % width;
+    const int tileY = index / width;
     cv::Scalar color;
-    switch (tile.second) {
+    switch (tiles[index]) {
     case Tile::Grass:
       color = grassColor;
       break;
@@ -60,7 +88,7 @@ void Map::print() {
       break;
     }
     for (const auto& region : regions) {
-      if (region.contains(tile.first.x, tile.first.y)) {
+      if (region.contains(tileX, tileY)) {
         switch (region.type) {
         case RegionType::StartingZone:
           color = startZoneOverlay;
@@ -77,7 +105,7 @@ void Map::print() {
         }
       }
     }
-    mapImage.at<cv::Vec3b>(tile.first.y, tile.first.x) = cv::Vec3b(color[0], color[1], color[2]);
+    mapImage.at<cv::Vec3b>(tileY, tileX) = cv::Vec3b(color[0], color[1], color[2]);
   }
   cv::imwrite("map_debug.png", mapImage);
 }
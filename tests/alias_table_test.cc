@@ -0,0 +1,73 @@
+#include "alias_table.h"
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace {
+int failures = 0;
+
+void expect(bool condition, const char* message) {
+  if (!condition) {
+    std::cerr << "FAIL: " << message << "\n";
+    failures += 1;
+  }
+}
+
+bool followsWeights(const std::vector<int>& weights, std::uint64_t seed) {
+  const AliasTable table(weights);
+  int total = 0;
+  for (int weight : weights) {
+    total += weight > 0 ? weight : 0;
+  }
+  constexpr int kSamples = 400000;
+  std::vector<int> counts(weights.size(), 0);
+  Rng rng(seed);
+  for (int i = 0; i < kSamples; ++i) {
+    counts[table.sample(rng)] += 1;
+  }
+  for (std::size_t i = 0; i < weights.size(); ++i) {
+    const double expected = weights[i] > 0 ? static_cast<double>(weights[i]) / total : 0.0;
+    const double observed = static_cast<double>(counts[i]) / kSamples;
+    if (std::abs(observed - expected) > 0.005 || (expected == 0.0 && counts[i] != 0)) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+int main() {
+  expect(followsWeights({70, 25, 5}, 1), "rarity weights are followed");
+  expect(followsWeights({1, 1, 1, 1, 1, 1, 1}, 2), "uniform weights are followed");
+  expect(followsWeights({0, 10, 0, 30, -4, 60}, 3), "zero and negative weights never come up");
+  expect(followsWeights({1000000, 1}, 4), "skewed weights are followed");
+  expect(followsWeights({5}, 5), "a single outcome always comes up");
+
+  {
+    AliasTable table({0, 0});
+    expect(table.empty(), "no positive weight leaves the table empty");
+    table.build({3, 1});
+    expect(!table.empty() && table.size() == 2, "a table can be rebuilt");
+  }
+
+  {
+    const AliasTable table({3, 9, 1, 7});
+    Rng a(77);
+    Rng b(77);
+    bool same = true;
+    for (int i = 0; i < 1000; ++i) {
+      same = same && table.sample(a) == table.sample(b);
+    }
+    expect(same, "sampling is deterministic for a fixed seed");
+    CounterRng counter(77, RngPurpose::Loot, 1, 1);
+    expect(table.sample(counter) < table.size(), "samples from a counter stream");
+  }
+
+  if (failures > 0) {
+    std::cerr << failures << " test(s) failed.\n";
+    return EXIT_FAILURE;
+  }
+  std::cout << "All alias table tests passed.\n";
+  return EXIT_SUCCESS;
+}
@@ -1,6 +1,7 @@
 #include "ui/character_stats.h"
 #include <cstdlib>
 #include <iostream>
+#include <vector>
 
 namespace {
 int failures = 0;
@@ -25,12 +26,24 @@ int main() {
   const int clickX = static_cast<int>(plusRect.x + (plusRect.w / 2.0f));
   const int clickY = static_cast<int>(plusRect.y + (plusRect.h / 2.0f));
 
-  statsUi.handleInput(clickX, clickY, true, windowWidth, stats, true);
-  statsUi.handleInput(clickX, clickY, false, windowWidth, stats, true);
-  statsUi.handleInput(clickX, clickY, true, windowWidth, stats, true);
-
-  expect(stats.strength == 6, "clicking STR plus increases strength");
-  expect(stats.unspentPoints == 0, "unspent points decremented");
+  std::vector<PanelCommand> commands;
+  statsUi.handleInput(clickX, clickY, true, windowWidth, stats, true, commands);
+  statsUi.handleInput(clickX, clickY, true, windowWidth, stats, true, commands);
+  expect(commands.size() == 1, "holding the button queues one command");
+  statsUi.handleInput(clickX, clickY, false, windowWidth, stats, true, commands);
+  statsUi.handleInput(clickX, clickY, true, windowWidth, stats, true, commands);
+
+  expect(commands.size() == 2, "each click queues a command");
+  const PanelCommand spendStrength{PanelCommandType::SpendStatPoint, 0};
+  expect(!commands.empty() && commands.front() == spendStrength,
+         "clicking STR plus asks to spend a point on strength");
+  expect(stats.strength == 5 && stats.unspentPoints == 1,
+         "the panel leaves the stats to the simulation");
+
+  stats.unspentPoints = 0;
+  statsUi.handleInput(clickX, clickY, false, windowWidth, stats, true, commands);
+  statsUi.handleInput(clickX, clickY, true, windowWidth, stats, true, commands);
+  expect(commands.size() == 2, "no command without unspent points");
 
   if (failures > 0) {
     std::cerr << failures << " test(s) failed.\n";
@@ -0,0 +1,71 @@
+#include "simulation/game_rules.h"
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+int failures = 0;
+
+void expect(bool condition, const char* message) {
+  if (!condition) {
+    std::cerr << "FAIL: " << message << "\n";
+    failures += 1;
+  }
+}
+} // namespace
+
+int main() {
+  const ItemDatabase database;
+  DerivedStatsComponent derived;
+  StatsComponent stats;
+  EquipmentComponent equipment;
+  BuffComponent buffs;
+  const int level = 1;
+  const CharacterClass characterClass = CharacterClass::Warrior;
+
+  expect(refreshDerivedStats(derived, stats, equipment, buffs, level, characterClass, database),
+         "first refresh computes");
+  expect(!refreshDerivedStats(derived, stats, equipment, buffs, level, characterClass, database),
+         "unchanged inputs skip the recompute");
+  const int unarmedPower = derived.attackPower;
+  expect(unarmedPower == computeAttackPower(stats, equipment, database, characterClass),
+         "cached attack power matches the formula");
+
+  equipment.equipped[ItemSlot::Weapon] = ItemInstance{5};
+  expect(!refreshDerivedStats(derived, stats, equipment, buffs, level, characterClass, database),
+         "changes without a version bump stay cached");
+  equipment.version += 1;
+  expect(refreshDerivedStats(derived, stats, equipment, buffs, level, characterClass, database),
+         "equipment version change recomputes");
+  expect(derived.attackPower == computeAttackPower(stats, equipment, database, characterClass),
+         "attack power includes the new weapon");
+  expect(derived.attackPower > unarmedPower, "the spear adds strength");
+  expect(derived.attackProfile.range == attackProfileForWeapon(equipment, database).range,
+         "attack profile follows the weapon");
+  expect(derived.armor == computeArmor(stats, equipment, database), "armor matches the formula");
+
+  stats.luck += 40;
+  stats.version += 1;
+  const float previousCrit = derived.critChance;
+  expect(refreshDerivedStats(derived, stats, equipment, buffs, level, characterClass, database),
+         "stats version change recomputes");
+  expect(derived.critChance > previousCrit, "luck raises crit chance");
+  expect(derived.primary.luck == stats.luck, "effective luck is cached");
+
+  expect(refreshDerivedStats(derived, stats, equipment, buffs, level + 1, characterClass, database),
+         "level change recomputes");
+  buffs.version += 1;
+  expect(refreshDerivedStats(derived, stats, equipment, buffs, level + 1, characterClass, database),
+         "buff change recomputes");
+  expect(refreshDerivedStats(derived, stats, equipment, buffs, level + 1, CharacterClass::Rogue,
+                             database),
+         "class change recomputes");
+  expect(derived.attackPower == stats.baseAttackPower + derived.primary.luck,
+         "rogue power follows luck");
+
+  if (failures > 0) {
+    std::cerr << failures << " test(s) failed.\n";
+    return EXIT_FAILURE;
+  }
+  std::cout << "All derived stats tests passed.\n";
+  return EXIT_SUCCESS;
+}
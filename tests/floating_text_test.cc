@@ -0,0 +1,71 @@
+#include "events/event_bus.h"
+#include "ui/floating_text_system.h"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace {
+int failures = 0;
+
+void expect(bool condition, const char* message) {
+  if (!condition) {
+    std::cerr << "FAIL: " << message << "\n";
+    failures += 1;
+  }
+}
+
+FloatingTextEvent damageEvent(int amount, int targetId,
+                              FloatingTextKind kind = FloatingTextKind::Damage) {
+  return FloatingTextEvent{{}, Position{100.0f, 100.0f}, kind, amount, targetId};
+}
+} // namespace
+
+int main() {
+  EventBus eventBus;
+  FloatingTextSystem system(eventBus, 8);
+
+  eventBus.emitFloatingTextEvent(damageEvent(12, 5));
+  eventBus.emitFloatingTextEvent(damageEvent(30, 5, FloatingTextKind::CritDamage));
+  eventBus.emitFloatingTextEvent(damageEvent(7, 6));
+  system.update(0.016f);
+  expect(system.getFloatingTexts().size() == 2, "hits on one target merge into one label");
+  expect(system.getFloatingTexts()[0].view() == "42", "merged label shows the running total");
+  expect(system.getFloatingTexts()[0].kind == FloatingTextKind::CritDamage,
+         "a crit upgrades the merged label");
+
+  eventBus.emitFloatingTextEvent(
+      FloatingTextEvent{{}, Position{}, FloatingTextKind::Heal, 9, 5, "+"});
+  eventBus.emitFloatingTextEvent(
+      FloatingTextEvent{{}, Position{}, FloatingTextKind::Info, 25, -1, "XP +"});
+  system.update(0.016f);
+  expect(system.getFloatingTexts().size() == 4, "heals and info labels do not merge with damage");
+  expect(system.getFloatingTexts()[2].view() == "+9", "prefixes are kept");
+  expect(system.getFloatingTexts()[3].view() == "XP +25", "info amounts are formatted");
+
+  system.update(0.5f);
+  eventBus.emitFloatingTextEvent(damageEvent(1, 6));
+  system.update(0.016f);
+  expect(system.getFloatingTexts().size() == 5, "hits after the merge window start a new label");
+
+  for (int i = 0; i < 20; ++i) {
+    eventBus.emitFloatingTextEvent(FloatingTextEvent{"Miss", Position{}, FloatingTextKind::Info});
+  }
+  system.update(0.016f);
+  expect(system.getFloatingTexts().size() == 8, "labels are capped at the visible limit");
+
+  eventBus.emitFloatingTextEvent(
+      FloatingTextEvent{std::string(80, 'x'), Position{}, FloatingTextKind::Info});
+  system.update(0.016f);
+  expect(system.getFloatingTexts().back().view().size() == FloatingTextSystem::MAX_TEXT_LENGTH,
+         "long text is truncated to the label buffer");
+
+  system.update(1.0f);
+  expect(system.getFloatingTexts().empty(), "expired labels are released");
+
+  if (failures > 0) {
+    std::cerr << failures << " test(s) failed.\n";
+    return EXIT_FAILURE;
+  }
+  std::cout << "All floating text tests passed.\n";
+  return EXIT_SUCCESS;
+}
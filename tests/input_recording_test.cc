@@ -0,0 +1,242 @@
+#include "ecs/component/equipment_component.h"
+#include "ecs/component/inventory_component.h"
+#include "ecs/component/skill_tree_component.h"
+#include "ecs/component/stats_component.h"
+#include "simulation/input_recording.h"
+#include "simulation/simulation.h"
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+
+namespace {
+int failures = 0;
+
+void expect(bool condition, const char* message) {
+  if (!condition) {
+    std::cerr << "FAIL: " << message << "\n";
+    failures += 1;
+  }
+}
+
+bool sameFrame(const InputFrame& a, const InputFrame& b) {
+  return a.moveX == b.moveX && a.moveY == b.moveY && a.buttons == b.buttons &&
+         a.mouseX == b.mouseX && a.mouseY == b.mouseY && a.mousePressed == b.mousePressed &&
+         a.mouseWheelDelta == b.mouseWheelDelta && a.commands == b.commands;
+}
+
+// Walks in a square and taps the first skill, so the run moves, fights and changes input often.
+class ScriptedInputSource : public InputSource {
+public:
+  InputFrame nextFrame() override {
+    InputFrame frame;
+    const int leg = (this->tick / 90) % 4;
+    frame.moveX = leg == 0 ? 1 : (leg == 2 ? -1 : 0);
+    frame.moveY = leg == 1 ? 1 : (leg == 3 ? -1 : 0);
+    frame.setDown(InputButton::Skill1, this->tick % 45 == 0);
+    frame.setDown(InputButton::Pickup, this->tick % 60 == 30);
+    if (this->tick % 150 == 100) {
+      frame.commands.push_back(
+          PanelCommand{PanelCommandType::UnequipItem, static_cast<int>(ItemSlot::Weapon)});
+    }
+    if (this->tick % 150 == 140) {
+      frame.commands.push_back(PanelCommand{PanelCommandType::EquipItem, 0});
+    }
+    this->tick += 1;
+    return frame;
+  }
+
+private:
+  int tick = 0;
+};
+
+// Hands out one prepared frame per tick.
+class QueuedInputSource : public InputSource {
+public:
+  InputFrame nextFrame() override {
+    InputFrame frame;
+    frame.commands.swap(this->commands);
+    return frame;
+  }
+
+  std::vector<PanelCommand> commands;
+};
+} // namespace
+
+int main() {
+  const std::filesystem::path path =
+      std::filesystem::temp_directory_path() / "kingdom_of_nin_input_recording_test.bin";
+
+  {
+    InputRecording recording;
+    recording.worldSeed = 1234;
+    InputFrame frame;
+    for (int i = 0; i < 200; ++i) {
+      if (i % 17 == 0) {
+        frame.moveX = (i / 17) % 3 - 1;
+        frame.moveY = -frame.moveX;
+      }
+      frame.setDown(InputButton::Skill3, i % 23 < 4);
+      frame.setDown(InputButton::ClassChoice4, i % 41 == 0);
+      if (i % 7 == 0) {
+        frame.mouseX = static_cast<float>(i) * 1.5f;
+        frame.mouseY = 480.0f - static_cast<float>(i);
+      }
+      frame.mousePressed = i % 29 < 3;
+      frame.mouseWheelDelta = i % 31 == 0 ? -1.0f : 0.0f;
+      frame.commands.clear();
+      if (i % 13 == 0) {
+        frame.commands.push_back(PanelCommand{PanelCommandType::SellItem, i % 16});
+      }
+      if (i % 26 == 0) {
+        frame.commands.push_back(PanelCommand{PanelCommandType::UnlockSkill, 300 + i});
+      }
+      recording.frames.push_back(frame);
+      recording.stateHashes.push_back(0x9E3779B97F4A7C15ULL * static_cast<std::uint64_t>(i));
+    }
+    expect(saveInputRecording(path.string(), recording), "recording saves");
+    const std::optional<InputRecording> loaded = loadInputRecording(path.string());
+    expect(loaded.has_value(), "recording loads");
+    if (loaded) {
+      expect(loaded->worldSeed == recording.worldSeed, "seed round-trips");
+      expect(loaded->frames.size() == recording.frames.size(), "frame count round-trips");
+      expect(loaded->stateHashes == recording.stateHashes, "hashes round-trip");
+      bool framesMatch = loaded->frames.size() == recording.frames.size();
+      for (std::size_t i = 0; framesMatch && i < recording.frames.size(); ++i) {
+        framesMatch = sameFrame(loaded->frames[i], recording.frames[i]);
+      }
+      expect(framesMatch, "frames round-trip");
+    }
+  }
+
+  {
+    InputRecording idle;
+    idle.frames.resize(1000);
+    expect(saveInputRecording(path.string(), idle), "idle recording saves");
+    expect(std::filesystem::file_size(path) < 1000 + 32, "idle frames take a byte each");
+  }
+
+  {
+    expect(!loadInputRecording(path.string() + ".missing").has_value(),
+           "missing recording is rejected");
+    InputRecording recording;
+    recording.frames.resize(10);
+    recording.frames[5].mouseX = 12.0f;
+    saveInputRecording(path.string(), recording);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3);
+    expect(!loadInputRecording(path.string()).has_value(), "truncated recording is rejected");
+  }
+
+  {
+    Simulation simulation(77);
+    Registry& registry = simulation.getRegistry();
+    const int playerId = simulation.getPlayerEntityId();
+    const EquipmentComponent& equipment = registry.getComponent<EquipmentComponent>(playerId);
+    const InventoryComponent& inventory = registry.getComponent<InventoryComponent>(playerId);
+    StatsComponent& stats = registry.getComponent<StatsComponent>(playerId);
+    QueuedInputSource input;
+    simulation.update(1.0f / 60.0f, input);
+
+    const bool hadWeapon = equipment.equipped.count(ItemSlot::Weapon) > 0;
+    const std::size_t itemsBefore = inventory.items.size();
+    input.commands.push_back(
+        PanelCommand{PanelCommandType::UnequipItem, static_cast<int>(ItemSlot::Weapon)});
+    simulation.update(1.0f / 60.0f, input);
+    expect(hadWeapon && equipment.equipped.count(ItemSlot::Weapon) == 0,
+           "unequip command takes off the weapon");
+    expect(inventory.items.size() == itemsBefore + 1, "unequipped weapon lands in the inventory");
+
+    const int gold = stats.gold;
+    input.commands.push_back(
+        PanelCommand{PanelCommandType::SellItem, static_cast<int>(itemsBefore)});
+    simulation.update(1.0f / 60.0f, input);
+    expect(stats.gold == gold && inventory.items.size() == itemsBefore + 1,
+           "selling needs an open shop");
+
+    input.commands.push_back(
+        PanelCommand{PanelCommandType::EquipItem, static_cast<int>(itemsBefore)});
+    simulation.update(1.0f / 60.0f, input);
+    expect(equipment.equipped.count(ItemSlot::Weapon) == 1, "equip command puts it back");
+
+    stats.unspentPoints = 1;
+    const int strength = stats.strength;
+    input.commands.push_back(PanelCommand{PanelCommandType::SpendStatPoint, 0});
+    input.commands.push_back(PanelCommand{PanelCommandType::SpendStatPoint, 1});
+    simulation.update(1.0f / 60.0f, input);
+    expect(stats.strength == strength + 1 && stats.unspentPoints == 0,
+           "stat command spends the only point, and the second finds none");
+  }
+
+  {
+    // Same counts, different contents: the hash must still tell the runs apart.
+    QueuedInputSource input;
+    Simulation first(31);
+    Simulation second(31);
+    first.update(1.0f / 60.0f, input);
+    second.update(1.0f / 60.0f, input);
+    expect(first.computeStateHash() == second.computeStateHash(), "same seed, same hash");
+    Registry& firstRegistry = first.getRegistry();
+    Registry& secondRegistry = second.getRegistry();
+    const int firstPlayer = first.getPlayerEntityId();
+    const int secondPlayer = second.getPlayerEntityId();
+
+    InventoryComponent& firstInventory =
+        firstRegistry.getComponent<InventoryComponent>(firstPlayer);
+    InventoryComponent& secondInventory =
+        secondRegistry.getComponent<InventoryComponent>(secondPlayer);
+    firstInventory.items.push_back(ItemInstance{1});
+    secondInventory.items.push_back(ItemInstance{2});
+    expect(first.computeStateHash() != second.computeStateHash(), "hash covers inventory ids");
+    secondInventory.items.back().itemId = 1;
+
+    EquipmentComponent& firstEquipment =
+        firstRegistry.getComponent<EquipmentComponent>(firstPlayer);
+    EquipmentComponent& secondEquipment =
+        secondRegistry.getComponent<EquipmentComponent>(secondPlayer);
+    firstEquipment.equipped[ItemSlot::Cape] = ItemInstance{1};
+    secondEquipment.equipped[ItemSlot::Cape] = ItemInstance{2};
+    expect(first.computeStateHash() != second.computeStateHash(), "hash covers equipped ids");
+    secondEquipment.equipped[ItemSlot::Cape] = ItemInstance{1};
+
+    firstRegistry.getComponent<SkillTreeComponent>(firstPlayer).unlockedSkills.insert(1);
+    secondRegistry.getComponent<SkillTreeComponent>(secondPlayer).unlockedSkills.insert(2);
+    expect(first.computeStateHash() != second.computeStateHash(), "hash covers unlocked skills");
+  }
+
+  {
+    constexpr int kTicks = 600;
+    constexpr float kDt = 1.0f / 60.0f;
+    Simulation recorded(77);
+    ScriptedInputSource script;
+    RecordingInputSource recorder(script, recorded.getWorldSeed());
+    for (int i = 0; i < kTicks; ++i) {
+      recorded.update(kDt, recorder);
+      recorder.recordStateHash(recorded.computeStateHash());
+    }
+    expect(saveInputRecording(path.string(), recorder.getRecording()), "session saves");
+
+    const std::optional<InputRecording> session = loadInputRecording(path.string());
+    expect(session.has_value(), "session loads");
+    if (session) {
+      Simulation replayed(session->worldSeed);
+      ReplayInputSource replay(*session);
+      bool hashesMatch = true;
+      for (std::size_t i = 0; i < session->frames.size(); ++i) {
+        replayed.update(kDt, replay);
+        hashesMatch = hashesMatch && replayed.computeStateHash() == session->stateHashes[i];
+      }
+      expect(replay.isFinished(), "replay consumes every frame");
+      expect(hashesMatch, "replay reproduces every tick's state hash");
+      expect(replayed.computeStateHash() == recorded.computeStateHash(),
+             "replay ends in the recorded state");
+    }
+  }
+
+  std::filesystem::remove(path);
+
+  if (failures > 0) {
+    std::cerr << failures << " test(s) failed.\n";
+    return EXIT_FAILURE;
+  }
+  std::cout << "All input recording tests passed.\n";
+  return EXIT_SUCCESS;
+}
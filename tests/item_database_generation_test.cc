@@ -1,7 +1,7 @@
 #include "items/item_database.h"
 #include <cstdlib>
 #include <iostream>
-#include <random>
+#include <type_traits>
 
 namespace {
 int failures = 0;
@@ -16,7 +16,7 @@ void expect(bool condition, const char* message) {
 
 int main() {
   ItemDatabase database;
-  std::mt19937 rng(1337);
+  Rng rng(1337);
 
   {
     const int itemId = database.generateEquipmentDrop(75, CharacterClass::Warrior, rng);
@@ -24,8 +24,10 @@ int main() {
     expect(def != nullptr, "generated item exists");
     if (def) {
       expect(def->requiredLevel == 60, "generated level is clamped to level cap");
-      expect(def->allowedClasses.count(CharacterClass::Warrior) > 0,
+      expect(canEquipForClass(*def, CharacterClass::Warrior),
              "generated item is usable by preferred class");
+      expect(!canEquipForClass(*def, CharacterClass::Mage),
+             "generated item is limited to the preferred class");
       expect(armorForItem(*def) > 0 || def->slot == ItemSlot::Weapon,
              "generated item has armor when applicable");
       const PrimaryStatBonuses& primary = primaryStatsForItem(*def);
@@ -51,6 +53,23 @@ int main() {
     expect(rareOrBetter > 0, "rarity roll can generate rare or epic items");
   }
 
+  {
+    static_assert(std::is_trivially_copyable_v<ItemDef>, "ItemDef stays plain data");
+    const ItemDef* bow = database.getItem(6);
+    const ItemDef* sword = database.getItem(1);
+    expect(bow && database.itemName(*bow) == "Basic Bow", "base names come from the pool");
+    expect(bow && canEquipForClass(*bow, CharacterClass::Archer) &&
+               !canEquipForClass(*bow, CharacterClass::Warrior) &&
+               !canEquipForClass(*bow, CharacterClass::Any),
+           "class-locked base item only fits its class");
+    expect(sword && canEquipForClass(*sword, CharacterClass::Any) &&
+               canEquipForClass(*sword, CharacterClass::Rogue),
+           "unrestricted base item fits every class");
+    expect(database.getItem(0) == nullptr && database.getItem(9) == nullptr &&
+               database.getItem(-3) == nullptr,
+           "unknown ids do not resolve");
+  }
+
   if (failures > 0) {
     std::cerr << failures << " test(s) failed.\n";
     return EXIT_FAILURE;
@@ -0,0 +1,147 @@
+#include "ecs/component/equipment_component.h"
+#include "ecs/component/inventory_component.h"
+#include "ecs/component/loot_component.h"
+#include "ecs/registry.h"
+#include "items/item_database.h"
+#include "mobs/mob_database.h"
+#include "simulation/item_sweeper.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace {
+int failures = 0;
+
+void expect(bool condition, const char* message) {
+  if (!condition) {
+    std::cerr << "FAIL: " << message << "\n";
+    failures += 1;
+  }
+}
+
+constexpr int KILL_COUNT = 1000000;
+constexpr std::size_t GROUND_LOOT = 40;
+} // namespace
+
+int main() {
+  {
+    // A million kills: drops sit on the ground for a while, some get picked up and later sold,
+    // and one is worn throughout. The simulation's sweeper keeps the generated set bounded by
+    // what is held.
+    ItemDatabase items;
+    MobDatabase mobs;
+    Registry registry;
+    ItemSweeper sweeper;
+    Rng rng(2024);
+    const int playerEntityId = registry.createEntity();
+    registry.registerComponentForEntity<InventoryComponent>(
+        std::make_unique<InventoryComponent>(), playerEntityId);
+    registry.registerComponentForEntity<EquipmentComponent>(
+        std::make_unique<EquipmentComponent>(), playerEntityId);
+    std::vector<int> lootEntityIds;
+    for (std::size_t i = 0; i < GROUND_LOOT; ++i) {
+      const int lootEntityId = registry.createEntity();
+      registry.registerComponentForEntity<LootComponent>(std::make_unique<LootComponent>(),
+                                                         lootEntityId);
+      lootEntityIds.push_back(lootEntityId);
+    }
+    InventoryComponent& inventory = registry.getComponent<InventoryComponent>(playerEntityId);
+    EquipmentComponent& equipment = registry.getComponent<EquipmentComponent>(playerEntityId);
+
+    std::size_t peakGenerated = 0;
+    std::size_t nextGroundSlot = 0;
+    int firstDrop = -1;
+    int drops = 0;
+    int sweeps = 0;
+    bool thresholdFollowsSurvivors = true;
+    const std::vector<MobArchetype>& archetypes = mobs.allArchetypes();
+    for (int kill = 0; kill < KILL_COUNT; ++kill) {
+      const MobArchetype& mob = archetypes[static_cast<std::size_t>(kill) % archetypes.size()];
+      if (const EquipmentDropTable* table = mobs.rollEquipmentDrop(mob.type, rng)) {
+        const int itemId = items.generateEquipmentDrop(1 + (kill % 60), CharacterClass::Any, rng,
+                                                        *table);
+        drops += 1;
+        if (firstDrop < 0) {
+          firstDrop = itemId;
+        } else if (equipment.equipped.empty()) {
+          equipment.equipped[ItemSlot::Weapon] = ItemInstance{itemId};
+        } else {
+          // The oldest drop on the ground expires; every fourth is picked up instead, selling
+          // the oldest inventory item to make room.
+          LootComponent& loot = registry.getComponent<LootComponent>(lootEntityIds[nextGroundSlot]);
+          if (loot.itemId != 0 && kill % 4 == 0) {
+            if (!inventory.addItem(ItemInstance{loot.itemId})) {
+              inventory.removeItemAt(0);
+              inventory.addItem(ItemInstance{loot.itemId});
+            }
+          }
+          loot.itemId = itemId;
+          nextGroundSlot = (nextGroundSlot + 1) % GROUND_LOOT;
+        }
+      }
+      if (sweeper.sweep(items, registry, lootEntityIds, playerEntityId)) {
+        sweeps += 1;
+        thresholdFollowsSurvivors =
+            thresholdFollowsSurvivors &&
+            sweeper.getThreshold() ==
+                std::max(ItemSweeper::MIN_THRESHOLD, items.generatedItemCount() * 2);
+      }
+      peakGenerated = std::max(peakGenerated, items.generatedItemCount());
+    }
+    expect(drops > KILL_COUNT / 4, "the run generates plenty of drops");
+    expect(sweeps > 1000, "the sweeper runs as drops accumulate");
+    expect(thresholdFollowsSurvivors, "the next sweep waits for the survivors to double");
+    expect(peakGenerated <= ItemSweeper::MIN_THRESHOLD, "generated items stay bounded");
+    expect(items.getItem(firstDrop) == nullptr, "a released item no longer resolves");
+    bool heldItemsResolve = true;
+    for (int lootEntityId : lootEntityIds) {
+      const int itemId = registry.getComponent<LootComponent>(lootEntityId).itemId;
+      heldItemsResolve = heldItemsResolve && items.getItem(itemId) != nullptr;
+    }
+    for (const ItemInstance& item : inventory.items) {
+      heldItemsResolve = heldItemsResolve && items.getItem(item.itemId) != nullptr;
+    }
+    expect(heldItemsResolve, "items still on the ground or in the inventory resolve");
+    expect(items.getItem(equipment.equipped[ItemSlot::Weapon].itemId) != nullptr,
+           "equipped items are never released");
+    expect(items.getItem(1) != nullptr, "base items are never released");
+  }
+
+  {
+    // The same rolls give the same items, and names are built on request from the roll.
+    ItemDatabase a;
+    ItemDatabase b;
+    Rng rngA(9);
+    Rng rngB(9);
+    bool sameItems = true;
+    bool namesMatch = true;
+    for (int i = 0; i < 200; ++i) {
+      const ItemDef* defA = a.getItem(a.generateEquipmentDrop(30, CharacterClass::Mage, rngA));
+      const ItemDef* defB = b.getItem(b.generateEquipmentDrop(30, CharacterClass::Mage, rngB));
+      if (!defA || !defB) {
+        sameItems = false;
+        continue;
+      }
+      const PrimaryStatBonuses& primaryA = primaryStatsForItem(*defA);
+      const PrimaryStatBonuses& primaryB = primaryStatsForItem(*defB);
+      sameItems = sameItems && defA->slot == defB->slot && defA->rarity == defB->rarity &&
+                  armorForItem(*defA) == armorForItem(*defB) && defA->price == defB->price &&
+                  primaryA.intellect == primaryB.intellect && primaryA.luck == primaryB.luck;
+      const std::string name = a.itemName(*defA);
+      namesMatch = namesMatch && !name.empty() && name == b.itemName(*defB) &&
+                   name == a.itemName(*defA) && name.find("Mage") != std::string::npos;
+    }
+    expect(sameItems, "generation is deterministic for a fixed seed");
+    expect(namesMatch, "generated names are stable and describe the roll");
+    expect(a.itemName(*a.getItem(1)) == "Basic Sword", "base items keep their own names");
+  }
+
+  if (failures > 0) {
+    std::cerr << failures << " test(s) failed.\n";
+    return EXIT_FAILURE;
+  }
+  std::cout << "All item lifecycle tests passed.\n";
+  return EXIT_SUCCESS;
+}
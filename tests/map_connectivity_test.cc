@@ -0,0 +1,94 @@
+#include "world/connectivity.h"
+#include "world/generator.h"
+#include "world/map.h"
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace {
+int failures = 0;
+
+void expect(bool condition, const char* message) {
+  if (!condition) {
+    std::cerr << "FAIL: " << message << "\n";
+    failures += 1;
+  }
+}
+} // namespace
+
+int main() {
+  {
+    const int width = 7;
+    const int height = 3;
+    std::vector<Tile> tiles(width * height, Tile::Grass);
+    for (int y = 0; y < height; ++y) {
+      tiles[(y * width) + 3] = Tile::Water;
+    }
+    const std::vector<int> components = labelWalkableComponents(tiles, width, height);
+    expect(components[0] == 0, "first walkable tile starts component zero");
+    expect(components[3] == NO_COMPONENT, "water has no component");
+    expect(components[(2 * width) + 2] == components[0], "left side is one component");
+    expect(components[4] == 1, "right side is a second component");
+    expect(components[(2 * width) + 6] == components[4], "right side is connected");
+  }
+
+  {
+    const int width = 600;
+    const int height = 600;
+    std::vector<Tile> tiles(width * height, Tile::Grass);
+    for (int y = 0; y < height; ++y) {
+      tiles[(y * width) + 300] = Tile::Mountain;
+    }
+    for (int x = 0; x < width; ++x) {
+      if (x != 100) {
+        tiles[(300 * width) + x] = Tile::Mountain;
+      }
+    }
+    const std::vector<int> components = labelWalkableComponents(tiles, width, height);
+    expect(components[0] == components[(599 * width) + 10], "strips merge across the seams");
+    expect(components[0] != components[599], "wall splits the left and right halves");
+    expect(components[(599 * width) + 599] != components[599], "bottom right is its own room");
+  }
+
+  {
+    const int width = 20;
+    const int height = 10;
+    std::vector<Tile> tiles(width * height, Tile::Grass);
+    for (int y = 0; y < height; ++y) {
+      tiles[(y * width) + 8] = Tile::Water;
+      tiles[(y * width) + 9] = Tile::Mountain;
+    }
+    std::vector<Region> regions;
+    regions.emplace_back(RegionType::StartingZone, 0, 0, 5, 5);
+    regions.emplace_back(RegionType::SpawnRegion, 14, 2, 4, 4, 1, 5, 0);
+    Map map(width, height, std::move(tiles), regions, Coordinate(2, 2));
+    expect(!map.isReachable(2, 2, 15, 3), "spawn region starts disconnected");
+    const int carved = map.connectRegions();
+    expect(carved == 2, "carves a two tile corridor through the wall");
+    expect(map.isReachable(2, 2, 15, 3), "spawn region is reachable after carving");
+    expect(map.isReachable(0, 9, 19, 0), "corridor joins both halves");
+    expect(map.connectRegions() == 0, "second pass carves nothing");
+  }
+
+  {
+    Generator generator;
+    std::unique_ptr<Map> map = generator.generate();
+    const Coordinate& start = map->getStartingPosition();
+    for (const Region& region : map->getRegions()) {
+      bool reachable = false;
+      for (int y = region.y; y < region.y + region.height && !reachable; ++y) {
+        for (int x = region.x; x < region.x + region.width && !reachable; ++x) {
+          reachable = map->isReachable(start.x, start.y, x, y);
+        }
+      }
+      expect(reachable, "generated region is reachable from the start");
+    }
+  }
+
+  if (failures > 0) {
+    std::cerr << failures << " test(s) failed.\n";
+    return EXIT_FAILURE;
+  }
+  std::cout << "All map connectivity tests passed.\n";
+  return EXIT_SUCCESS;
+}
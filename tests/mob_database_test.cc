@@ -1,7 +1,9 @@
 #include "mobs/mob_database.h"
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <iostream>
-#include <random>
+#include <vector>
 
 namespace {
 int failures = 0;
@@ -12,13 +14,6 @@ void expect(bool condition, const char* message) {
     failures += 1;
   }
 }
-
-bool sameDropOptions(const EquipmentDropGenerationOptions& a,
-                     const EquipmentDropGenerationOptions& b) {
-  return a.weaponWeight == b.weaponWeight && a.armorWeight == b.armorWeight &&
-         a.commonWeight == b.commonWeight && a.rareWeight == b.rareWeight &&
-         a.epicWeight == b.epicWeight;
-}
 } // namespace
 
 int main() {
@@ -49,7 +44,32 @@ int main() {
   }
 
   {
-    std::mt19937 rng(99);
+    // The stat table holds the same values the per-level formulas give.
+    bool matchesFormula = true;
+    for (const MobArchetype& archetype : database.allArchetypes()) {
+      for (int level = 1; level <= 60; ++level) {
+        const MobResolvedStats& row = database.resolveStats(archetype.type, level);
+        const int offset = level - 1;
+        matchesFormula =
+            matchesFormula && row.level == level &&
+            row.maxHealth ==
+                std::max(1, archetype.baseHealth + (offset * archetype.healthPerLevel)) &&
+            row.experience ==
+                std::max(1, archetype.baseExperience + (offset * archetype.experiencePerLevel)) &&
+            row.attackDamage == std::max(1, archetype.baseAttackDamage +
+                                                (offset * archetype.attackDamagePerLevel));
+      }
+    }
+    expect(matchesFormula, "stat table matches the per-level formulas");
+    expect(&database.resolveStats(MobType::Wolf, 12) == &database.resolveStats(MobType::Wolf, 12),
+           "repeated lookups share one row");
+    expect(&database.resolveStats(MobType::Wolf, 0) == &database.resolveStats(MobType::Wolf, 1),
+           "levels below one clamp to the first row");
+    expect(database.get(MobType::Ogre)->type == MobType::Ogre, "type lookup finds its archetype");
+  }
+
+  {
+    Rng rng(99);
     for (int tier = 0; tier <= 11; ++tier) {
       const int level = std::min(60, 1 + (tier * 5));
       const MobArchetype& archetype = database.randomArchetypeForBand(tier, level, rng);
@@ -61,18 +81,61 @@ int main() {
   }
 
   {
-    std::mt19937 rngA(42);
-    std::mt19937 rngB(42);
+    Rng rngA(42);
+    Rng rngB(42);
     for (int i = 0; i < 60; ++i) {
-      EquipmentDropGenerationOptions optionsA;
-      EquipmentDropGenerationOptions optionsB;
-      const bool dropA = database.rollEquipmentDrop(MobType::GoblinBrute, rngA, optionsA);
-      const bool dropB = database.rollEquipmentDrop(MobType::GoblinBrute, rngB, optionsB);
+      const EquipmentDropTable* dropA = database.rollEquipmentDrop(MobType::GoblinBrute, rngA);
+      const EquipmentDropTable* dropB = database.rollEquipmentDrop(MobType::GoblinBrute, rngB);
       expect(dropA == dropB, "drop roll is deterministic for fixed seed");
-      if (dropA && dropB) {
-        expect(sameDropOptions(optionsA, optionsB), "drop options are deterministic");
+    }
+  }
+
+  {
+    // Band rolls follow spawn weights: compare observed shares with weight / band total.
+    const int tier = 3;
+    const int level = 16;
+    const std::vector<MobArchetype>& all = database.allArchetypes();
+    std::vector<int> expectedWeight(all.size(), 0);
+    int bandTotal = 0;
+    for (std::size_t i = 0; i < all.size(); ++i) {
+      const MobArchetype& archetype = all[i];
+      if (tier >= archetype.minSpawnTier && tier <= archetype.maxSpawnTier &&
+          level >= archetype.minSpawnLevel && level <= archetype.maxSpawnLevel) {
+        expectedWeight[i] = std::max(1, archetype.spawnWeight);
+        bandTotal += expectedWeight[i];
       }
     }
+    expect(bandTotal > 0, "test band has candidates");
+    constexpr int kRolls = 200000;
+    std::vector<int> counts(all.size(), 0);
+    Rng rng(5);
+    for (int i = 0; i < kRolls && bandTotal > 0; ++i) {
+      const MobArchetype& picked = database.randomArchetypeForBand(tier, level, rng);
+      counts[static_cast<std::size_t>(&picked - all.data())] += 1;
+    }
+    bool matchesWeights = true;
+    for (std::size_t i = 0; i < all.size() && bandTotal > 0; ++i) {
+      const double expected = static_cast<double>(expectedWeight[i]) / bandTotal;
+      const double observed = static_cast<double>(counts[i]) / kRolls;
+      matchesWeights = matchesWeights && std::abs(observed - expected) < 0.01;
+    }
+    expect(matchesWeights, "band roll frequencies follow spawn weights");
+  }
+
+  {
+    const MobArchetype* brute = database.get(MobType::GoblinBrute);
+    const MobLootTable& loot = brute->lootTable;
+    const EquipmentDropGenerationOptions& options = loot.equipmentDropOptions;
+    const int dropWeight = options.commonWeight + options.rareWeight + options.epicWeight;
+    const double expected = static_cast<double>(dropWeight) / (dropWeight + loot.noDropWeight);
+    constexpr int kRolls = 200000;
+    int drops = 0;
+    Rng rng(11);
+    for (int i = 0; i < kRolls; ++i) {
+      drops += database.rollEquipmentDrop(MobType::GoblinBrute, rng) != nullptr ? 1 : 0;
+    }
+    expect(std::abs((static_cast<double>(drops) / kRolls) - expected) < 0.01,
+           "drop chance follows the loot table weights");
   }
 
   if (failures > 0) {
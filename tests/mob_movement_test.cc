@@ -0,0 +1,104 @@
+#include "ecs/component/collision_component.h"
+#include "ecs/component/mob_component.h"
+#include "ecs/component/transform_component.h"
+#include "mobs/mob_database.h"
+#include "simulation/game_rules.h"
+#include "simulation/mob_movement.h"
+#include "world/map.h"
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace {
+int failures = 0;
+
+void expect(bool condition, const char* message) {
+  if (!condition) {
+    std::cerr << "FAIL: " << message << "\n";
+    failures += 1;
+  }
+}
+
+constexpr int MAP_SIZE = 12;
+constexpr int WALL_COLUMN = 6;
+constexpr float DT = 1.0f / 60.0f;
+
+// Open grass with a mountain wall down WALL_COLUMN; gapRow leaves one tile open, -1 none.
+Map wallMap(int gapRow) {
+  std::vector<Tile> tiles(static_cast<std::size_t>(MAP_SIZE * MAP_SIZE), Tile::Grass);
+  for (int y = 0; y < MAP_SIZE; ++y) {
+    if (y != gapRow) {
+      tiles[static_cast<std::size_t>((y * MAP_SIZE) + WALL_COLUMN)] = Tile::Mountain;
+    }
+  }
+  return Map(MAP_SIZE, MAP_SIZE, std::move(tiles), {}, Coordinate(0, 0));
+}
+
+// The full-rate AI for a mob with nothing to chase: one step home per tick.
+void walkHomeEveryTick(const Map& map, const MobComponent& mob, TransformComponent& transform,
+                       const CollisionComponent& collision, int ticks) {
+  for (int tick = 0; tick < ticks; ++tick) {
+    if (squaredDistance(centerForEntity(transform, collision), mobHomeCenter(mob, collision)) >
+        MOB_HOME_RADIUS_SQUARED) {
+      moveEntityToward(map, transform, collision, mob.stats->speed, mobHomePosition(mob), DT);
+    }
+  }
+}
+
+bool samePosition(const Position& a, const Position& b) { return a.x == b.x && a.y == b.y; }
+} // namespace
+
+int main() {
+  MobResolvedStats stats;
+  stats.speed = 60.0f;
+  const MobComponent mob(MobType::Goblin, &stats, 9, 2, 0, 0, MAP_SIZE, MAP_SIZE);
+  const CollisionComponent collision(32.0f, 32.0f, false);
+  const Position start(2.0f * TILE_SIZE, 2.0f * TILE_SIZE);
+
+  {
+    // Home lies behind a solid wall: the mob is owed ten seconds, but like the full-rate AI it
+    // can only press against the wall.
+    const Map map = wallMap(-1);
+    TransformComponent settled(start);
+    TransformComponent everyTick(start);
+    settleIdleMob(map, mob, settled, collision, 600 * DT, DT);
+    walkHomeEveryTick(map, mob, everyTick, collision, 600);
+    expect(samePosition(settled.position, everyTick.position),
+           "catch-up ends where the full-rate AI does behind a wall");
+    expect(settled.position.x + collision.width <= WALL_COLUMN * TILE_SIZE,
+           "catch-up does not pass through the wall");
+  }
+
+  {
+    // With the way open the mob reaches home and stays put there.
+    const Map map = wallMap(2);
+    TransformComponent settled(start);
+    TransformComponent everyTick(start);
+    settleIdleMob(map, mob, settled, collision, 600 * DT, DT);
+    walkHomeEveryTick(map, mob, everyTick, collision, 600);
+    expect(samePosition(settled.position, everyTick.position),
+           "catch-up ends where the full-rate AI does on an open path");
+    expect(squaredDistance(centerForEntity(settled, collision), mobHomeCenter(mob, collision)) <=
+               MOB_HOME_RADIUS_SQUARED,
+           "an unobstructed mob gets home");
+  }
+
+  {
+    // Time owed in pieces lands on the same spot as the same time in one go.
+    const Map map = wallMap(2);
+    TransformComponent pieces(start);
+    TransformComponent whole(start);
+    for (int i = 0; i < 30; ++i) {
+      settleIdleMob(map, mob, pieces, collision, 4 * DT, DT);
+    }
+    settleIdleMob(map, mob, whole, collision, 120 * DT, DT);
+    expect(samePosition(pieces.position, whole.position), "owed time can be repaid in pieces");
+  }
+
+  if (failures > 0) {
+    std::cerr << failures << " test(s) failed.\n";
+    return EXIT_FAILURE;
+  }
+  std::cout << "All mob movement tests passed.\n";
+  return EXIT_SUCCESS;
+}
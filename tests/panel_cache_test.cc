@@ -0,0 +1,52 @@
+#include "ui/panel_cache.h"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace {
+int failures = 0;
+
+void expect(bool condition, const char* message) {
+  if (!condition) {
+    std::cerr << "FAIL: " << message << "\n";
+    failures += 1;
+  }
+}
+} // namespace
+
+int main() {
+  expect(PanelKey().add(1).add(2).value() == PanelKey().add(1).add(2).value(),
+         "equal inputs give equal keys");
+  expect(PanelKey().add(1).add(2).value() != PanelKey().add(2).add(1).value(),
+         "keys depend on input order");
+  expect(PanelKey().add(std::string("ab")).add(std::string("c")).value() !=
+             PanelKey().add(std::string("a")).add(std::string("bc")).value(),
+         "adjacent strings cannot trade characters");
+  expect(PanelKey().add(0.5f).value() != PanelKey().add(0.25f).value(),
+         "float inputs change the key");
+
+  // Without a renderer no target texture exists, so every frame falls back to drawing directly;
+  // the version still only advances when the key does.
+  PanelCache cache;
+  const SDL_FRect bounds = {16.0f, 48.0f, 200.0f, 120.0f};
+  expect(cache.begin(nullptr, bounds, 7), "the first frame draws");
+  cache.end(nullptr);
+  const std::uint64_t firstVersion = cache.getVersion();
+  cache.begin(nullptr, bounds, 7);
+  cache.end(nullptr);
+  expect(cache.getVersion() == firstVersion, "an unchanged key keeps the version");
+  cache.begin(nullptr, bounds, 8);
+  cache.end(nullptr);
+  expect(cache.getVersion() == firstVersion + 1, "a changed key advances the version");
+  cache.begin(nullptr, SDL_FRect{16.0f, 48.0f, 220.0f, 120.0f}, 8);
+  cache.end(nullptr);
+  expect(cache.getVersion() == firstVersion + 2, "moved bounds advance the version");
+  expect(cache.getRedrawCount() == 4, "direct drawing repeats every frame");
+
+  if (failures > 0) {
+    std::cerr << failures << " test(s) failed.\n";
+    return EXIT_FAILURE;
+  }
+  std::cout << "All panel cache tests passed.\n";
+  return EXIT_SUCCESS;
+}
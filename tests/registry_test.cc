@@ -0,0 +1,64 @@
+#include "ecs/component/collision_component.h"
+#include "ecs/component/graphic_component.h"
+#include "ecs/component/health_component.h"
+#include "ecs/component/transform_component.h"
+#include "ecs/registry.h"
+#include "ecs/system/graphic_system.h"
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace {
+int failures = 0;
+
+void expect(bool condition, const char* message) {
+  if (!condition) {
+    std::cerr << "FAIL: " << message << "\n";
+    failures += 1;
+  }
+}
+
+std::vector<SpriteSnapshot> visibleSprites(Registry& registry) {
+  std::vector<SpriteSnapshot> sprites;
+  for (auto it = registry.systemsBegin(); it != registry.systemsEnd(); ++it) {
+    if (GraphicSystem* graphicSystem = dynamic_cast<GraphicSystem*>(it->get())) {
+      graphicSystem->collectVisible(0.0f, 0.0f, 640.0f, 480.0f, sprites);
+    }
+  }
+  return sprites;
+}
+} // namespace
+
+int main() {
+  Registry registry;
+  const Position position(100.0f, 100.0f);
+
+  const int drawn = registry.createEntity();
+  registry.registerComponentForEntity<GraphicComponent>(
+      std::make_unique<GraphicComponent>(position, Color{255, 0, 0, 255}), drawn);
+  expect(visibleSprites(registry).empty(), "a partial signature registers nothing");
+  registry.registerComponentForEntity<TransformComponent>(
+      std::make_unique<TransformComponent>(position), drawn);
+  expect(visibleSprites(registry).size() == 1, "the completing component registers the entity");
+
+  // Components outside the signature must not register it again.
+  registry.registerComponentForEntity<CollisionComponent>(
+      std::make_unique<CollisionComponent>(32.0f, 32.0f, false), drawn);
+  registry.registerComponentForEntity<HealthComponent>(std::make_unique<HealthComponent>(10, 10),
+                                                       drawn);
+  expect(visibleSprites(registry).size() == 1, "later components leave the registration alone");
+
+  const int hidden = registry.createEntity();
+  registry.registerComponentForEntity<TransformComponent>(
+      std::make_unique<TransformComponent>(position), hidden);
+  registry.registerComponentForEntity<HealthComponent>(std::make_unique<HealthComponent>(10, 10),
+                                                       hidden);
+  expect(visibleSprites(registry).size() == 1, "entities without a sprite are not drawn");
+
+  if (failures > 0) {
+    std::cerr << failures << " test(s) failed.\n";
+    return EXIT_FAILURE;
+  }
+  std::cout << "All registry tests passed.\n";
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,52 @@
+#include "ui/render_batch.h"
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+int failures = 0;
+
+void expect(bool condition, const char* message) {
+  if (!condition) {
+    std::cerr << "FAIL: " << message << "\n";
+    failures += 1;
+  }
+}
+} // namespace
+
+int main() {
+  // No renderer is needed: flush() only counts the geometry submissions it makes.
+  RenderBatch batch(nullptr);
+
+  for (int i = 0; i < 10; ++i) {
+    batch.fillRect(SDL_FRect{static_cast<float>(i), 0.0f, 32.0f, 32.0f}, SDL_Color{255, 0, 0, 255});
+    batch.outlineRect(SDL_FRect{static_cast<float>(i), 0.0f, 32.0f, 32.0f},
+                      SDL_Color{20, 20, 20, 255});
+  }
+  batch.flush();
+  const int smallDrawCalls = batch.getLastDrawCalls();
+  expect(smallDrawCalls == 1, "untextured quads share a single draw call");
+  expect(batch.getLastQuadCount() == 50, "each entity emits one fill and four outline quads");
+
+  for (int i = 0; i < 5000; ++i) {
+    batch.fillRect(SDL_FRect{static_cast<float>(i), 0.0f, 32.0f, 32.0f}, SDL_Color{255, 0, 0, 255});
+    batch.circle(static_cast<float>(i), 0.0f, 6.0f, SDL_Color{255, 255, 255, 200});
+  }
+  batch.flush();
+  expect(batch.getLastDrawCalls() == smallDrawCalls, "draw calls do not grow with entity count");
+
+  batch.fillRect(SDL_FRect{0.0f, 0.0f, 4.0f, 4.0f}, SDL_Color{0, 0, 0, 255}, SDL_BLENDMODE_NONE);
+  batch.fillRect(SDL_FRect{0.0f, 0.0f, 4.0f, 4.0f}, SDL_Color{0, 0, 0, 160});
+  batch.fillRect(SDL_FRect{8.0f, 0.0f, 4.0f, 4.0f}, SDL_Color{0, 0, 0, 255}, SDL_BLENDMODE_NONE);
+  batch.flush();
+  expect(batch.getLastDrawCalls() == 2, "quads are grouped by blend mode");
+
+  batch.flush();
+  expect(batch.getLastDrawCalls() == 0, "an empty flush submits nothing");
+
+  if (failures > 0) {
+    std::cerr << failures << " test(s) failed.\n";
+    return EXIT_FAILURE;
+  }
+  std::cout << "All render batch tests passed.\n";
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,123 @@
+#include "rng.h"
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+int failures = 0;
+
+void expect(bool condition, const char* message) {
+  if (!condition) {
+    std::cerr << "FAIL: " << message << "\n";
+    failures += 1;
+  }
+}
+} // namespace
+
+int main() {
+  {
+    // Known-answer vectors from the Random123 Philox4x32-10 reference.
+    expect(philox4x32({0, 0, 0, 0}, {0, 0}) ==
+               std::array<std::uint32_t, 4>{0x6627E8D5u, 0xE169C58Du, 0xBC57AC4Cu, 0x9B00DBD8u},
+           "philox matches the zero vector");
+    expect(philox4x32({0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu},
+                      {0xFFFFFFFFu, 0xFFFFFFFFu}) ==
+               std::array<std::uint32_t, 4>{0x408F276Du, 0x41C83B0Eu, 0xA20BC7C6u, 0x6D5451FDu},
+           "philox matches the all-ones vector");
+    expect(philox4x32({0x243F6A88u, 0x85A308D3u, 0x13198A2Eu, 0x03707344u},
+                      {0xA4093822u, 0x299F31D0u}) ==
+               std::array<std::uint32_t, 4>{0xD16CFE09u, 0x94FDCCEBu, 0x5001E420u, 0x24126EA1u},
+           "philox matches the pi vector");
+  }
+
+  {
+    Rng rng = Rng::fromState({1, 2, 3, 4});
+    expect(rng() == 11520u, "xoshiro256** first output");
+    expect(rng() == 0u, "xoshiro256** second output");
+    expect(rng() == 1509978240u, "xoshiro256** third output");
+    expect(rng() == 1215971899390074240u, "xoshiro256** fourth output");
+  }
+
+  {
+    Rng a(42);
+    Rng b(42);
+    Rng c(43);
+    bool same = true;
+    bool differs = false;
+    for (int i = 0; i < 64; ++i) {
+      const std::uint64_t value = a();
+      same = same && value == b();
+      differs = differs || value != c();
+    }
+    expect(same, "equal seeds give equal streams");
+    expect(differs, "different seeds give different streams");
+  }
+
+  {
+    Rng rng(7);
+    bool inRange = true;
+    std::array<int, 5> counts{};
+    float lowest = 1.0f;
+    float highest = 0.0f;
+    for (int i = 0; i < 50000; ++i) {
+      const int value = rng.range(-2, 2);
+      inRange = inRange && value >= -2 && value <= 2;
+      if (value >= -2 && value <= 2) {
+        counts[static_cast<std::size_t>(value + 2)] += 1;
+      }
+      const float unit = rng.nextFloat();
+      inRange = inRange && unit >= 0.0f && unit < 1.0f;
+      lowest = std::min(lowest, unit);
+      highest = std::max(highest, unit);
+      inRange = inRange && rng.index(3) < 3;
+    }
+    expect(inRange, "draws stay inside their ranges");
+    bool bothEnds = true;
+    for (int count : counts) {
+      bothEnds = bothEnds && count > 9000 && count < 11000;
+    }
+    expect(bothEnds, "integer range is uniform and includes both ends");
+    expect(lowest < 0.001f && highest > 0.999f, "floats cover the unit interval");
+    expect(unitFloat(0xFFFFFFFFu) < 1.0f, "largest float stays below one");
+  }
+
+  {
+    // Counter streams depend only on their key, not on who drew what before.
+    CounterRng first(99, RngPurpose::Combat, 5, 1000);
+    const std::uint32_t a0 = first.nextU32();
+    const std::uint32_t a1 = first.nextU32();
+    CounterRng other(99, RngPurpose::Combat, 6, 1000);
+    for (int i = 0; i < 10; ++i) {
+      other.nextU32();
+    }
+    CounterRng again(99, RngPurpose::Combat, 5, 1000);
+    expect(again.nextU32() == a0 && again.nextU32() == a1, "same key replays the same numbers");
+
+    CounterRng loot(99, RngPurpose::Loot, 5, 1000);
+    CounterRng later(99, RngPurpose::Combat, 5, 1001);
+    CounterRng reseeded(100, RngPurpose::Combat, 5, 1000);
+    expect(loot.nextU32() != a0, "purpose separates streams");
+    expect(later.nextU32() != a0, "tick separates streams");
+    expect(reseeded.nextU32() != a0, "seed separates streams");
+
+    CounterRng longStream(1, RngPurpose::Spawn, 0, 0);
+    const std::array<std::uint32_t, 4> block = philox4x32({0, 0, 0, 2}, {1, 0});
+    const std::array<std::uint32_t, 4> nextBlock = philox4x32({1, 0, 0, 2}, {1, 0});
+    bool matchesBlocks = true;
+    for (std::uint32_t expected : block) {
+      matchesBlocks = matchesBlocks && longStream.nextU32() == expected;
+    }
+    for (std::uint32_t expected : nextBlock) {
+      matchesBlocks = matchesBlocks && longStream.nextU32() == expected;
+    }
+    expect(matchesBlocks, "counter stream walks consecutive philox blocks");
+  }
+
+  if (failures > 0) {
+    std::cerr << failures << " test(s) failed.\n";
+    return EXIT_FAILURE;
+  }
+  std::cout << "All rng tests passed.\n";
+  return EXIT_SUCCESS;
+}
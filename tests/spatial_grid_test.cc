@@ -0,0 +1,73 @@
+#include "ecs/spatial_grid.h"
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace {
+int failures = 0;
+
+void expect(bool condition, const char* message) {
+  if (!condition) {
+    std::cerr << "FAIL: " << message << "\n";
+    failures += 1;
+  }
+}
+
+std::vector<int> query(const SpatialGrid& grid, float x, float y, float width, float height) {
+  std::vector<int> out;
+  grid.query(x, y, width, height, out);
+  return out;
+}
+} // namespace
+
+int main() {
+  SpatialGrid grid(100.0f);
+  grid.update(3, 10.0f, 10.0f);
+  grid.update(1, 50.0f, 50.0f);
+  grid.update(2, 150.0f, 20.0f);
+  grid.update(4, -1000.0f, -1000.0f);
+  expect(grid.size() == 4, "every update of a new id inserts it");
+  expect(query(grid, 0.0f, 0.0f, 200.0f, 100.0f) == std::vector<int>{1, 2, 3},
+         "query returns ids in id order across cells");
+  expect(query(grid, 0.0f, 0.0f, 40.0f, 40.0f) == std::vector<int>{3},
+         "points in a touched cell but outside the rect are skipped");
+
+  grid.update(3, 60.0f, 60.0f);
+  expect(query(grid, 0.0f, 0.0f, 40.0f, 40.0f).empty(), "a move within a cell updates the point");
+  grid.update(1, 250.0f, 250.0f);
+  expect(query(grid, 0.0f, 0.0f, 100.0f, 100.0f) == std::vector<int>{3},
+         "a move to another cell leaves the old one");
+  expect(query(grid, 200.0f, 200.0f, 100.0f, 100.0f) == std::vector<int>{1},
+         "and is found in the new one");
+  expect(grid.size() == 4, "moving never duplicates an id");
+
+  grid.remove(3);
+  grid.remove(3);
+  expect(query(grid, 0.0f, 0.0f, 100.0f, 100.0f).empty(), "removed ids are gone");
+  expect(grid.size() == 3, "removing twice is harmless");
+  expect(query(grid, -1100.0f, -1100.0f, 200.0f, 200.0f) == std::vector<int>{4},
+         "negative coordinates have their own cells");
+
+  expect(query(grid, -1e6f, -1e6f, 2e6f, 2e6f) == std::vector<int>{1, 2, 4},
+         "a rect wider than the grid still finds everything");
+
+  {
+    // Swap-removal must keep the moved entry findable.
+    SpatialGrid cell(100.0f);
+    for (int id = 0; id < 5; ++id) {
+      cell.update(id, 10.0f + static_cast<float>(id), 10.0f);
+    }
+    cell.remove(1);
+    cell.update(0, 500.0f, 500.0f);
+    cell.update(4, 12.0f, 12.0f);
+    expect(query(cell, 0.0f, 0.0f, 100.0f, 100.0f) == std::vector<int>{2, 3, 4},
+           "ids swapped into freed slots still move in place");
+  }
+
+  if (failures > 0) {
+    std::cerr << failures << " test(s) failed.\n";
+    return EXIT_FAILURE;
+  }
+  std::cout << "All spatial grid tests passed.\n";
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,148 @@
+#include "simulation/status_effects.h"
+#include "skills/status_effect_database.h"
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+int failures = 0;
+
+void expect(bool condition, const char* message) {
+  if (!condition) {
+    std::cerr << "FAIL: " << message << "\n";
+    failures += 1;
+  }
+}
+
+StatusEffectDef makeEffect(int id, StatusEffectType type, float duration, float tickInterval,
+                           float magnitude) {
+  StatusEffectDef def;
+  def.id = id;
+  def.name = "Test";
+  def.type = type;
+  def.duration = duration;
+  def.tickInterval = tickInterval;
+  def.magnitude = magnitude;
+  return def;
+}
+
+int totalFor(const StatusEffects& effects, int entityId) {
+  int total = 0;
+  for (const StatusHealthChange& change : effects.getHealthChanges()) {
+    if (change.entityId == entityId) {
+      total += change.amount;
+    }
+  }
+  return total;
+}
+} // namespace
+
+int main() {
+  const float tickSeconds = 0.1f;
+  const StatusEffectDef bleed =
+      makeEffect(1, StatusEffectType::DamageOverTime, 1.0f, 0.5f, 0.5f);
+  const StatusEffectDef mend = makeEffect(2, StatusEffectType::HealOverTime, 0.4f, 0.2f, 1.0f);
+  const StatusEffectDef chill = makeEffect(3, StatusEffectType::Slow, 0.3f, 0.0f, 0.4f);
+  const StatusEffectDef frost = makeEffect(4, StatusEffectType::Slow, 0.3f, 0.0f, 0.6f);
+  const StatusEffectDef stun = makeEffect(5, StatusEffectType::Stun, 0.2f, 0.0f, 0.0f);
+  const StatusEffectDef weakness = makeEffect(6, StatusEffectType::StatModifier, 0.3f, 0.0f, -0.3f);
+
+  {
+    StatusEffects effects;
+    effects.apply(7, bleed, 10.0f, tickSeconds);
+    int pulses = 0;
+    int damage = 0;
+    for (int tick = 0; tick < 20; ++tick) {
+      effects.update();
+      pulses += static_cast<int>(effects.getHealthChanges().size());
+      damage += totalFor(effects, 7);
+    }
+    expect(pulses == 2, "a 1s DoT pulsing every 0.5s pulses twice");
+    expect(damage == -10, "each pulse deals magnitude times power");
+    expect(effects.activeCount() == 0, "the DoT expires");
+  }
+
+  {
+    StatusEffects effects;
+    effects.apply(3, bleed, 10.0f, tickSeconds);
+    for (int tick = 0; tick < 8; ++tick) {
+      effects.update();
+    }
+    effects.apply(3, bleed, 20.0f, tickSeconds);
+    expect(effects.activeCount() == 1, "reapplying refreshes instead of stacking");
+    int damage = 0;
+    for (int tick = 0; tick < 20; ++tick) {
+      effects.update();
+      damage += totalFor(effects, 3);
+    }
+    expect(damage == -20, "the refresh keeps the pulse rhythm at the new power");
+  }
+
+  {
+    StatusEffects effects;
+    effects.apply(2, mend, 5.0f, tickSeconds);
+    effects.update();
+    effects.update();
+    expect(totalFor(effects, 2) == 5, "heals come out positive");
+  }
+
+  {
+    StatusEffects effects;
+    effects.apply(4, chill, 0.0f, tickSeconds);
+    effects.apply(4, frost, 0.0f, tickSeconds);
+    effects.apply(4, stun, 0.0f, tickSeconds);
+    effects.apply(4, weakness, 0.0f, tickSeconds);
+    effects.update();
+    expect(effects.speedMultiplier(4) > 0.39f && effects.speedMultiplier(4) < 0.41f,
+           "the strongest slow wins");
+    expect(effects.isStunned(4), "stun applies");
+    expect(effects.affectsMovement(4) && !effects.affectsMovement(5),
+           "only the stunned and slowed entity moves differently");
+    expect(effects.damageMultiplier(4) > 0.69f && effects.damageMultiplier(4) < 0.71f,
+           "stat modifier scales damage dealt");
+    expect(effects.speedMultiplier(5) == 1.0f && !effects.isStunned(5),
+           "other entities are untouched");
+    effects.update();
+    expect(!effects.isStunned(4), "stun wears off on time");
+    effects.update();
+    expect(effects.speedMultiplier(4) == 1.0f && effects.damageMultiplier(4) == 1.0f,
+           "modifiers reset after expiry");
+    expect(!effects.affectsMovement(4), "movement is back to normal after expiry");
+    expect(effects.activeCount() == 0, "all modifiers expire");
+  }
+
+  {
+    StatusEffects effects;
+    for (int entityId = 0; entityId < 500; ++entityId) {
+      effects.apply(entityId, bleed, 10.0f, tickSeconds);
+      effects.apply(entityId, chill, 0.0f, tickSeconds);
+    }
+    expect(effects.activeCount() == 1000, "an AoE can cover 500 mobs");
+    effects.clear({10, 20, 499});
+    expect(effects.activeCount() == 994, "clear drops every effect on the listed entities");
+    for (int tick = 0; tick < 5; ++tick) {
+      effects.update();
+    }
+    expect(effects.getHealthChanges().size() == 497, "the survivors pulse together");
+    expect(totalFor(effects, 20) == 0 && totalFor(effects, 21) == -5,
+           "cleared entities take no damage");
+    effects.apply(21, bleed, 30.0f, tickSeconds);
+    for (int tick = 0; tick < 5; ++tick) {
+      effects.update();
+    }
+    expect(totalFor(effects, 21) == -15, "refresh still finds an entity after swaps");
+  }
+
+  {
+    const StatusEffectDatabase database;
+    const StatusEffectDef* effect = database.getEffect(1);
+    expect(effect && effect->type == StatusEffectType::DamageOverTime, "bleed is a DoT");
+    expect(database.getEffect(999) == nullptr, "unknown effects are null");
+  }
+
+  if (failures > 0) {
+    std::cerr << failures << " test(s) failed.\n";
+    return EXIT_FAILURE;
+  }
+  std::cout << "All status effect tests passed.\n";
+  return EXIT_SUCCESS;
+}
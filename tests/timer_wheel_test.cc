@@ -0,0 +1,118 @@
+#include "ecs/timer_wheel.h"
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+int failures = 0;
+
+void expect(bool condition, const char* message) {
+  if (!condition) {
+    std::cerr << "FAIL: " << message << "\n";
+    failures += 1;
+  }
+}
+
+struct Fired {
+  int id = 0;
+  std::uint64_t dueTick = 0;
+};
+} // namespace
+
+int main() {
+  {
+    TimerWheel<int> wheel;
+    std::vector<int> fired;
+    wheel.schedule(3, 1);
+    wheel.schedule(3, 2);
+    wheel.schedule(1, 3);
+    wheel.advance(2, fired);
+    expect(fired == std::vector<int>{3}, "only the timer due by tick 2 fires");
+    fired.clear();
+    wheel.advance(3, fired);
+    expect(fired == std::vector<int>{1, 2}, "same-tick timers fire in schedule order");
+    expect(wheel.pending() == 0, "nothing left pending");
+    fired.clear();
+    wheel.schedule(0, 4);
+    wheel.advance(4, fired);
+    expect(fired == std::vector<int>{4}, "a timer scheduled in the past fires next tick");
+  }
+
+  {
+    TimerWheel<int> wheel;
+    std::vector<int> fired;
+    const TimerId cancelled = wheel.schedule(5000, 1);
+    const TimerId kept = wheel.schedule(5000, 2);
+    expect(wheel.cancel(cancelled), "pending timer cancels");
+    expect(!wheel.cancel(cancelled), "cancelling twice fails");
+    expect(wheel.isPending(kept), "the other timer is still pending");
+    wheel.advance(4999, fired);
+    expect(fired.empty(), "nothing fires early");
+    wheel.advance(5000, fired);
+    expect(fired == std::vector<int>{2}, "cancelled timer never fires");
+    expect(!wheel.isPending(kept), "fired timer is no longer pending");
+    expect(!wheel.cancel(kept), "fired timer cannot be cancelled");
+  }
+
+  {
+    // Every level, the overflow list and a start offset that is not aligned to any level.
+    const std::uint64_t start = 1000003;
+    TimerWheel<Fired> wheel(start);
+    std::mt19937 rng(17);
+    std::vector<std::uint64_t> dueTicks = {start + 1,       start + 63,       start + 64,
+                                           start + 4095,    start + 4096,     start + 262143,
+                                           start + 262144,  start + 16777215, start + 16777216,
+                                           start + 40000000};
+    std::uniform_int_distribution<std::uint64_t> offset(1, 300000);
+    for (int i = 0; i < 2000; ++i) {
+      dueTicks.push_back(start + offset(rng));
+    }
+    std::vector<TimerId> ids;
+    for (std::size_t i = 0; i < dueTicks.size(); ++i) {
+      ids.push_back(wheel.schedule(dueTicks[i], Fired{static_cast<int>(i), dueTicks[i]}));
+    }
+    std::size_t cancelledCount = 0;
+    for (std::size_t i = 10; i < ids.size(); i += 7) {
+      wheel.cancel(ids[i]);
+      cancelledCount += 1;
+    }
+
+    std::vector<Fired> fired;
+    std::vector<Fired> step;
+    bool onTime = true;
+    for (std::uint64_t tick = start + 1; tick <= start + 300000; ++tick) {
+      step.clear();
+      wheel.advance(tick, step);
+      for (const Fired& entry : step) {
+        onTime = onTime && entry.dueTick == tick;
+        fired.push_back(entry);
+      }
+    }
+    step.clear();
+    wheel.advance(start + 40000000, step);
+    for (const Fired& entry : step) {
+      fired.push_back(entry);
+    }
+    expect(onTime, "every timer fires on its due tick");
+    expect(fired.size() == dueTicks.size() - cancelledCount, "every live timer fires once");
+    expect(wheel.pending() == 0, "the wheel drains");
+    bool cancelledSkipped = true;
+    for (const Fired& entry : fired) {
+      cancelledSkipped = cancelledSkipped && (entry.id < 10 || (entry.id - 10) % 7 != 0);
+    }
+    expect(cancelledSkipped, "cancelled timers are skipped");
+    expect(!step.empty() && step.back().dueTick == start + 40000000,
+           "timers beyond the wheel span fire on time");
+  }
+
+  expect(ticksForSeconds(1.2f, 1.0f / 60.0f) == 72, "1.2s is 72 ticks at 60Hz");
+  expect(ticksForSeconds(0.0f, 1.0f / 60.0f) == 1, "zero seconds still waits a tick");
+
+  if (failures > 0) {
+    std::cerr << failures << " test(s) failed.\n";
+    return EXIT_FAILURE;
+  }
+  std::cout << "All timer wheel tests passed.\n";
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,74 @@
+#include "triple_buffer.h"
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+namespace {
+int failures = 0;
+
+void expect(bool condition, const char* message) {
+  if (!condition) {
+    std::cerr << "FAIL: " << message << "\n";
+    failures += 1;
+  }
+}
+
+struct Frame {
+  long first = 0;
+  long second = 0;
+};
+} // namespace
+
+int main() {
+  {
+    TripleBuffer<Frame> buffer;
+    expect(!buffer.acquire(), "nothing to acquire before the first publish");
+    buffer.back() = Frame{1, 1};
+    buffer.publish();
+    buffer.back() = Frame{2, 2};
+    buffer.publish();
+    expect(buffer.acquire(), "acquire picks up a publish");
+    expect(buffer.front().first == 2, "acquire returns the latest publish");
+    expect(!buffer.acquire(), "nothing new after acquiring the latest");
+    expect(buffer.front().first == 2, "front is stable without a new publish");
+  }
+
+  {
+    constexpr long FRAME_COUNT = 200000;
+    TripleBuffer<Frame> buffer;
+    std::atomic<bool> done = false;
+    std::thread writer([&]() {
+      for (long i = 1; i <= FRAME_COUNT; ++i) {
+        Frame& frame = buffer.back();
+        frame.first = i;
+        frame.second = i;
+        buffer.publish();
+      }
+      done = true;
+    });
+    long last = 0;
+    bool torn = false;
+    bool backwards = false;
+    while (!done) {
+      if (buffer.acquire()) {
+        const Frame& frame = buffer.front();
+        torn = torn || frame.first != frame.second;
+        backwards = backwards || frame.first < last;
+        last = frame.first;
+      }
+    }
+    writer.join();
+    buffer.acquire();
+    expect(!torn, "reader never sees a partially written frame");
+    expect(!backwards, "reader never goes back to an older frame");
+    expect(buffer.front().first == FRAME_COUNT, "final publish is visible to the reader");
+  }
+
+  if (failures > 0) {
+    std::cerr << failures << " test(s) failed.\n";
+    return EXIT_FAILURE;
+  }
+  std::cout << "All triple buffer tests passed.\n";
+  return EXIT_SUCCESS;
+}